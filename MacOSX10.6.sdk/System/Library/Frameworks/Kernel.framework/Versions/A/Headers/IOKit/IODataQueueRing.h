@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2009 Apple Inc. All rights reserved.
+ *
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_START@
+ * 
+ * This file contains Original Code and/or Modifications of Original Code
+ * as defined in and that are subject to the Apple Public Source License
+ * Version 2.0 (the 'License'). You may not use this file except in
+ * compliance with the License. The rights granted to you under the License
+ * may not be used to create, or enable the creation or redistribution of,
+ * unlawful or unlicensed copies of an Apple operating system, or to
+ * circumvent, violate, or enable the circumvention or violation of, any
+ * terms of an Apple operating system software license agreement.
+ * 
+ * Please obtain a copy of the License at
+ * http://www.opensource.apple.com/apsl/ and read it before using this file.
+ * 
+ * The Original Code and all software distributed under the License are
+ * distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, AND APPLE HEREBY DISCLAIMS ALL SUCH WARRANTIES,
+ * INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR NON-INFRINGEMENT.
+ * Please see the License for the specific language governing rights and
+ * limitations under the License.
+ * 
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_END@
+ */
+
+#ifndef _IOKIT_IODATAQUEUERING_H
+#define _IOKIT_IODATAQUEUERING_H
+
+#include <IOKit/IODataQueueShared.h>
+
+/*!
+ * @header IODataQueueRing
+ * @abstract Multiple producer reserve / commit and batch dequeue on an IODataQueueMemory region.
+ * @discussion These functions let a driver that owns an IODataQueueMemory region, typically the one returned by IOSharedDataQueue::getMemoryDescriptor(), add entries from several threads without a lock and drain entries in batches.  They work on the unchanged IODataQueueMemory layout, so a single consumer using the existing IODataQueueClient code sees an ordinary data queue.  IOSharedDataQueue itself does not use them, so they must not be mixed with its enqueue() and dequeue() on the same queue.
+ *
+ * <br>Producers claim space by advancing a private reserve tail with a compare and swap, fill their entry in place and then commit it.  Commits publish the shared tail in reservation order, a commit waits for the reservations made before it to be committed first.  A producer must therefore not block between reserve and commit.
+ *
+ * <br>The queue memory is mapped into the client task, which can rewrite its header and entries at any time.  The functions therefore take the size of the queue region from the caller instead of from the queueSize field, keep the producers' positions in an IODataQueueRingState private to the driver, and check every head, tail and entry size read from the shared memory against that size before using it.
+ *
+ * <br>The functions have no kernel dependencies so that the ring can be exercised as a userspace data structure.
+ */
+
+/*!
+ * @typedef IODataQueueRingState
+ * @abstract Producer state of a ring, kept in driver memory that is not mapped into the client.
+ * @field queueSize The size of the queue region as allocated by the driver.
+ * @field reserveTail The end of the last reservation.
+ * @field commitTail The end of the last committed reservation.
+ */
+typedef struct _IODataQueueRingState {
+    UInt32              queueSize;
+    volatile UInt32     reserveTail;
+    volatile UInt32     commitTail;
+} IODataQueueRingState;
+
+/*!
+ * @typedef IODataQueueReservation
+ * @abstract Space claimed in the queue by IODataQueueRingReserve().
+ * @field entry The entry to fill in, its size field is already set.
+ * @field start The queue tail the reservation follows.
+ * @field end The queue tail once the reservation is committed.
+ */
+typedef struct _IODataQueueReservation {
+    IODataQueueEntry *  entry;
+    UInt32              start;
+    UInt32              end;
+} IODataQueueReservation;
+
+/*!
+ * @function IODataQueueRingInit
+ * @abstract Sets up the producer state for an empty queue whose head and tail are 0.
+ * @param ring The state to initialize.
+ * @param queueSize The size of the queue region, as passed to IOSharedDataQueue::withCapacity() or computed when the region was allocated.  Never the queueSize field of the shared memory.
+ */
+static inline void
+IODataQueueRingInit(IODataQueueRingState *ring, UInt32 queueSize)
+{
+    ring->queueSize = queueSize;
+    ring->reserveTail = 0;
+    ring->commitTail = 0;
+}
+
+/*!
+ * @function IODataQueueRingUsed
+ * @abstract Returns the number of queue bytes between head and tail, the gap left at the end of the region by a wrapped entry included.
+ * @discussion head and tail must not exceed queueSize.
+ */
+static inline UInt32
+IODataQueueRingUsed(UInt32 queueSize, UInt32 head, UInt32 tail)
+{
+    return (tail >= head) ? (tail - head) : (queueSize - head + tail);
+}
+
+/*!
+ * @function IODataQueueRingReserve
+ * @abstract Claims room for an entry of dataSize bytes.
+ * @discussion Placement follows IODataQueue::enqueue(): an entry that does not fit before the end of the region wraps to its start, and the queue is never filled completely so that head == tail always means empty.
+ * @param dataQueue The queue memory.
+ * @param ring The producer state.
+ * @param dataSize Size of the entry data.
+ * @param reservation Filled in on success.
+ * @result Returns true on success, false if the queue is full or its head is out of range.
+ */
+static inline Boolean
+IODataQueueRingReserve(IODataQueueMemory *dataQueue, IODataQueueRingState *ring,
+                       UInt32 dataSize, IODataQueueReservation *reservation)
+{
+    const UInt32 queueSize = ring->queueSize;
+    const UInt32 entrySize = dataSize + DATA_QUEUE_ENTRY_HEADER_SIZE;
+    UInt32       head;
+    UInt32       tail;
+    UInt32       offset;
+    UInt32       newTail;
+
+    if (entrySize < dataSize || entrySize >= queueSize)
+        return 0;
+
+    do {
+        tail = ring->reserveTail;
+        __sync_synchronize();
+        head = dataQueue->head;
+        if (head > queueSize)
+            return 0;
+
+        if (tail >= head) {
+            if (entrySize <= queueSize - tail) {
+                offset = tail;
+            } else if (head > entrySize) {
+                offset = 0;
+            } else {
+                return 0;
+            }
+        } else if (head - tail > entrySize) {
+            offset = tail;
+        } else {
+            return 0;
+        }
+        newTail = offset + entrySize;
+    } while (!__sync_bool_compare_and_swap(&ring->reserveTail, tail, newTail));
+
+    if (offset == 0 && tail != 0) {
+        // Tell the consumer to wrap: a size that runs past the end of
+        // the region, written where the next entry would have started.
+        if (queueSize - tail >= DATA_QUEUE_ENTRY_HEADER_SIZE)
+            ((IODataQueueEntry *)((UInt8 *)dataQueue->queue + tail))->size = dataSize;
+    }
+
+    reservation->entry = (IODataQueueEntry *)((UInt8 *)dataQueue->queue + offset);
+    reservation->entry->size = dataSize;
+    reservation->start = tail;
+    reservation->end = newTail;
+    return 1;
+}
+
+/*!
+ * @function IODataQueueRingCommit
+ * @abstract Publishes a filled in reservation to the consumer.
+ * @param dataQueue The queue memory.
+ * @param ring The producer state.
+ * @param reservation A reservation from IODataQueueRingReserve().
+ * @param watermark Notification threshold in bytes, at least 1.
+ * @result Returns true if the commit raised the queued byte count from below watermark to at least watermark, in which case the consumer should be notified.  A watermark of 1 notifies on the empty to non empty transition, as IODataQueue::enqueue() does.
+ */
+static inline Boolean
+IODataQueueRingCommit(IODataQueueMemory *dataQueue, IODataQueueRingState *ring,
+                      const IODataQueueReservation *reservation, UInt32 watermark)
+{
+    UInt32 head;
+
+    while (ring->commitTail != reservation->start)
+        ;    // earlier reservation still being filled in
+
+    __sync_synchronize();
+    dataQueue->tail = reservation->end;
+    __sync_synchronize();
+    ring->commitTail = reservation->end;
+
+    head = dataQueue->head;
+    if (head > ring->queueSize)
+        return 0;
+    return IODataQueueRingUsed(ring->queueSize, head, reservation->start) < watermark
+        && IODataQueueRingUsed(ring->queueSize, head, reservation->end) >= watermark;
+}
+
+/*!
+ * @function IODataQueueRingDequeueBatch
+ * @abstract Dequeues as many entries as fit in a buffer with a single update of the queue head.
+ * @discussion The entries are copied to data back to back as IODataQueueEntry records, each a UInt32 size followed by size bytes.  Only the single consumer of the queue may call this function.  Every size is read from the queue once and checked against queueSize and the tail before anything is copied, so a producer that rewrites the queue memory can not make the copy leave the region.
+ * @param dataQueue The queue memory.
+ * @param queueSize The size of the queue region as allocated by the driver.
+ * @param data The buffer to copy entries to.
+ * @param dataSize On entry the size of data, on return the number of bytes copied.
+ * @param maxEntries The maximum number of entries to dequeue.
+ * @result Returns the number of entries dequeued, 0 if the queue is empty, the first entry does not fit or the queue is corrupt.
+ */
+static inline UInt32
+IODataQueueRingDequeueBatch(IODataQueueMemory *dataQueue, UInt32 queueSize,
+                            void *data, UInt32 *dataSize, UInt32 maxEntries)
+{
+    UInt8 *      dst = (UInt8 *)data;
+    const UInt32 capacity = *dataSize;
+    UInt32       copied = 0;
+    UInt32       entries = 0;
+    UInt32       head = dataQueue->head;
+    UInt32       tail = dataQueue->tail;
+
+    __sync_synchronize();
+
+    if (head > queueSize || tail > queueSize) {
+        *dataSize = 0;
+        return 0;
+    }
+
+    while (head != tail && entries < maxEntries) {
+        const UInt8 * src;
+        UInt32        size;
+        UInt32        limit;
+        UInt32        entrySize;
+        UInt32        i;
+
+        src = (const UInt8 *)dataQueue->queue + head;
+        if (queueSize - head < DATA_QUEUE_ENTRY_HEADER_SIZE
+         || (size = ((volatile IODataQueueEntry *)src)->size)
+                > queueSize - head - DATA_QUEUE_ENTRY_HEADER_SIZE) {
+            // Only a tail that wrapped can leave a gap at the end.
+            if (tail > head)
+                break;
+            head = 0;
+            if (head == tail)
+                break;
+            src = (const UInt8 *)dataQueue->queue;
+            size = ((volatile IODataQueueEntry *)src)->size;
+        }
+
+        limit = (head < tail) ? tail : queueSize;
+        if (limit - head < DATA_QUEUE_ENTRY_HEADER_SIZE
+         || size > limit - head - DATA_QUEUE_ENTRY_HEADER_SIZE)
+            break;
+        entrySize = size + DATA_QUEUE_ENTRY_HEADER_SIZE;
+        if (entrySize > capacity - copied)
+            break;
+
+        for (i = 0; i < DATA_QUEUE_ENTRY_HEADER_SIZE; i++)
+            dst[copied + i] = ((const UInt8 *)&size)[i];
+        for (; i < entrySize; i++)
+            dst[copied + i] = src[i];
+        copied += entrySize;
+        head += entrySize;
+        entries++;
+    }
+
+    if (entries) {
+        __sync_synchronize();
+        dataQueue->head = head;
+    }
+    *dataSize = copied;
+    return entries;
+}
+
+#endif /* _IOKIT_IODATAQUEUERING_H */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2009 Apple Inc. All rights reserved.
+ *
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_START@
+ * 
+ * This file contains Original Code and/or Modifications of Original Code
+ * as defined in and that are subject to the Apple Public Source License
+ * Version 2.0 (the 'License'). You may not use this file except in
+ * compliance with the License. The rights granted to you under the License
+ * may not be used to create, or enable the creation or redistribution of,
+ * unlawful or unlicensed copies of an Apple operating system, or to
+ * circumvent, violate, or enable the circumvention or violation of, any
+ * terms of an Apple operating system software license agreement.
+ * 
+ * Please obtain a copy of the License at
+ * http://www.opensource.apple.com/apsl/ and read it before using this file.
+ * 
+ * The Original Code and all software distributed under the License are
+ * distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, AND APPLE HEREBY DISCLAIMS ALL SUCH WARRANTIES,
+ * INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR NON-INFRINGEMENT.
+ * Please see the License for the specific language governing rights and
+ * limitations under the License.
+ * 
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_END@
+ */
+
+#ifndef _OS_OSCOLLECTIONINDEX_H
+#define _OS_OSCOLLECTIONINDEX_H
+
+/*!
+    @header OSCollectionIndex
+    @abstract Pointer keyed hash index for collections with OSDictionary or OSSet semantics.
+    @discussion
+    A collection keeps its entries in its own ordered array and may, once it holds at least kOSCollectionIndexThreshold entries, map each key pointer to the position of its entry with an OSCollectionIndex.  OSDictionary and OSSet do not use it themselves; it is meant for drivers and user clients that keep their own tables of OSSymbol keyed or identity keyed objects.  Keys are compared by address only, which is exact for OSDictionary because its keys are interned OSSymbols and for OSSet because membership is by object identity.  The index never owns or reorders entries, so iteration order and the OSCollectionIterator contract are unaffected.
+    
+    The index performs no allocation and has no kernel dependencies.  The owner allocates OSCollectionIndexSlots(count) slots, zero fills them and passes them to init(), which allows the index to be exercised from a userspace build of the container classes.
+*/
+
+/*!
+    @enum OSCollectionIndex constants
+    @constant kOSCollectionIndexThreshold Entry count at which a collection should build its index.  Below it a linear scan of the entry array is at least as fast.
+    @constant kOSCollectionIndexNotFound Returned by OSCollectionIndex::find() when the key is not indexed.
+*/
+enum {
+    kOSCollectionIndexThreshold = 16,
+    kOSCollectionIndexNotFound  = ~0U
+};
+
+/*!
+    @struct OSCollectionIndexSlot
+    @abstract One open addressed slot of an OSCollectionIndex.  A slot with a null key is empty.
+*/
+struct OSCollectionIndexSlot {
+    const void   *key;
+    unsigned int  entry;
+};
+
+/*!
+    @function OSCollectionIndexSlots
+    @abstract Returns the number of slots an index must have to hold count keys.
+    @discussion The result is a power of two that keeps the load factor at or below one half.
+*/
+static inline unsigned int
+OSCollectionIndexSlots(unsigned int count)
+{
+    unsigned int slots = kOSCollectionIndexThreshold;
+
+    while (slots < 2 * count)
+        slots <<= 1;
+    return slots;
+}
+
+/*!
+    @struct OSCollectionIndex
+    @abstract Open addressed map from key pointers to entry positions.
+*/
+struct OSCollectionIndex {
+    OSCollectionIndexSlot *slots;
+    unsigned int           mask;
+    unsigned int           shift;
+    unsigned int           count;
+
+    /*!
+        @function home
+        @abstract Returns the slot at which the probe for key starts.
+        @discussion Fibonacci hashing: the key is multiplied by the 32 bit golden ratio and the top bits of the product are used, since its low bits depend only on the low bits of the key.
+    */
+    unsigned int home(const void *key) const
+    {
+	unsigned long bits = (unsigned long) key;
+
+	// Fold the upper half of 64 bit pointers down, split in two shifts
+	// so that it is a no-op rather than undefined for 32 bit longs.
+	bits ^= (bits >> 16) >> 16;
+	return ((unsigned int) (bits >> 4) * 0x9E3779B9U) >> shift;
+    }
+
+    /*!
+        @function init
+        @abstract Attaches zero filled storage for numSlots slots, a power of two from OSCollectionIndexSlots().
+    */
+    void init(OSCollectionIndexSlot *storage, unsigned int numSlots)
+    {
+	slots = storage;
+	mask = numSlots - 1;
+	shift = 32;
+	while (numSlots > 1) {
+	    numSlots >>= 1;
+	    shift--;
+	}
+	count = 0;
+    }
+
+    /*!
+        @function needsGrow
+        @abstract Returns true if adding one more key would exceed the maximum load factor, the owner should then rebuild into OSCollectionIndexSlots(count + 1) slots.
+    */
+    bool needsGrow() const
+    {
+	return 2 * (count + 1) > mask + 1;
+    }
+
+    /*!
+        @function find
+        @abstract Returns the entry position of key or kOSCollectionIndexNotFound.
+    */
+    unsigned int find(const void *key) const
+    {
+	for (unsigned int i = home(key); slots[i].key; i = (i + 1) & mask) {
+	    if (slots[i].key == key)
+		return slots[i].entry;
+	}
+	return kOSCollectionIndexNotFound;
+    }
+
+    /*!
+        @function insert
+        @abstract Records that key, which must not already be indexed, is at position entry.
+    */
+    void insert(const void *key, unsigned int entry)
+    {
+	unsigned int i = home(key);
+
+	while (slots[i].key)
+	    i = (i + 1) & mask;
+	slots[i].key = key;
+	slots[i].entry = entry;
+	count++;
+    }
+
+    /*!
+        @function remove
+        @abstract Removes key, which was at position entry, and renumbers the entries after it.
+        @discussion The owner is expected to close the gap in its entry array so that iteration order is preserved, so every later position moves down by one.  The cluster following the removed slot is shifted back, no tombstones are left.
+    */
+    void remove(const void *key, unsigned int entry)
+    {
+	unsigned int i = home(key);
+
+	while (slots[i].key != key) {
+	    if (!slots[i].key)
+		return;
+	    i = (i + 1) & mask;
+	}
+
+	for (unsigned int j = (i + 1) & mask; slots[j].key; j = (j + 1) & mask) {
+	    unsigned int start = home(slots[j].key);
+
+	    // Move j back into the hole at i unless its home lies
+	    // cyclically in (i, j].
+	    if (((j - start) & mask) >= ((j - i) & mask)) {
+		slots[i] = slots[j];
+		i = j;
+	    }
+	}
+	slots[i].key = 0;
+	count--;
+
+	for (i = 0; i <= mask; i++) {
+	    if (slots[i].key && slots[i].entry > entry)
+		slots[i].entry--;
+	}
+    }
+};
+
+#endif /* !_OS_OSCOLLECTIONINDEX_H */
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2009 Apple Inc. All rights reserved.
+ *
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_START@
+ * 
+ * This file contains Original Code and/or Modifications of Original Code
+ * as defined in and that are subject to the Apple Public Source License
+ * Version 2.0 (the 'License'). You may not use this file except in
+ * compliance with the License. The rights granted to you under the License
+ * may not be used to create, or enable the creation or redistribution of,
+ * unlawful or unlicensed copies of an Apple operating system, or to
+ * circumvent, violate, or enable the circumvention or violation of, any
+ * terms of an Apple operating system software license agreement.
+ * 
+ * Please obtain a copy of the License at
+ * http://www.opensource.apple.com/apsl/ and read it before using this file.
+ * 
+ * The Original Code and all software distributed under the License are
+ * distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, AND APPLE HEREBY DISCLAIMS ALL SUCH WARRANTIES,
+ * INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR NON-INFRINGEMENT.
+ * Please see the License for the specific language governing rights and
+ * limitations under the License.
+ * 
+ * @APPLE_OSREFERENCE_LICENSE_HEADER_END@
+ */
+
+#ifndef _OS_OSSERIALIZEBINARY_H
+#define _OS_OSSERIALIZEBINARY_H
+
+/*!
+    @header OSSerializeBinary
+    @abstract Compact binary encoding of OS Container objects.
+    @discussion
+    A binary stream starts with the word kOSSerializeBinarySignature and is followed by the items of one object tree in preorder.  Every item is a 32 bit header word in host byte order, holding the item type and a 24 bit length, followed by its payload padded to a multiple of four bytes.  Collections are not terminated, their header carries the number of items that follow as members: one per member of an OSArray or OSSet and two, key then value, per entry of an OSDictionary.
+    
+    Every item except a kOSSerializeObject reference is numbered in stream order from 0.  An object that has already been written, in particular a dictionary key OSSymbol, is written again as a kOSSerializeObject item whose length is that number.  The payload of a kOSSerializeData item is the raw bytes of the OSData, which the decoder may reference in place instead of copying.
+    
+    This header only defines the format and inline helpers to write and read it; neither OSSerialize nor OSUnserializeXML() produce or accept it.  The helpers have no kernel dependencies, so a driver or user client can use them on both sides of a connection.
+*/
+
+/*!
+    @enum OSSerializeBinary constants
+    @constant kOSSerializeBinarySignature First word of every binary stream.  Its first byte can not start an XML document, so callers may accept both encodings.
+    @constant kOSSerializeDictionary An OSDictionary, length is the number of entries.
+    @constant kOSSerializeArray An OSArray, length is the number of members.
+    @constant kOSSerializeSet An OSSet, length is the number of members.
+    @constant kOSSerializeNumber An OSNumber, length is the number of bits and the payload is 8 bytes.
+    @constant kOSSerializeSymbol An OSSymbol, length counts the bytes including the terminating NUL.
+    @constant kOSSerializeString An OSString, length counts the bytes without a terminating NUL.
+    @constant kOSSerializeData An OSData, length counts the bytes.
+    @constant kOSSerializeBoolean An OSBoolean, length is its value and there is no payload.
+    @constant kOSSerializeObject A reference to the previously written item whose number is length.  There is no payload.
+    @constant kOSSerializeTypeMask Mask of the type in a header word.
+    @constant kOSSerializeLengthMask Mask of the length in a header word.
+*/
+enum {
+    kOSSerializeBinarySignature = 0x000000D3U,
+
+    kOSSerializeDictionary      = 0x01000000U,
+    kOSSerializeArray           = 0x02000000U,
+    kOSSerializeSet             = 0x03000000U,
+    kOSSerializeNumber          = 0x04000000U,
+    kOSSerializeSymbol          = 0x08000000U,
+    kOSSerializeString          = 0x09000000U,
+    kOSSerializeData            = 0x0A000000U,
+    kOSSerializeBoolean         = 0x0B000000U,
+    kOSSerializeObject          = 0x0C000000U,
+
+    kOSSerializeTypeMask        = 0x7F000000U,
+    kOSSerializeLengthMask      = 0x00FFFFFFU
+};
+
+/*!
+    @function OSSerializeBinaryPayloadSize
+    @abstract Returns the number of payload bytes, without padding, that follow a header word.
+*/
+static inline unsigned int
+OSSerializeBinaryPayloadSize(unsigned int header)
+{
+    switch (header & kOSSerializeTypeMask) {
+    case kOSSerializeNumber:
+	return 8;
+    case kOSSerializeSymbol:
+    case kOSSerializeString:
+    case kOSSerializeData:
+	return header & kOSSerializeLengthMask;
+    default:
+	return 0;
+    }
+}
+
+/*!
+    @function OSSerializeBinaryEncode
+    @abstract Writes one item and returns the number of bytes it occupies.
+    @param dst Where the item is written, aligned to four bytes.  If 0 nothing is written and only the size is returned.
+    @param type One of the kOSSerialize type constants.
+    @param length The item length, at most kOSSerializeLengthMask.
+    @param bits The payload, OSSerializeBinaryPayloadSize() bytes of it are copied.
+*/
+static inline unsigned int
+OSSerializeBinaryEncode(void *dst, unsigned int type, unsigned int length,
+                        const void *bits)
+{
+    unsigned int header = type | (length & kOSSerializeLengthMask);
+    unsigned int size = OSSerializeBinaryPayloadSize(header);
+    unsigned int padded = (size + 3) & ~3U;
+
+    if (dst) {
+	unsigned char *p = (unsigned char *) dst;
+	const unsigned char *src = (const unsigned char *) bits;
+	unsigned int i;
+
+	*(unsigned int *) p = header;
+	p += sizeof(header);
+	for (i = 0; i < size; i++)
+	    p[i] = src[i];
+	for (; i < padded; i++)
+	    p[i] = 0;
+    }
+    return sizeof(header) + padded;
+}
+
+/*!
+    @struct OSSerializeBinaryItem
+    @abstract One decoded item.  bits points into the stream and is valid for as long as the stream is.
+*/
+struct OSSerializeBinaryItem {
+    unsigned int  type;
+    unsigned int  length;
+    const void   *bits;
+    unsigned int  size;
+};
+
+/*!
+    @struct OSSerializeBinaryReader
+    @abstract Streaming decoder that returns the items of a binary stream one at a time.
+    @discussion The reader checks every header and payload against the bounds of the stream, so it may be used on untrusted buffers such as user client payloads.  It does not check the nesting of collections or the targets of kOSSerializeObject references, which the caller tracks while it rebuilds the objects.
+*/
+struct OSSerializeBinaryReader {
+    const unsigned char *cursor;
+    const unsigned char *end;
+
+    /*!
+        @function init
+        @abstract Starts decoding bufferSize bytes at buffer, which must be aligned to four bytes.  Returns false if they do not start with kOSSerializeBinarySignature.
+    */
+    bool init(const void *buffer, unsigned long bufferSize)
+    {
+	cursor = (const unsigned char *) buffer;
+	end = cursor + bufferSize;
+	if (bufferSize < sizeof(unsigned int)
+	    || *(const unsigned int *) cursor != kOSSerializeBinarySignature)
+	    return false;
+	cursor += sizeof(unsigned int);
+	return true;
+    }
+
+    /*!
+        @function atEnd
+        @abstract Returns true once every item has been read.
+    */
+    bool atEnd() const
+    {
+	return cursor == end;
+    }
+
+    /*!
+        @function next
+        @abstract Reads the next item into *item.  Returns false at the end of the stream or if the item is malformed or truncated.
+    */
+    bool next(OSSerializeBinaryItem *item)
+    {
+	unsigned int header;
+	unsigned long padded;
+
+	if ((unsigned long) (end - cursor) < sizeof(header))
+	    return false;
+	header = *(const unsigned int *) cursor;
+	item->type = header & kOSSerializeTypeMask;
+	item->length = header & kOSSerializeLengthMask;
+	if (header & ~(kOSSerializeTypeMask | kOSSerializeLengthMask))
+	    return false;
+	switch (item->type) {
+	case kOSSerializeDictionary:
+	case kOSSerializeArray:
+	case kOSSerializeSet:
+	case kOSSerializeObject:
+	    break;
+	case kOSSerializeNumber:
+	    if (item->length > 64)
+		return false;
+	    break;
+	case kOSSerializeSymbol:
+	    if (!item->length)
+		return false;
+	    break;
+	case kOSSerializeString:
+	case kOSSerializeData:
+	    break;
+	case kOSSerializeBoolean:
+	    if (item->length > 1)
+		return false;
+	    break;
+	default:
+	    return false;
+	}
+
+	item->size = OSSerializeBinaryPayloadSize(header);
+	padded = (item->size + 3) & ~3U;
+	if ((unsigned long) (end - cursor) - sizeof(header) < padded)
+	    return false;
+	item->bits = cursor + sizeof(header);
+	if (item->type == kOSSerializeSymbol
+	    && ((const char *) item->bits)[item->size - 1])
+	    return false;
+	cursor += sizeof(header) + padded;
+	return true;
+    }
+};
+
+#endif /* !_OS_OSSERIALIZEBINARY_H */
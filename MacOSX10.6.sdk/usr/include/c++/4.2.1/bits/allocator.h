@@ -148,6 +148,37 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       }
     };
 
+  // Allocators whose deallocate does nothing, such as
+  // __gnu_cxx::arena_allocator, specialize this.
+  template<typename _Alloc>
+    struct __alloc_noop_deallocate
+    { enum { __value = 0 }; };
+
+  template<class _T1, class _T2>
+    struct pair;
+
+  // Types whose destructor does nothing: PODs, as approximated by
+  // __is_pod, and pairs of such types.
+  template<typename _Tp>
+    struct __has_trivial_dtor
+    { enum { __value = std::__is_pod<_Tp>::__value }; };
+
+  template<typename _T1, typename _T2>
+    struct __has_trivial_dtor<pair<_T1, _T2> >
+    {
+      enum { __value = (__has_trivial_dtor<_T1>::__value
+			&& __has_trivial_dtor<_T2>::__value) };
+    };
+
+  // Whether a node-based container may drop all its nodes at once,
+  // instead of destroying and deallocating each element in turn.
+  template<typename _Alloc, typename _Tp>
+    struct __alloc_skip_destroy
+    {
+      enum { __value = (__alloc_noop_deallocate<_Alloc>::__value
+			&& __has_trivial_dtor<_Tp>::__value) };
+    };
+
 _GLIBCXX_END_NAMESPACE
 
 #endif
@@ -713,8 +713,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return __n;
     }
 
+  // The searches are inline so that they are instantiated from these
+  // definitions, and the helpers of <bits/string_search.h>, even where
+  // basic_string<char> is an extern template.
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     find(const _CharT* __s, size_type __pos, size_type __n) const
     {
@@ -725,13 +728,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__n == 0)
 	return __pos <= __size ? __pos : npos;
 
-      if (__n <= __size)
+      if (__pos < __size)
 	{
-	  for (; __pos <= __size - __n; ++__pos)
-	    if (traits_type::eq(__data[__pos], __s[0])
-		&& traits_type::compare(__data + __pos + 1,
-					__s + 1, __n - 1) == 0)
-	      return __pos;
+	  const _CharT* __p = std::__search_string<traits_type>(__data + __pos,
+								__size - __pos,
+								__s, __n);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -755,7 +758,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     }
 
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     rfind(const _CharT* __s, size_type __pos, size_type __n) const
     {
@@ -764,13 +767,14 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__n <= __size)
 	{
 	  __pos = std::min(size_type(__size - __n), __pos);
+	  if (__n == 0)
+	    return __pos;
 	  const _CharT* __data = _M_data();
-	  do
-	    {
-	      if (traits_type::compare(__data + __pos, __s, __n) == 0)
-		return __pos;
-	    }
-	  while (__pos-- > 0);
+	  const _CharT* __p = std::__rsearch_string<traits_type>(__data,
+								 __pos + __n,
+								 __s, __n);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -793,22 +797,25 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     }
 
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     find_first_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
       __glibcxx_requires_string_len(__s, __n);
-      for (; __n && __pos < this->size(); ++__pos)
+      const size_type __size = this->size();
+      if (__n && __pos < __size)
 	{
-	  const _CharT* __p = traits_type::find(__s, __n, _M_data()[__pos]);
+	  const _CharT* __data = _M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_find(__data + __pos, __data + __size, __s, __n, true);
 	  if (__p)
-	    return __pos;
+	    return __p - __data;
 	}
       return npos;
     }
 
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     find_last_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
@@ -818,25 +825,30 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	{
 	  if (--__size > __pos)
 	    __size = __pos;
-	  do
-	    {
-	      if (traits_type::find(__s, __n, _M_data()[__size]))
-		return __size;
-	    }
-	  while (__size-- != 0);
+	  const _CharT* __data = _M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_rfind(__data, __data + __size + 1, __s, __n, true);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
 
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     find_first_not_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
       __glibcxx_requires_string_len(__s, __n);
-      for (; __pos < this->size(); ++__pos)
-	if (!traits_type::find(__s, __n, _M_data()[__pos]))
-	  return __pos;
+      const size_type __size = this->size();
+      if (__pos < __size)
+	{
+	  const _CharT* __data = _M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_find(__data + __pos, __data + __size, __s, __n, false);
+	  if (__p)
+	    return __p - __data;
+	}
       return npos;
     }
 
@@ -852,7 +864,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     }
 
   template<typename _CharT, typename _Traits, typename _Alloc>
-    typename basic_string<_CharT, _Traits, _Alloc>::size_type
+    inline typename basic_string<_CharT, _Traits, _Alloc>::size_type
     basic_string<_CharT, _Traits, _Alloc>::
     find_last_not_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
@@ -862,12 +874,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	{
 	  if (--__size > __pos)
 	    __size = __pos;
-	  do
-	    {
-	      if (!traits_type::find(__s, __n, _M_data()[__size]))
-		return __size;
-	    }
-	  while (__size--);
+	  const _CharT* __data = _M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_rfind(__data, __data + __size + 1, __s, __n, false);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -0,0 +1,856 @@
+// Fast numeric conversions for the "C" locale -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+
+/** @file fast_numeric.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+//
+// ISO C++ 14882: 27.6.1.2.2 / 27.6.2.5.2  Arithmetic extractors and inserters
+//
+
+// When a stream's locale is the classic one, num_get and num_put do
+// nothing a plain conversion could not: there is no grouping, the
+// decimal point is '.', and the digits are the ASCII ones.  The
+// routines here do that conversion directly on a char buffer, and the
+// basic_ostream and basic_istream arithmetic operators try them before
+// falling back to the facets.  Floating-point output still goes
+// through printf, but through snprintf_l with the "C" locale instead
+// of __convert_from_v, which has to switch the process locale back
+// and forth around every call.  The standard fixes that output as
+// %.*g of the precision, so shortest round-trip printing (Grisu2) is
+// only used on streams that ask for it with __gnu_cxx::shortest.
+
+#ifndef _FAST_NUMERIC_H
+#define _FAST_NUMERIC_H 1
+
+#pragma GCC system_header
+
+#include <cstdio>
+#include <xlocale.h>
+#include <limits>
+#include <ext/type_traits.h>
+#include <bits/ostream_insert.h>
+
+// basic_ostream<char> and basic_istream<char> are extern templates, so
+// an arithmetic operator that is not inlined resolves to the copy in
+// the shared library, which never takes the fast path.
+#define _GLIBCXX_FAST_NUMERIC_INLINE __attribute__((__always_inline__))
+
+_GLIBCXX_BEGIN_NAMESPACE(std)
+
+  /**
+   *  @if maint
+   *  The ios_base::xalloc() index of the __gnu_cxx::shortest flag, or
+   *  zero if no stream has used it yet.
+   *  @endif
+  */
+  inline int&
+  __shortest_float_slot()
+  {
+    static int __index;
+    return __index;
+  }
+
+  inline const char*
+  __digit_pairs()
+  {
+    static const char __pairs[201] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+    return __pairs;
+  }
+
+  /**
+   *  @if maint
+   *  Writes the decimal digits of @a u backwards, two at a time, ending
+   *  at @a last, and returns a pointer to the first one.  Values wider
+   *  than unsigned int are first cut into eight-digit chunks, so that
+   *  the 32-bit targets do one libgcc division per chunk rather than
+   *  one per digit.
+   *  @endif
+  */
+  template<typename _Tp>
+    char*
+    __fast_utoa10(char* __last, _Tp __u)
+    {
+      const char* __pairs = std::__digit_pairs();
+      while (sizeof(_Tp) > sizeof(unsigned int)
+	     && __u > numeric_limits<unsigned int>::max())
+	{
+	  unsigned int __r = __u % 100000000;
+	  __u /= 100000000;
+	  for (int __i = 0; __i < 4; ++__i)
+	    {
+	      const unsigned int __d = (__r % 100) * 2;
+	      __r /= 100;
+	      *--__last = __pairs[__d + 1];
+	      *--__last = __pairs[__d];
+	    }
+	}
+
+      unsigned int __n = __u;
+      while (__n >= 100)
+	{
+	  const unsigned int __d = (__n % 100) * 2;
+	  __n /= 100;
+	  *--__last = __pairs[__d + 1];
+	  *--__last = __pairs[__d];
+	}
+      if (__n >= 10)
+	{
+	  *--__last = __pairs[__n * 2 + 1];
+	  *--__last = __pairs[__n * 2];
+	}
+      else
+	*--__last = '0' + __n;
+      return __last;
+    }
+
+  // Floating-point values as a 64-bit significand and a binary
+  // exponent, for the Grisu2 shortest digit generation described in
+  // F. Loitsch, "Printing Floating-Point Numbers Quickly and
+  // Accurately with Integers", PLDI 2010.
+  struct __diy_fp
+  {
+    unsigned long long	_M_f;
+    int			_M_e;
+  };
+
+  inline __diy_fp
+  __diy_fp_mul(const __diy_fp& __x, const __diy_fp& __y)
+  {
+    // Upper half of the 128-bit product, rounded to nearest, done in
+    // 32-bit pieces so that it also works on i686 and powerpc.
+    const unsigned long long __m32 = 0xffffffffULL;
+    const unsigned long long __a = __x._M_f >> 32;
+    const unsigned long long __b = __x._M_f & __m32;
+    const unsigned long long __c = __y._M_f >> 32;
+    const unsigned long long __d = __y._M_f & __m32;
+    const unsigned long long __ac = __a * __c;
+    const unsigned long long __bc = __b * __c;
+    const unsigned long long __ad = __a * __d;
+    const unsigned long long __bd = __b * __d;
+    const unsigned long long __mid = ((__bd >> 32) + (__ad & __m32)
+				      + (__bc & __m32) + (1ULL << 31));
+    const __diy_fp __r = { __ac + (__ad >> 32) + (__bc >> 32) + (__mid >> 32),
+			   __x._M_e + __y._M_e + 64 };
+    return __r;
+  }
+
+  inline __diy_fp
+  __diy_fp_normalize(__diy_fp __x)
+  {
+    const int __s = __builtin_clzll(__x._M_f);
+    __x._M_f <<= __s;
+    __x._M_e -= __s;
+    return __x;
+  }
+
+  struct __cached_power
+  {
+    unsigned long long	_M_f;
+    int			_M_e;
+    int			_M_k;
+  };
+
+  /**
+   *  @if maint
+   *  Returns the normalized power of ten 10^k that scales a value with
+   *  binary exponent @a e into the window [-60, -32] that
+   *  __grisu2_digits works in.
+   *  @endif
+  */
+  inline const __cached_power&
+  __cached_power_for(int __e)
+  {
+    // 10^k for k = -300, -292, ..., 324.
+    static const __cached_power __powers[] =
+      {
+	{ 0xab70fe17c79ac6caULL, -1060, -300 },
+	{ 0xff77b1fcbebcdc4fULL, -1034, -292 },
+	{ 0xbe5691ef416bd60cULL, -1007, -284 },
+	{ 0x8dd01fad907ffc3cULL, -980, -276 },
+	{ 0xd3515c2831559a83ULL, -954, -268 },
+	{ 0x9d71ac8fada6c9b5ULL, -927, -260 },
+	{ 0xea9c227723ee8bcbULL, -901, -252 },
+	{ 0xaecc49914078536dULL, -874, -244 },
+	{ 0x823c12795db6ce57ULL, -847, -236 },
+	{ 0xc21094364dfb5637ULL, -821, -228 },
+	{ 0x9096ea6f3848984fULL, -794, -220 },
+	{ 0xd77485cb25823ac7ULL, -768, -212 },
+	{ 0xa086cfcd97bf97f4ULL, -741, -204 },
+	{ 0xef340a98172aace5ULL, -715, -196 },
+	{ 0xb23867fb2a35b28eULL, -688, -188 },
+	{ 0x84c8d4dfd2c63f3bULL, -661, -180 },
+	{ 0xc5dd44271ad3cdbaULL, -635, -172 },
+	{ 0x936b9fcebb25c996ULL, -608, -164 },
+	{ 0xdbac6c247d62a584ULL, -582, -156 },
+	{ 0xa3ab66580d5fdaf6ULL, -555, -148 },
+	{ 0xf3e2f893dec3f126ULL, -529, -140 },
+	{ 0xb5b5ada8aaff80b8ULL, -502, -132 },
+	{ 0x87625f056c7c4a8bULL, -475, -124 },
+	{ 0xc9bcff6034c13053ULL, -449, -116 },
+	{ 0x964e858c91ba2655ULL, -422, -108 },
+	{ 0xdff9772470297ebdULL, -396, -100 },
+	{ 0xa6dfbd9fb8e5b88fULL, -369, -92 },
+	{ 0xf8a95fcf88747d94ULL, -343, -84 },
+	{ 0xb94470938fa89bcfULL, -316, -76 },
+	{ 0x8a08f0f8bf0f156bULL, -289, -68 },
+	{ 0xcdb02555653131b6ULL, -263, -60 },
+	{ 0x993fe2c6d07b7facULL, -236, -52 },
+	{ 0xe45c10c42a2b3b06ULL, -210, -44 },
+	{ 0xaa242499697392d3ULL, -183, -36 },
+	{ 0xfd87b5f28300ca0eULL, -157, -28 },
+	{ 0xbce5086492111aebULL, -130, -20 },
+	{ 0x8cbccc096f5088ccULL, -103, -12 },
+	{ 0xd1b71758e219652cULL, -77, -4 },
+	{ 0x9c40000000000000ULL, -50, 4 },
+	{ 0xe8d4a51000000000ULL, -24, 12 },
+	{ 0xad78ebc5ac620000ULL, 3, 20 },
+	{ 0x813f3978f8940984ULL, 30, 28 },
+	{ 0xc097ce7bc90715b3ULL, 56, 36 },
+	{ 0x8f7e32ce7bea5c70ULL, 83, 44 },
+	{ 0xd5d238a4abe98068ULL, 109, 52 },
+	{ 0x9f4f2726179a2245ULL, 136, 60 },
+	{ 0xed63a231d4c4fb27ULL, 162, 68 },
+	{ 0xb0de65388cc8ada8ULL, 189, 76 },
+	{ 0x83c7088e1aab65dbULL, 216, 84 },
+	{ 0xc45d1df942711d9aULL, 242, 92 },
+	{ 0x924d692ca61be758ULL, 269, 100 },
+	{ 0xda01ee641a708deaULL, 295, 108 },
+	{ 0xa26da3999aef774aULL, 322, 116 },
+	{ 0xf209787bb47d6b85ULL, 348, 124 },
+	{ 0xb454e4a179dd1877ULL, 375, 132 },
+	{ 0x865b86925b9bc5c2ULL, 402, 140 },
+	{ 0xc83553c5c8965d3dULL, 428, 148 },
+	{ 0x952ab45cfa97a0b3ULL, 455, 156 },
+	{ 0xde469fbd99a05fe3ULL, 481, 164 },
+	{ 0xa59bc234db398c25ULL, 508, 172 },
+	{ 0xf6c69a72a3989f5cULL, 534, 180 },
+	{ 0xb7dcbf5354e9beceULL, 561, 188 },
+	{ 0x88fcf317f22241e2ULL, 588, 196 },
+	{ 0xcc20ce9bd35c78a5ULL, 614, 204 },
+	{ 0x98165af37b2153dfULL, 641, 212 },
+	{ 0xe2a0b5dc971f303aULL, 667, 220 },
+	{ 0xa8d9d1535ce3b396ULL, 694, 228 },
+	{ 0xfb9b7cd9a4a7443cULL, 720, 236 },
+	{ 0xbb764c4ca7a44410ULL, 747, 244 },
+	{ 0x8bab8eefb6409c1aULL, 774, 252 },
+	{ 0xd01fef10a657842cULL, 800, 260 },
+	{ 0x9b10a4e5e9913129ULL, 827, 268 },
+	{ 0xe7109bfba19c0c9dULL, 853, 276 },
+	{ 0xac2820d9623bf429ULL, 880, 284 },
+	{ 0x80444b5e7aa7cf85ULL, 907, 292 },
+	{ 0xbf21e44003acdd2dULL, 933, 300 },
+	{ 0x8e679c2f5e44ff8fULL, 960, 308 },
+	{ 0xd433179d9c8cb841ULL, 986, 316 },
+	{ 0x9e19db92b4e31ba9ULL, 1013, 324 }
+      };
+
+    // 78913 / 2^18 is log10(2), rounded up.
+    const int __f = -61 - __e;
+    const int __k = (__f * 78913) / (1 << 18) + (__f > 0);
+    return __powers[(300 + __k + 7) / 8];
+  }
+
+  inline void
+  __grisu2_round(char* __buf, int __len, unsigned long long __dist,
+		 unsigned long long __delta, unsigned long long __rest,
+		 unsigned long long __ten_k)
+  {
+    // Move the last digit down while that brings the result closer to
+    // the exact value and stays inside the rounding interval.
+    while (__rest < __dist && __delta - __rest >= __ten_k
+	   && (__rest + __ten_k < __dist
+	       || __dist - __rest > __rest + __ten_k - __dist))
+      {
+	--__buf[__len - 1];
+	__rest += __ten_k;
+      }
+  }
+
+  /**
+   *  @if maint
+   *  Generates into @a buf the shortest digit string inside the open
+   *  interval (@a mminus, @a mplus) that is nearest to @a w, all three
+   *  already scaled by the cached power.  Returns the number of digits
+   *  and adjusts @a exp10 by the position of the last one.
+   *  @endif
+  */
+  inline int
+  __grisu2_digits(char* __buf, int& __exp10, const __diy_fp& __mminus,
+		  const __diy_fp& __w, const __diy_fp& __mplus)
+  {
+    unsigned long long __delta = __mplus._M_f - __mminus._M_f;
+    unsigned long long __dist = __mplus._M_f - __w._M_f;
+    const int __shift = -__mplus._M_e;
+    const unsigned long long __one = 1ULL << __shift;
+    unsigned int __p1 = __mplus._M_f >> __shift;
+    unsigned long long __p2 = __mplus._M_f & (__one - 1);
+
+    unsigned int __pow10 = 1;
+    int __n = 1;
+    while (__p1 / __pow10 >= 10)
+      {
+	__pow10 *= 10;
+	++__n;
+      }
+
+    // Integral digits.
+    int __len = 0;
+    while (__n > 0)
+      {
+	__buf[__len++] = '0' + __p1 / __pow10;
+	__p1 %= __pow10;
+	--__n;
+	const unsigned long long __rest =
+	  (static_cast<unsigned long long>(__p1) << __shift) + __p2;
+	if (__rest <= __delta)
+	  {
+	    __exp10 += __n;
+	    std::__grisu2_round(__buf, __len, __dist, __delta, __rest,
+				static_cast<unsigned long long>(__pow10)
+				<< __shift);
+	    return __len;
+	  }
+	__pow10 /= 10;
+      }
+
+    // Fractional digits.
+    int __m = 0;
+    do
+      {
+	__p2 *= 10;
+	__buf[__len++] = '0' + (__p2 >> __shift);
+	__p2 &= __one - 1;
+	++__m;
+	__delta *= 10;
+	__dist *= 10;
+      }
+    while (__p2 > __delta);
+    __exp10 -= __m;
+    std::__grisu2_round(__buf, __len, __dist, __delta, __p2, __one);
+    return __len;
+  }
+
+  template<typename _Tp>
+    struct __float_layout;
+
+  template<>
+    struct __float_layout<float>
+    {
+      typedef unsigned int		__bits_type;
+      static const int _S_mantissa = 23;
+      static const int _S_bias = 150;
+    };
+
+  template<>
+    struct __float_layout<double>
+    {
+      typedef unsigned long long	__bits_type;
+      static const int _S_mantissa = 52;
+      static const int _S_bias = 1075;
+    };
+
+  /**
+   *  @if maint
+   *  Stores in @a buf the digits of a string that reads back as @a v
+   *  (finite and strictly positive), such that the value is the digits
+   *  times 10^@a exp10, and returns their number.  Grisu2 always
+   *  round-trips and is the shortest such string for nearly all
+   *  values; in the rare remaining cases it is one digit longer.
+   *  @endif
+  */
+  template<typename _Tp>
+    int
+    __grisu2(char* __buf, int& __exp10, _Tp __v)
+    {
+      typedef __float_layout<_Tp>			__layout;
+      typedef typename __layout::__bits_type		__bits_type;
+
+      __bits_type __bits;
+      __builtin_memcpy(&__bits, &__v, sizeof(__bits));
+      const __bits_type __hidden = __bits_type(1) << __layout::_S_mantissa;
+      const __bits_type __biased = __bits >> __layout::_S_mantissa;
+      const __bits_type __fraction = __bits & (__hidden - 1);
+
+      __diy_fp __w;
+      if (__biased)
+	{
+	  __w._M_f = __fraction + __hidden;
+	  __w._M_e = int(__biased) - __layout::_S_bias;
+	}
+      else
+	{
+	  __w._M_f = __fraction;
+	  __w._M_e = 1 - __layout::_S_bias;
+	}
+
+      // The rounding interval is half an ulp either side, except
+      // just above a power of two, where the ulp below is half size.
+      __diy_fp __mplus = { 2 * __w._M_f + 1, __w._M_e - 1 };
+      __diy_fp __mminus;
+      if (__fraction == 0 && __biased > 1)
+	{
+	  __mminus._M_f = 4 * __w._M_f - 1;
+	  __mminus._M_e = __w._M_e - 2;
+	}
+      else
+	{
+	  __mminus._M_f = 2 * __w._M_f - 1;
+	  __mminus._M_e = __w._M_e - 1;
+	}
+      __mplus = std::__diy_fp_normalize(__mplus);
+      __mminus._M_f <<= __mminus._M_e - __mplus._M_e;
+      __mminus._M_e = __mplus._M_e;
+      __w = std::__diy_fp_normalize(__w);
+
+      const __cached_power& __cp = std::__cached_power_for(__mplus._M_e);
+      const __diy_fp __c = { __cp._M_f, __cp._M_e };
+      __w = std::__diy_fp_mul(__w, __c);
+      __mminus = std::__diy_fp_mul(__mminus, __c);
+      __mplus = std::__diy_fp_mul(__mplus, __c);
+
+      // Stay strictly inside the interval to absorb the rounding
+      // error of the multiplications.
+      ++__mminus._M_f;
+      --__mplus._M_f;
+      __exp10 = -__cp._M_k;
+      return std::__grisu2_digits(__buf, __exp10, __mminus, __w, __mplus);
+    }
+
+  /**
+   *  @if maint
+   *  Formats @a v like %g would, but with the fewest significant
+   *  digits that read back as @a v instead of a fixed precision.  The
+   *  exponent form is used when the decimal exponent is below -4 or
+   *  at least 17, the precision needed to round-trip any double.
+   *  Honors showpos and uppercase.  Returns the length written to
+   *  @a buf, which must hold 32 chars, or 0 for infinities and NaNs.
+   *  @endif
+  */
+  template<typename _Tp>
+    int
+    __format_shortest(char* __buf, _Tp __v, ios_base::fmtflags __flags)
+    {
+      typedef typename __float_layout<_Tp>::__bits_type	__bits_type;
+
+      if (!(__v - __v == 0))
+	return 0;
+
+      char* __p = __buf;
+      __bits_type __bits;
+      __builtin_memcpy(&__bits, &__v, sizeof(__bits));
+      if (__bits >> (sizeof(__bits_type) * __CHAR_BIT__ - 1))
+	{
+	  *__p++ = '-';
+	  __v = -__v;
+	}
+      else if (__flags & ios_base::showpos)
+	*__p++ = '+';
+
+      if (__v == 0)
+	{
+	  *__p++ = '0';
+	  return __p - __buf;
+	}
+
+      char __digits[20];
+      int __exp10;
+      int __n = std::__grisu2(__digits, __exp10, __v);
+      while (__n > 1 && __digits[__n - 1] == '0')
+	{
+	  --__n;
+	  ++__exp10;
+	}
+
+      const int __point = __n + __exp10;
+      if (__point - 1 < -4 || __point - 1 >= 17)
+	{
+	  *__p++ = __digits[0];
+	  if (__n > 1)
+	    {
+	      *__p++ = '.';
+	      __builtin_memcpy(__p, __digits + 1, __n - 1);
+	      __p += __n - 1;
+	    }
+	  *__p++ = (__flags & ios_base::uppercase) ? 'E' : 'e';
+	  int __e = __point - 1;
+	  if (__e < 0)
+	    {
+	      *__p++ = '-';
+	      __e = -__e;
+	    }
+	  else
+	    *__p++ = '+';
+	  if (__e >= 100)
+	    {
+	      *__p++ = '0' + __e / 100;
+	      __e %= 100;
+	    }
+	  *__p++ = std::__digit_pairs()[__e * 2];
+	  *__p++ = std::__digit_pairs()[__e * 2 + 1];
+	}
+      else if (__point <= 0)
+	{
+	  *__p++ = '0';
+	  *__p++ = '.';
+	  __builtin_memset(__p, '0', -__point);
+	  __p += -__point;
+	  __builtin_memcpy(__p, __digits, __n);
+	  __p += __n;
+	}
+      else if (__point >= __n)
+	{
+	  __builtin_memcpy(__p, __digits, __n);
+	  __p += __n;
+	  __builtin_memset(__p, '0', __point - __n);
+	  __p += __point - __n;
+	}
+      else
+	{
+	  __builtin_memcpy(__p, __digits, __point);
+	  __p += __point;
+	  *__p++ = '.';
+	  __builtin_memcpy(__p, __digits + __point, __n - __point);
+	  __p += __n - __point;
+	}
+      return __p - __buf;
+    }
+
+  /**
+   *  @if maint
+   *  The printf conversion num_put uses for @a io's flags and
+   *  precision, done with snprintf_l in the "C" locale.  Returns what
+   *  snprintf_l returns.
+   *  @endif
+  */
+  inline int
+  __format_float_c(char* __buf, size_t __size, const ios_base& __io,
+		   double __v)
+  {
+    // Same conversion as __num_base::_S_format_float.
+    const ios_base::fmtflags __flags = __io.flags();
+    const ios_base::fmtflags __fltfield = __flags & ios_base::floatfield;
+    char __fbuf[16];
+    char* __fptr = __fbuf;
+    *__fptr++ = '%';
+    if (__flags & ios_base::showpos)
+      *__fptr++ = '+';
+    if (__flags & ios_base::showpoint)
+      *__fptr++ = '#';
+    *__fptr++ = '.';
+    *__fptr++ = '*';
+    if (__fltfield == ios_base::fixed)
+      *__fptr++ = 'f';
+    else if (__fltfield == ios_base::scientific)
+      *__fptr++ = (__flags & ios_base::uppercase) ? 'E' : 'e';
+    else
+      *__fptr++ = (__flags & ios_base::uppercase) ? 'G' : 'g';
+    *__fptr = '\0';
+
+    const int __prec = __io.precision() < 0 ? 6 : __io.precision();
+    return snprintf_l(__buf, __size, _c_locale, __fbuf, __prec, __v);
+  }
+
+  /**
+   *  @if maint
+   *  Integer extraction for a char stream in the classic locale with
+   *  ios_base::dec, the equivalent of num_get::_M_extract_int: an
+   *  optional sign, then decimal digits, read straight out of the get
+   *  area whenever @a sb has one.  Returns the state bits to set.
+   *  @endif
+  */
+  template<typename _Traits, typename _ValueT>
+    ios_base::iostate
+    __streambuf_extract_int(basic_streambuf<char, _Traits>* __sb,
+			    _ValueT& __v)
+    {
+      typedef typename _Traits::int_type			__int_type;
+      typedef typename __gnu_cxx::__add_unsigned<_ValueT>::__type
+							__unsigned_type;
+
+      const __int_type __eof = _Traits::eof();
+      ios_base::iostate __err = ios_base::iostate(ios_base::goodbit);
+
+      __int_type __c = __sb->sgetc();
+      bool __negative = false;
+      if (!_Traits::eq_int_type(__c, __eof))
+	{
+	  const char __ch = _Traits::to_char_type(__c);
+	  if (numeric_limits<_ValueT>::is_signed)
+	    __negative = __ch == '-';
+	  if (__negative || __ch == '+')
+	    __c = __sb->snextc();
+	}
+
+      const __unsigned_type __max = __negative
+	? -static_cast<__unsigned_type>(numeric_limits<_ValueT>::min())
+	: numeric_limits<_ValueT>::max();
+      const __unsigned_type __smax = __max / 10;
+      // Up to digits10 digits cannot overflow, so only the ones past
+      // that need the checks.
+      const int __safe = numeric_limits<_ValueT>::digits10;
+      __unsigned_type __result = 0;
+      int __ndigits = 0;
+      bool __testfail = false;
+
+      while (!_Traits::eq_int_type(__c, __eof))
+	{
+	  // Scan what is left of the get area, or, for an unbuffered
+	  // streambuf, just the character sgetc returned.
+	  char __ch;
+	  const char* __p = __sb->gptr();
+	  const char* __end = __sb->egptr();
+	  const bool __buffered = __p != __end;
+	  if (!__buffered)
+	    {
+	      __ch = _Traits::to_char_type(__c);
+	      __p = &__ch;
+	      __end = __p + 1;
+	    }
+
+	  const char* __q = __p;
+	  for (; __q != __end; ++__q)
+	    {
+	      const unsigned int __digit = static_cast<unsigned char>(*__q)
+		                           - static_cast<unsigned int>('0');
+	      if (__digit > 9)
+		break;
+
+	      if (__ndigits < __safe)
+		__result = __result * 10 + __digit;
+	      else if (__result > __smax)
+		__testfail = true;
+	      else
+		{
+		  __result *= 10;
+		  __testfail |= __result > __max - __digit;
+		  __result += __digit;
+		}
+	      ++__ndigits;
+	    }
+
+	  const bool __done = __q != __end;
+	  if (__buffered)
+	    {
+	      __sb->gbump(__q - __p);
+	      if (__done)
+		break;
+	      __c = __sb->sgetc();
+	    }
+	  else
+	    {
+	      if (__done)
+		break;
+	      __c = __sb->snextc();
+	    }
+	}
+
+      if (!__testfail && __ndigits)
+	__v = __negative ? -__result : __result;
+      else
+	__err |= ios_base::failbit;
+
+      if (_Traits::eq_int_type(__c, __eof))
+	__err |= ios_base::eofbit;
+      return __err;
+    }
+
+  // The entry points used by the basic_ostream and basic_istream
+  // arithmetic operators.  Each returns false, having done nothing,
+  // when the fast path does not apply, and the caller then goes
+  // through the facets as usual.
+  template<typename _CharT, typename _Traits, typename _ValueT>
+    inline bool
+    __ostream_insert_int(basic_ostream<_CharT, _Traits>&, _ValueT)
+    { return false; }
+
+  template<typename _Traits, typename _ValueT>
+    bool
+    __ostream_insert_int(basic_ostream<char, _Traits>& __out, _ValueT __v)
+    {
+      typedef basic_ostream<char, _Traits>			__ostream_type;
+      typedef typename __ostream_type::ios_base		__ios_base;
+      typedef typename __gnu_cxx::__add_unsigned<_ValueT>::__type
+							__unsigned_type;
+
+      const ios_base::fmtflags __flags = __out.flags();
+      const ios_base::fmtflags __basefield = __flags & __ios_base::basefield;
+      if (__out.width() || __basefield == __ios_base::oct
+	  || __basefield == __ios_base::hex
+	  || !std::__is_classic_locale(__out._M_getloc()))
+	return false;
+
+      // Enough for the digits and a sign.
+      char __buf[3 * sizeof(_ValueT) + 1];
+      char* const __end = __buf + sizeof(__buf);
+      const __unsigned_type __u = __v > 0 ? __unsigned_type(__v)
+	                                  : -__unsigned_type(__v);
+      char* __cs = std::__fast_utoa10(__end, __u);
+      if (__v > 0)
+	{
+	  if (__flags & __ios_base::showpos
+	      && numeric_limits<_ValueT>::is_signed)
+	    *--__cs = '+';
+	}
+      else if (__v)
+	*--__cs = '-';
+
+      typename __ostream_type::sentry __cerb(__out);
+      if (__cerb)
+	{
+	  try
+	    { std::__ostream_write(__out, __cs, __end - __cs); }
+	  catch(...)
+	    { __out._M_setstate(__ios_base::badbit); }
+	}
+      return true;
+    }
+
+  template<typename _CharT, typename _Traits, typename _ValueT>
+    inline bool
+    __ostream_insert_float(basic_ostream<_CharT, _Traits>&, _ValueT)
+    { return false; }
+
+  template<typename _Traits, typename _ValueT>
+    bool
+    __ostream_insert_float(basic_ostream<char, _Traits>& __out, _ValueT __v)
+    {
+      typedef basic_ostream<char, _Traits>			__ostream_type;
+      typedef typename __ostream_type::ios_base		__ios_base;
+
+      // Leave padding, and precisions that could not fit in the
+      // buffer anyway, to num_put.
+      if (__out.width() || __out.precision() > 64
+	  || !std::__is_classic_locale(__out._M_getloc()))
+	return false;
+
+      const ios_base::fmtflags __flags = __out.flags();
+      char __cs[128];
+      int __len = 0;
+      const int __index = std::__shortest_float_slot();
+      if (__index
+	  && !(__flags & (__ios_base::floatfield | __ios_base::showpoint))
+	  && __out.iword(__index))
+	__len = std::__format_shortest(__cs, __v, __flags);
+      if (!__len)
+	{
+	  __len = std::__format_float_c(__cs, sizeof(__cs), __out, __v);
+	  if (__len < 0 || __len >= int(sizeof(__cs)))
+	    return false;
+	}
+
+      typename __ostream_type::sentry __cerb(__out);
+      if (__cerb)
+	{
+	  try
+	    { std::__ostream_write(__out, __cs, __len); }
+	  catch(...)
+	    { __out._M_setstate(__ios_base::badbit); }
+	}
+      return true;
+    }
+
+  template<typename _CharT, typename _Traits, typename _ValueT>
+    inline bool
+    __istream_extract_int(basic_istream<_CharT, _Traits>&, _ValueT&)
+    { return false; }
+
+  template<typename _Traits, typename _ValueT>
+    bool
+    __istream_extract_int(basic_istream<char, _Traits>& __in, _ValueT& __v)
+    {
+      typedef basic_istream<char, _Traits>			__istream_type;
+      typedef typename __istream_type::ios_base		__ios_base;
+
+      if ((__in.flags() & __ios_base::basefield) != __ios_base::dec
+	  || !std::__is_classic_locale(__in._M_getloc()))
+	return false;
+
+      typename __istream_type::sentry __cerb(__in, false);
+      if (__cerb)
+	{
+	  ios_base::iostate __err = ios_base::iostate(ios_base::goodbit);
+	  try
+	    { __err = std::__streambuf_extract_int(__in.rdbuf(), __v); }
+	  catch(...)
+	    { __in._M_setstate(__ios_base::badbit); }
+	  if (__err)
+	    __in.setstate(__err);
+	}
+      return true;
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  /**
+   *  @brief  Print floating-point values with the fewest digits that
+   *          read back exactly.
+   *
+   *  Affects the default floatfield (neither fixed nor scientific)
+   *  without showpoint, for char streams in the classic locale, where
+   *  it replaces the precision: 0.1 prints as 0.1, and 1.0/3 as
+   *  0.3333333333333333, whatever the precision is.  The value is
+   *  printed in exponent form when its decimal exponent is below -4
+   *  or at least 17.  Everywhere else it has no effect.
+   *
+   *  @code
+   *  std::cout << __gnu_cxx::shortest << 0.1 + 0.2;  // 0.30000000000000004
+   *  @endcode
+  */
+  inline std::ios_base&
+  shortest(std::ios_base& __base)
+  {
+    static const int __index = (std::__shortest_float_slot()
+				= std::ios_base::xalloc());
+    __base.iword(__index) = 1;
+    return __base;
+  }
+
+  /// Undo __gnu_cxx::shortest.
+  inline std::ios_base&
+  noshortest(std::ios_base& __base)
+  {
+    if (const int __index = std::__shortest_float_slot())
+      __base.iword(__index) = 0;
+    return __base;
+  }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif /* _FAST_NUMERIC_H */
@@ -69,6 +69,9 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
     _List_base<_Tp, _Alloc>::
     _M_clear()
     {
+      if (std::__alloc_skip_destroy<_Node_alloc_type, _Tp>::__value)
+	return;
+
       typedef _List_node<_Tp>  _Node;
       _Node* __cur = static_cast<_Node*>(this->_M_impl._M_node._M_next);
       while (__cur != &this->_M_impl._M_node)
@@ -78,6 +78,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     friend class facet;
     friend class _Impl;
 
+    friend bool
+    __is_classic_locale(const locale&) throw();
+
     template<typename _Facet>
       friend bool
       has_facet(const locale&) throw();
@@ -328,6 +331,20 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _M_coalesce(const locale& __base, const locale& __add, category __cat);
   };
 
+  /**
+   *  @if maint
+   *  True if @a loc shares its implementation with locale::classic(),
+   *  so every facet in it is a "C" one.  Used by the stream inserters
+   *  and extractors to bypass the numeric facets.
+   *  @endif
+  */
+  inline bool
+  __is_classic_locale(const locale& __loc) throw()
+  {
+    static const locale::_Impl* const __classic = locale::classic()._M_impl;
+    return __loc._M_impl == __classic;
+  }
+
 
   // 22.1.1.1.2  Class locale::facet
   /**
@@ -52,6 +52,14 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   // 22.1.1 Locale
   class locale;
 
+  template<typename _Facet>
+    bool
+    has_facet(const locale&) throw();
+
+  template<typename _Facet>
+    const _Facet&
+    use_facet(const locale&);
+
   // 22.1.3 Convenience interfaces
   template<typename _CharT>
     inline bool
@@ -0,0 +1,618 @@
+// Components for manipulating sequences of characters, SSO mode -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file sso_string.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+//
+// ISO C++ 14882: 21 Strings library
+//
+
+#ifndef _SSO_STRING_H
+#define _SSO_STRING_H 1
+
+#pragma GCC system_header
+
+#include <ext/vstring.h>
+
+namespace std
+{
+namespace __sso _GLIBCXX_VISIBILITY(default)
+{
+  /**
+   *  @class basic_string sso_string.h <string>
+   *  @brief  Managing sequences of characters and character-like objects.
+   *
+   *  This is the representation of std::basic_string selected by
+   *  defining _GLIBCXX_SSO_STRING.  Instead of sharing a reference
+   *  counted _Rep between copies, every string owns its characters,
+   *  and strings shorter than 16 bytes are stored inside the object
+   *  itself (see __gnu_cxx::__sso_string_base).  Copies never touch
+   *  an atomic counter and short strings never touch the heap.
+   *
+   *  The class lives in the namespace std::__sso, which is strongly
+   *  associated with std.  User code still spells it std::string, but
+   *  every symbol that mentions it is mangled differently from the
+   *  reference counted std::basic_string.  Objects built in the two
+   *  modes therefore fail to link against each other instead of
+   *  silently exchanging incompatible layouts; this includes the
+   *  entry points of the compiled library that take std::string, which
+   *  need a runtime built with the same setting.
+   */
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    class basic_string
+    : public __gnu_cxx::__versa_string<_CharT, _Traits, _Alloc,
+				       __gnu_cxx::__sso_string_base>
+    {
+      typedef __gnu_cxx::__versa_string<_CharT, _Traits, _Alloc,
+					__gnu_cxx::__sso_string_base> _Base;
+
+    public:
+      typedef typename _Base::traits_type		    traits_type;
+      typedef typename _Base::value_type		    value_type;
+      typedef typename _Base::allocator_type		    allocator_type;
+      typedef typename _Base::size_type			    size_type;
+      typedef typename _Base::difference_type		    difference_type;
+      typedef typename _Base::reference			    reference;
+      typedef typename _Base::const_reference		    const_reference;
+      typedef typename _Base::pointer			    pointer;
+      typedef typename _Base::const_pointer		    const_pointer;
+      typedef typename _Base::iterator			    iterator;
+      typedef typename _Base::const_iterator		    const_iterator;
+      typedef typename _Base::const_reverse_iterator	    const_reverse_iterator;
+      typedef typename _Base::reverse_iterator		    reverse_iterator;
+
+      using _Base::npos;
+
+      // Construct/copy/destroy:
+      basic_string()
+      : _Base() { }
+
+      explicit
+      basic_string(const _Alloc& __a)
+      : _Base(__a) { }
+
+      basic_string(const basic_string& __str)
+      : _Base(__str) { }
+
+      /// Adopts the result of an operation of the underlying
+      /// __versa_string, e.g. the operators of <ext/vstring.h>.
+      basic_string(const _Base& __str)
+      : _Base(__str) { }
+
+      basic_string(const basic_string& __str, size_type __pos,
+		   size_type __n = npos)
+      : _Base(__str, __pos, __n) { }
+
+      basic_string(const basic_string& __str, size_type __pos,
+		   size_type __n, const _Alloc& __a)
+      : _Base(__str, __pos, __n, __a) { }
+
+      basic_string(const _CharT* __s, size_type __n,
+		   const _Alloc& __a = _Alloc())
+      : _Base(__s, __n, __a) { }
+
+      basic_string(const _CharT* __s, const _Alloc& __a = _Alloc())
+      : _Base(__s, __a) { }
+
+      basic_string(size_type __n, _CharT __c, const _Alloc& __a = _Alloc())
+      : _Base(__n, __c, __a) { }
+
+      template<class _InputIterator>
+        basic_string(_InputIterator __beg, _InputIterator __end,
+		     const _Alloc& __a = _Alloc())
+	: _Base(__beg, __end, __a) { }
+
+      ~basic_string() { }
+
+      basic_string&
+      operator=(const basic_string& __str)
+      {
+	_Base::operator=(__str);
+	return *this;
+      }
+
+      basic_string&
+      operator=(const _CharT* __s)
+      {
+	_Base::operator=(__s);
+	return *this;
+      }
+
+      basic_string&
+      operator=(_CharT __c)
+      {
+	_Base::operator=(__c);
+	return *this;
+      }
+
+      // Modifiers.  These only rebind the return type of the members
+      // of __versa_string so that chained calls keep the std type.
+      basic_string&
+      operator+=(const basic_string& __str)
+      { return this->append(__str); }
+
+      basic_string&
+      operator+=(const _CharT* __s)
+      { return this->append(__s); }
+
+      basic_string&
+      operator+=(_CharT __c)
+      {
+	this->push_back(__c);
+	return *this;
+      }
+
+      basic_string&
+      append(const basic_string& __str)
+      {
+	_Base::append(__str);
+	return *this;
+      }
+
+      basic_string&
+      append(const basic_string& __str, size_type __pos, size_type __n)
+      {
+	_Base::append(__str, __pos, __n);
+	return *this;
+      }
+
+      basic_string&
+      append(const _CharT* __s, size_type __n)
+      {
+	_Base::append(__s, __n);
+	return *this;
+      }
+
+      basic_string&
+      append(const _CharT* __s)
+      {
+	_Base::append(__s);
+	return *this;
+      }
+
+      basic_string&
+      append(size_type __n, _CharT __c)
+      {
+	_Base::append(__n, __c);
+	return *this;
+      }
+
+      template<class _InputIterator>
+        basic_string&
+        append(_InputIterator __first, _InputIterator __last)
+        {
+	  _Base::append(__first, __last);
+	  return *this;
+	}
+
+      basic_string&
+      assign(const basic_string& __str)
+      {
+	_Base::assign(__str);
+	return *this;
+      }
+
+      basic_string&
+      assign(const basic_string& __str, size_type __pos, size_type __n)
+      {
+	_Base::assign(__str, __pos, __n);
+	return *this;
+      }
+
+      basic_string&
+      assign(const _CharT* __s, size_type __n)
+      {
+	_Base::assign(__s, __n);
+	return *this;
+      }
+
+      basic_string&
+      assign(const _CharT* __s)
+      {
+	_Base::assign(__s);
+	return *this;
+      }
+
+      basic_string&
+      assign(size_type __n, _CharT __c)
+      {
+	_Base::assign(__n, __c);
+	return *this;
+      }
+
+      template<class _InputIterator>
+        basic_string&
+        assign(_InputIterator __first, _InputIterator __last)
+        {
+	  _Base::assign(__first, __last);
+	  return *this;
+	}
+
+      void
+      insert(iterator __p, size_type __n, _CharT __c)
+      { _Base::insert(__p, __n, __c); }
+
+      template<class _InputIterator>
+        void
+        insert(iterator __p, _InputIterator __beg, _InputIterator __end)
+        { _Base::insert(__p, __beg, __end); }
+
+      basic_string&
+      insert(size_type __pos1, const basic_string& __str)
+      {
+	_Base::insert(__pos1, __str);
+	return *this;
+      }
+
+      basic_string&
+      insert(size_type __pos1, const basic_string& __str,
+	     size_type __pos2, size_type __n)
+      {
+	_Base::insert(__pos1, __str, __pos2, __n);
+	return *this;
+      }
+
+      basic_string&
+      insert(size_type __pos, const _CharT* __s, size_type __n)
+      {
+	_Base::insert(__pos, __s, __n);
+	return *this;
+      }
+
+      basic_string&
+      insert(size_type __pos, const _CharT* __s)
+      {
+	_Base::insert(__pos, __s);
+	return *this;
+      }
+
+      basic_string&
+      insert(size_type __pos, size_type __n, _CharT __c)
+      {
+	_Base::insert(__pos, __n, __c);
+	return *this;
+      }
+
+      iterator
+      insert(iterator __p, _CharT __c)
+      { return _Base::insert(__p, __c); }
+
+      basic_string&
+      erase(size_type __pos = 0, size_type __n = npos)
+      {
+	_Base::erase(__pos, __n);
+	return *this;
+      }
+
+      iterator
+      erase(iterator __position)
+      { return _Base::erase(__position); }
+
+      iterator
+      erase(iterator __first, iterator __last)
+      { return _Base::erase(__first, __last); }
+
+      basic_string&
+      replace(size_type __pos, size_type __n, const basic_string& __str)
+      {
+	_Base::replace(__pos, __n, __str);
+	return *this;
+      }
+
+      basic_string&
+      replace(size_type __pos1, size_type __n1, const basic_string& __str,
+	      size_type __pos2, size_type __n2)
+      {
+	_Base::replace(__pos1, __n1, __str, __pos2, __n2);
+	return *this;
+      }
+
+      basic_string&
+      replace(size_type __pos, size_type __n1, const _CharT* __s,
+	      size_type __n2)
+      {
+	_Base::replace(__pos, __n1, __s, __n2);
+	return *this;
+      }
+
+      basic_string&
+      replace(size_type __pos, size_type __n1, const _CharT* __s)
+      {
+	_Base::replace(__pos, __n1, __s);
+	return *this;
+      }
+
+      basic_string&
+      replace(size_type __pos, size_type __n1, size_type __n2, _CharT __c)
+      {
+	_Base::replace(__pos, __n1, __n2, __c);
+	return *this;
+      }
+
+      basic_string&
+      replace(iterator __i1, iterator __i2, const basic_string& __str)
+      {
+	_Base::replace(__i1, __i2, __str);
+	return *this;
+      }
+
+      basic_string&
+      replace(iterator __i1, iterator __i2, const _CharT* __s, size_type __n)
+      {
+	_Base::replace(__i1, __i2, __s, __n);
+	return *this;
+      }
+
+      basic_string&
+      replace(iterator __i1, iterator __i2, const _CharT* __s)
+      {
+	_Base::replace(__i1, __i2, __s);
+	return *this;
+      }
+
+      basic_string&
+      replace(iterator __i1, iterator __i2, size_type __n, _CharT __c)
+      {
+	_Base::replace(__i1, __i2, __n, __c);
+	return *this;
+      }
+
+      template<class _InputIterator>
+        basic_string&
+        replace(iterator __i1, iterator __i2,
+		_InputIterator __k1, _InputIterator __k2)
+        {
+	  _Base::replace(__i1, __i2, __k1, __k2);
+	  return *this;
+	}
+
+      void
+      swap(basic_string& __s)
+      { _Base::swap(__s); }
+
+      basic_string
+      substr(size_type __pos = 0, size_type __n = npos) const
+      { return basic_string(*this, __pos, __n); }
+    };
+
+  // Operators.  Exact matches for basic_string, so that these are
+  // preferred over the __versa_string templates reached through the
+  // base class and the results keep the std type.
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_string<_CharT, _Traits, _Alloc>
+    operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    {
+      basic_string<_CharT, _Traits, _Alloc> __str;
+      __str.reserve(__lhs.size() + __rhs.size());
+      __str.append(__lhs);
+      __str.append(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_string<_CharT, _Traits, _Alloc>
+    operator+(const _CharT* __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    {
+      const typename basic_string<_CharT, _Traits, _Alloc>::size_type
+	__len = _Traits::length(__lhs);
+      basic_string<_CharT, _Traits, _Alloc> __str;
+      __str.reserve(__len + __rhs.size());
+      __str.append(__lhs, __len);
+      __str.append(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_string<_CharT, _Traits, _Alloc>
+    operator+(_CharT __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    {
+      basic_string<_CharT, _Traits, _Alloc> __str;
+      __str.reserve(__rhs.size() + 1);
+      __str.push_back(__lhs);
+      __str.append(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_string<_CharT, _Traits, _Alloc>
+    operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const _CharT* __rhs)
+    {
+      const typename basic_string<_CharT, _Traits, _Alloc>::size_type
+	__len = _Traits::length(__rhs);
+      basic_string<_CharT, _Traits, _Alloc> __str;
+      __str.reserve(__lhs.size() + __len);
+      __str.append(__lhs);
+      __str.append(__rhs, __len);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_string<_CharT, _Traits, _Alloc>
+    operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      _CharT __rhs)
+    {
+      basic_string<_CharT, _Traits, _Alloc> __str;
+      __str.reserve(__lhs.size() + 1);
+      __str.append(__lhs);
+      __str.push_back(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator==(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) == 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator==(const _CharT* __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) == 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator==(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const _CharT* __rhs)
+    { return __lhs.compare(__rhs) == 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator!=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) != 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator!=(const _CharT* __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) != 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator!=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const _CharT* __rhs)
+    { return __lhs.compare(__rhs) != 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) < 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const _CharT* __rhs)
+    { return __lhs.compare(__rhs) < 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<(const _CharT* __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) > 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) > 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	      const _CharT* __rhs)
+    { return __lhs.compare(__rhs) > 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>(const _CharT* __lhs,
+	      const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) < 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) <= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const _CharT* __rhs)
+    { return __lhs.compare(__rhs) <= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator<=(const _CharT* __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) >= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __lhs.compare(__rhs) >= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>=(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	       const _CharT* __rhs)
+    { return __lhs.compare(__rhs) >= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline bool
+    operator>=(const _CharT* __lhs,
+	       const basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { return __rhs.compare(__lhs) <= 0; }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline void
+    swap(basic_string<_CharT, _Traits, _Alloc>& __lhs,
+	 basic_string<_CharT, _Traits, _Alloc>& __rhs)
+    { __lhs.swap(__rhs); }
+} // namespace __sso
+
+  // Stream operators.  The extractors are defined generically for
+  // basic_string in <bits/istream.tcc>.
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_istream<_CharT, _Traits>&
+    operator>>(basic_istream<_CharT, _Traits>& __is,
+	       basic_string<_CharT, _Traits, _Alloc>& __str);
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_ostream<_CharT, _Traits>&
+    operator<<(basic_ostream<_CharT, _Traits>& __os,
+	       const basic_string<_CharT, _Traits, _Alloc>& __str)
+    {
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 586. string inserter not a formatted function
+      return __ostream_insert(__os, __str.data(), __str.size());
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_istream<_CharT, _Traits>&
+    getline(basic_istream<_CharT, _Traits>& __is,
+	    basic_string<_CharT, _Traits, _Alloc>& __str, _CharT __delim);
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    inline basic_istream<_CharT, _Traits>&
+    getline(basic_istream<_CharT, _Traits>& __is,
+	    basic_string<_CharT, _Traits, _Alloc>& __str)
+    { return getline(__is, __str, __is.widen('\n')); }
+} // namespace std
+
+#endif /* _SSO_STRING_H */
@@ -65,6 +65,9 @@
 #include <bits/stl_heap.h>
 #include <bits/stl_tempbuf.h>     // for _Temporary_buffer
 #include <debug/debug.h>
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/algorithmfwd.h>
+#endif
 
 // See concept_check.h for the __glibcxx_*_requires macros.
 
@@ -932,9 +935,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
             __typeof__(__unary_op(*__first))>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      return __gnu_parallel::transform(__first, __last, __result, __unary_op);
+#else
       for ( ; __first != __last; ++__first, ++__result)
 	*__result = __unary_op(*__first);
       return __result;
+#endif
     }
 
   /**
@@ -969,9 +976,14 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
             __typeof__(__binary_op(*__first1,*__first2))>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
+#ifdef _GLIBCXX_PARALLEL
+      return __gnu_parallel::transform(__first1, __last1, __first2, __result,
+				       __binary_op);
+#else
       for ( ; __first1 != __last1; ++__first1, ++__first2, ++__result)
 	*__result = __binary_op(*__first1, *__first2);
       return __result;
+#endif
     }
 
   /**
@@ -2824,12 +2836,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_LessThanComparableConcept<_ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::sort(__first, __last);
+#else
       if (__first != __last)
 	{
 	  std::__introsort_loop(__first, __last,
 				std::__lg(__last - __first) * 2);
 	  std::__final_insertion_sort(__first, __last);
 	}
+#endif
     }
 
   /**
@@ -2861,12 +2877,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 				  _ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::sort(__first, __last, __comp);
+#else
       if (__first != __last)
 	{
 	  std::__introsort_loop(__first, __last,
 				std::__lg(__last - __first) * 2, __comp);
 	  std::__final_insertion_sort(__first, __last, __comp);
 	}
+#endif
     }
 
   /**
@@ -3886,6 +3906,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_LessThanComparableConcept<_ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::stable_sort(__first, __last);
+#else
       _Temporary_buffer<_RandomAccessIterator, _ValueType> __buf(__first,
 								 __last);
       if (__buf.begin() == 0)
@@ -3893,6 +3916,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       else
 	std::__stable_sort_adaptive(__first, __last, __buf.begin(),
 				    _DistanceType(__buf.size()));
+#endif
     }
 
   /**
@@ -3930,6 +3954,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 				  _ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::stable_sort(__first, __last, __comp);
+#else
       _Temporary_buffer<_RandomAccessIterator, _ValueType> __buf(__first,
 								 __last);
       if (__buf.begin() == 0)
@@ -3937,6 +3964,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       else
 	std::__stable_sort_adaptive(__first, __last, __buf.begin(),
 				    _DistanceType(__buf.size()), __comp);
+#endif
     }
 
 
@@ -4045,8 +4073,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__first == __last || __nth == __last)
 	return;
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::nth_element(__first, __nth, __last);
+#else
       std::__introselect(__first, __nth, __last,
 			 std::__lg(__last - __first) * 2);
+#endif
     }
 
   /**
@@ -4084,8 +4116,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__first == __last || __nth == __last)
 	return;
 
+#ifdef _GLIBCXX_PARALLEL
+      __gnu_parallel::nth_element(__first, __nth, __last, __comp);
+#else
       std::__introselect(__first, __nth, __last,
 			 std::__lg(__last - __first) * 2, __comp);
+#endif
     }
 
   /**
@@ -5501,4 +5537,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
 _GLIBCXX_END_NAMESPACE
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/algo.h>
+#endif
+
 #endif /* _ALGO_H */
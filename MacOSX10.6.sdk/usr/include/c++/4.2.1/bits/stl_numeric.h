@@ -62,6 +62,9 @@
 #define _STL_NUMERIC_H 1
 
 #include <debug/debug.h>
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/numericfwd.h>
+#endif
 
 _GLIBCXX_BEGIN_NAMESPACE(std)
 
@@ -84,9 +87,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      typedef typename iterator_traits<_InputIterator>::value_type _ValueType;
+      return __gnu_parallel::__accumulate_switch(__first, __last, __init,
+		 typename __truth_type<__are_same<_Tp, _ValueType>::__value
+		 && __is_arithmetic<_Tp>::__value>::__type());
+#else
       for (; __first != __last; ++__first)
 	__init = __init + *__first;
       return __init;
+#endif
     }
 
   /**
@@ -140,9 +150,21 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator2>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
+#ifdef _GLIBCXX_PARALLEL
+      typedef typename iterator_traits<_InputIterator1>::value_type
+	_ValueType1;
+      typedef typename iterator_traits<_InputIterator2>::value_type
+	_ValueType2;
+      return __gnu_parallel::__inner_product_switch(__first1, __last1,
+						    __first2, __init,
+		 typename __truth_type<__are_same<_Tp, _ValueType1>::__value
+		 && __are_same<_Tp, _ValueType2>::__value
+		 && __is_arithmetic<_Tp>::__value>::__type());
+#else
       for (; __first1 != __last1; ++__first1, ++__first2)
 	__init = __init + (*__first1 * *__first2);
       return __init;
+#endif
     }
 
   /**
@@ -336,4 +358,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
 _GLIBCXX_END_NAMESPACE
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/numeric.h>
+#endif
+
 #endif /* _STL_NUMERIC_H */
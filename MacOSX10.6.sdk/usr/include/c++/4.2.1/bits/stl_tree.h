@@ -563,6 +563,15 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       void
       _M_erase(_Link_type __x);
 
+      // Erase every node, unless the nodes need neither destruction
+      // nor deallocation (see __alloc_skip_destroy).
+      void
+      _M_erase_all()
+      {
+	if (!std::__alloc_skip_destroy<_Node_allocator, _Val>::__value)
+	  _M_erase(_M_begin());
+      }
+
     public:
       // allocation/deallocation
       _Rb_tree()
@@ -589,7 +598,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       }
 
       ~_Rb_tree()
-      { _M_erase(_M_begin()); }
+      { _M_erase_all(); }
 
       _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>&
       operator=(const _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>& __x);
@@ -708,7 +717,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       void
       clear()
       {
-        _M_erase(_M_begin());
+        _M_erase_all();
         _M_leftmost() = _M_end();
         _M_root() = 0;
         _M_rightmost() = _M_end();
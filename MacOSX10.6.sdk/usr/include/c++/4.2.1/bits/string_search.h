@@ -0,0 +1,348 @@
+// String search primitives -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file string_search.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+//
+// ISO C++ 14882: 21.3.6  basic_string string operations
+//
+
+#ifndef _STRING_SEARCH_H
+#define _STRING_SEARCH_H 1
+
+#pragma GCC system_header
+
+#include <bits/char_traits.h>
+#include <bits/stl_iterator.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(std)
+
+  // Helpers shared by basic_string and __versa_string.  All of the
+  // per-character work is funnelled through _Traits::find and
+  // _Traits::compare, which for char_traits<char> are memchr and
+  // memcmp: the system library already provides vector implementations
+  // of those selected for the running processor (SSE2/SSSE3/SSE4.2 or
+  // AltiVec), so the searches below inherit them without this header
+  // having to depend on a particular instruction set.
+
+  // The two-way helpers take any random access iterator over the
+  // characters, so that __rsearch_string can run them on reversed
+  // ranges.
+
+  // Maximal suffix of __x[0, __m) under the order of _Traits::lt, or of
+  // its reverse when __rev, for the critical factorization of the
+  // two-way algorithm.  Returns the start of the suffix minus one and
+  // stores its period in __per.
+  template<typename _Traits, typename _Iter>
+    size_t
+    __maximal_suffix(_Iter __x, size_t __m, size_t& __per, bool __rev)
+    {
+      size_t __i = size_t(-1);
+      size_t __j = 0;
+      size_t __k = 1;
+      __per = 1;
+      while (__j + __k < __m)
+	{
+	  const typename _Traits::char_type __a = __x[__i + __k];
+	  const typename _Traits::char_type __b = __x[__j + __k];
+	  if (_Traits::eq(__a, __b))
+	    {
+	      if (__k == __per)
+		{
+		  __j += __per;
+		  __k = 1;
+		}
+	      else
+		++__k;
+	    }
+	  else if (__rev ? _Traits::lt(__a, __b) : _Traits::lt(__b, __a))
+	    {
+	      __j += __k;
+	      __k = 1;
+	      __per = __j - __i;
+	    }
+	  else
+	    {
+	      __i = __j++;
+	      __k = __per = 1;
+	    }
+	}
+      return __i;
+    }
+
+  // Crochemore-Perrin two-way search: linear in __len + __n, constant
+  // extra space.  Returns __h + __len if there is no match.  Requires
+  // 0 < __n.
+  template<typename _Traits, typename _Iter>
+    _Iter
+    __two_way_search(_Iter __h, size_t __len, _Iter __s, size_t __n)
+    {
+      size_t __per;
+      size_t __per_rev;
+      size_t __ms = std::__maximal_suffix<_Traits>(__s, __n, __per, false);
+      const size_t __ms_rev = std::__maximal_suffix<_Traits>(__s, __n,
+							     __per_rev, true);
+      if (__ms_rev + 1 > __ms + 1)
+	{
+	  __ms = __ms_rev;
+	  __per = __per_rev;
+	}
+
+      size_t __k = 0;
+      while (__k < __ms + 1 && _Traits::eq(__s[__k], __s[__k + __per]))
+	++__k;
+
+      size_t __mem0;
+      if (__k < __ms + 1)
+	{
+	  // Not periodic: no memory of the previous match is kept.
+	  __mem0 = 0;
+	  __per = (__ms > __n - __ms - 1 ? __ms : __n - __ms - 1) + 1;
+	}
+      else
+	__mem0 = __n - __per;
+
+      const _Iter __end = __h + __len;
+      size_t __mem = 0;
+      while (size_t(__end - __h) >= __n)
+	{
+	  // Right half first, then the left half down to __mem.
+	  __k = __ms + 1 > __mem ? __ms + 1 : __mem;
+	  while (__k < __n && _Traits::eq(__s[__k], __h[__k]))
+	    ++__k;
+	  if (__k < __n)
+	    {
+	      __h += __k - __ms;
+	      __mem = 0;
+	      continue;
+	    }
+	  __k = __ms + 1;
+	  while (__k > __mem && _Traits::eq(__s[__k - 1], __h[__k - 1]))
+	    --__k;
+	  if (__k <= __mem)
+	    return __h;
+	  __h += __per;
+	  __mem = __mem0;
+	}
+      return __end;
+    }
+
+  /**
+   *  @if maint
+   *  Finds the first occurrence of __s[0, __n) in __h[0, __len), or
+   *  returns 0.  Candidates are located with _Traits::find on the
+   *  first character and filtered on the last one before the middle is
+   *  compared; when the candidates turn out to be dense the search
+   *  switches to the two-way algorithm, so the worst case stays linear.
+   *  @endif
+   */
+  template<typename _Traits>
+    const typename _Traits::char_type*
+    __search_string(const typename _Traits::char_type* __h, size_t __len,
+		    const typename _Traits::char_type* __s, size_t __n)
+    {
+      if (__n == 0)
+	return __h;
+      if (__n > __len)
+	return 0;
+      if (__n == 1)
+	return _Traits::find(__h, __len, __s[0]);
+
+      typedef typename _Traits::char_type _CharT;
+      const _CharT* const __first = __h;
+      const _CharT* const __last = __h + (__len - __n) + 1;
+      size_t __cost = 0;
+      while (__h < __last)
+	{
+	  __h = _Traits::find(__h, __last - __h, __s[0]);
+	  if (!__h)
+	    return 0;
+	  if (_Traits::eq(__h[__n - 1], __s[__n - 1]))
+	    {
+	      if (_Traits::compare(__h + 1, __s + 1, __n - 2) == 0)
+		return __h;
+	      __cost += __n;
+	      if (__cost > 4 * size_t(__h - __first) + 256)
+		{
+		  const _CharT* const __end = __first + __len;
+		  __h = std::__two_way_search<_Traits>(__h, __end - __h,
+						       __s, __n);
+		  return __h != __end ? __h : 0;
+		}
+	    }
+	  ++__h;
+	}
+      return 0;
+    }
+
+  /**
+   *  @if maint
+   *  Finds the last occurrence of __s[0, __n) in __h[0, __len), or
+   *  returns 0.  Candidates are tried from the end and filtered on
+   *  their first and last characters before the middle is compared;
+   *  when they turn out to be dense the rest of the range is searched
+   *  by the two-way algorithm on the reversed text and pattern, so the
+   *  worst case stays linear.  Requires 0 < __n.
+   *  @endif
+   */
+  template<typename _Traits>
+    const typename _Traits::char_type*
+    __rsearch_string(const typename _Traits::char_type* __h, size_t __len,
+		     const typename _Traits::char_type* __s, size_t __n)
+    {
+      if (__n > __len)
+	return 0;
+
+      typedef typename _Traits::char_type _CharT;
+      typedef std::reverse_iterator<const _CharT*> _Rev;
+      const _CharT* const __last = __h + (__len - __n);
+      const _CharT* __p = __last + 1;
+      size_t __cost = 0;
+      while (__p != __h)
+	{
+	  --__p;
+	  if (_Traits::eq(__p[0], __s[0])
+	      && _Traits::eq(__p[__n - 1], __s[__n - 1]))
+	    {
+	      if (__n <= 2
+		  || _Traits::compare(__p + 1, __s + 1, __n - 2) == 0)
+		return __p;
+	      __cost += __n;
+	      if (__cost > 4 * size_t(__last - __p) + 256)
+		{
+		  // Matches left start before __p, so end before
+		  // __p + __n - 1.  The first match in the reversed text
+		  // is the last one in the original.
+		  const size_t __rlen = (__p + __n - 1) - __h;
+		  const _Rev __rh(__p + __n - 1);
+		  const _Rev __r = std::__two_way_search<_Traits>(__rh, __rlen,
+								  _Rev(__s + __n),
+								  __n);
+		  return __r != __rh + __rlen ? __r.base() - __n : 0;
+		}
+	    }
+	}
+      return 0;
+    }
+
+  /**
+   *  @if maint
+   *  Scans [__first, __last) forwards (_S_find) or backwards (_S_rfind)
+   *  for the first character whose membership in the set __s[0, __n)
+   *  equals __in, returning 0 if there is none.  The generic version
+   *  searches the set with _Traits::find for every character; the
+   *  char_traits<char> specialization builds a 256-bit membership map
+   *  once, so each character costs one load instead of a scan of the
+   *  set.
+   *  @endif
+   */
+  template<typename _Traits>
+    struct __char_set_search
+    {
+      typedef typename _Traits::char_type char_type;
+
+      static const char_type*
+      _S_find(const char_type* __first, const char_type* __last,
+	      const char_type* __s, size_t __n, bool __in)
+      {
+	for (; __first != __last; ++__first)
+	  if (bool(_Traits::find(__s, __n, *__first)) == __in)
+	    return __first;
+	return 0;
+      }
+
+      static const char_type*
+      _S_rfind(const char_type* __first, const char_type* __last,
+	       const char_type* __s, size_t __n, bool __in)
+      {
+	while (__last != __first)
+	  if (bool(_Traits::find(__s, __n, *--__last)) == __in)
+	    return __last;
+	return 0;
+      }
+    };
+
+  template<>
+    struct __char_set_search<char_traits<char> >
+    {
+      typedef char char_type;
+
+      static const char*
+      _S_find(const char* __first, const char* __last,
+	      const char* __s, size_t __n, bool __in)
+      {
+	if (__n == 1 && __in)
+	  return char_traits<char>::find(__first, __last - __first, __s[0]);
+
+	unsigned char __map[32];
+	_S_build(__map, __s, __n);
+	for (; __first != __last; ++__first)
+	  if (_S_test(__map, *__first) == __in)
+	    return __first;
+	return 0;
+      }
+
+      static const char*
+      _S_rfind(const char* __first, const char* __last,
+	       const char* __s, size_t __n, bool __in)
+      {
+	unsigned char __map[32];
+	_S_build(__map, __s, __n);
+	while (__last != __first)
+	  if (_S_test(__map, *--__last) == __in)
+	    return __last;
+	return 0;
+      }
+
+    private:
+      static void
+      _S_build(unsigned char* __map, const char* __s, size_t __n)
+      {
+	__builtin_memset(__map, 0, 32);
+	for (; __n; --__n, ++__s)
+	  {
+	    const unsigned char __c = static_cast<unsigned char>(*__s);
+	    __map[__c >> 3] |= static_cast<unsigned char>(1 << (__c & 7));
+	  }
+      }
+
+      static bool
+      _S_test(const unsigned char* __map, char __ch)
+      {
+	const unsigned char __c = static_cast<unsigned char>(__ch);
+	return __map[__c >> 3] & (1 << (__c & 7));
+      }
+    };
+
+_GLIBCXX_END_NAMESPACE
+
+#endif /* _STRING_SEARCH_H */
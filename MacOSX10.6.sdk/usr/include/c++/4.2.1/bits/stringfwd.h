@@ -51,9 +51,18 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   template<class _CharT>
     struct char_traits;
 
+#if _GLIBCXX_NAMESPACE_ASSOCIATION_SSO
+  namespace __sso
+  {
+    template<typename _CharT, typename _Traits = char_traits<_CharT>,
+             typename _Alloc = allocator<_CharT> >
+      class basic_string;
+  }
+#else
   template<typename _CharT, typename _Traits = char_traits<_CharT>,
            typename _Alloc = allocator<_CharT> >
     class basic_string;
+#endif
 
   template<> struct char_traits<char>;
 
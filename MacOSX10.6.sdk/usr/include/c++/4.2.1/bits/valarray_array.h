@@ -46,6 +46,10 @@
 #include <cstring>
 #include <new>
 
+#ifdef _GLIBCXX_VALARRAY_VDSP
+# include <vecLib/vDSP.h>
+#endif
+
 _GLIBCXX_BEGIN_NAMESPACE(std)
 
   //
@@ -70,6 +74,418 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   __valarray_release_memory(void* __p)
   { operator delete(__p); }
 
+  //
+  // Packet (SIMD) evaluation support.
+  //
+  // The storage above comes from operator new, which on this platform
+  // hands out blocks aligned for the widest vector type, so the
+  // elements of every valarray start on a 16-byte boundary.  The
+  // kernels below still check that at run time and leave unaligned
+  // operands (a replaced operator new, or a pointer into the middle
+  // of some other array) to the ordinary scalar loops.
+  //
+
+  // __valarray_packet<_Tp> describes the vector register used to
+  // process several _Tp at once.  __value is false for types with no
+  // packet support, in which case __width is 1 and nothing else is
+  // provided.
+  template<typename _Tp>
+    struct __valarray_packet
+    {
+      enum { __value = 0, __width = 1 };
+      typedef _Tp __type;
+    };
+
+#if defined(__SSE2__) || defined(__ALTIVEC__)
+  template<>
+    struct __valarray_packet<float>
+    {
+      enum { __value = 1, __width = 4 };
+      typedef float __type __attribute__((__vector_size__(16)));
+
+      static bool
+      _S_aligned(const void* __p)
+      { return (reinterpret_cast<size_t>(__p) & 15) == 0; }
+
+      static __type
+      _S_load(const float* __p)
+      { return *reinterpret_cast<const __type*>(__p); }
+
+      static void
+      _S_store(float* __p, __type __x)
+      { *reinterpret_cast<__type*>(__p) = __x; }
+
+      static __type
+      _S_splat(float __t)
+      {
+	union { __type __v; float __f[__width]; } __u;
+	__u.__f[0] = __u.__f[1] = __u.__f[2] = __u.__f[3] = __t;
+	return __u.__v;
+      }
+    };
+#endif
+
+#if defined(__SSE2__)
+  template<>
+    struct __valarray_packet<double>
+    {
+      enum { __value = 1, __width = 2 };
+      typedef double __type __attribute__((__vector_size__(16)));
+
+      static bool
+      _S_aligned(const void* __p)
+      { return (reinterpret_cast<size_t>(__p) & 15) == 0; }
+
+      static __type
+      _S_load(const double* __p)
+      { return *reinterpret_cast<const __type*>(__p); }
+
+      static void
+      _S_store(double* __p, __type __x)
+      { *reinterpret_cast<__type*>(__p) = __x; }
+
+      static __type
+      _S_splat(double __t)
+      {
+	union { __type __v; double __f[__width]; } __u;
+	__u.__f[0] = __u.__f[1] = __t;
+	return __u.__v;
+      }
+    };
+#endif
+
+  // The function objects of valarray_before.h used to name the
+  // operation in the computed assignments at the end of this file.
+  struct __unary_plus;
+  struct __negate;
+  struct __plus;
+  struct __minus;
+  struct __multiplies;
+  struct __divides;
+  struct __modulus;
+  struct __bitwise_xor;
+  struct __bitwise_or;
+  struct __bitwise_and;
+  struct __shift_left;
+  struct __shift_right;
+
+  // __valarray_simd_op<_Oper> is specialized for the operations above
+  // that have an exact lane-wise counterpart on packets.  Everything
+  // else (%, the bitwise and logical operators, comparisons, the
+  // <cmath> functions) keeps going through operator[] one element at
+  // a time.
+
+  template<class _Oper>
+    struct __valarray_simd_op
+    { enum { __value = 0 }; };
+
+  template<>
+    struct __valarray_simd_op<__unary_plus>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x)
+        { return __x; }
+    };
+
+  template<>
+    struct __valarray_simd_op<__negate>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x)
+        { return -__x; }
+    };
+
+  // With _GLIBCXX_VALARRAY_VDSP defined, computed assignments of a
+  // whole float or double valarray (v op= w, v op= t) of at least
+  // _GLIBCXX_VALARRAY_VDSP_THRESHOLD elements are handed to vDSP;
+  // the program must then be linked with the Accelerate framework.
+#ifdef _GLIBCXX_VALARRAY_VDSP
+# ifndef _GLIBCXX_VALARRAY_VDSP_THRESHOLD
+#  define _GLIBCXX_VALARRAY_VDSP_THRESHOLD 512
+# endif
+#endif
+
+  template<>
+    struct __valarray_simd_op<__plus>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x, _Vp __y)
+        { return __x + __y; }
+
+#ifdef _GLIBCXX_VALARRAY_VDSP
+      static void
+      _S_vdsp(float* __r, const float* __a, const float* __b, size_t __n)
+      { vDSP_vadd(__a, 1, __b, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, const double* __b, size_t __n)
+      { vDSP_vaddD(__a, 1, __b, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(float* __r, const float* __a, float __t, size_t __n)
+      { vDSP_vsadd(const_cast<float*>(__a), 1, &__t, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, double __t, size_t __n)
+      { vDSP_vsaddD(const_cast<double*>(__a), 1, &__t, __r, 1, __n); }
+#endif
+    };
+
+  template<>
+    struct __valarray_simd_op<__minus>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x, _Vp __y)
+        { return __x - __y; }
+
+#ifdef _GLIBCXX_VALARRAY_VDSP
+      // NB: vDSP_vsub computes its second operand minus its first.
+      static void
+      _S_vdsp(float* __r, const float* __a, const float* __b, size_t __n)
+      { vDSP_vsub(__b, 1, __a, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, const double* __b, size_t __n)
+      { vDSP_vsubD(__b, 1, __a, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(float* __r, const float* __a, float __t, size_t __n)
+      {
+	__t = -__t;
+	vDSP_vsadd(const_cast<float*>(__a), 1, &__t, __r, 1, __n);
+      }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, double __t, size_t __n)
+      {
+	__t = -__t;
+	vDSP_vsaddD(const_cast<double*>(__a), 1, &__t, __r, 1, __n);
+      }
+#endif
+    };
+
+  template<>
+    struct __valarray_simd_op<__multiplies>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x, _Vp __y)
+        { return __x * __y; }
+
+#ifdef _GLIBCXX_VALARRAY_VDSP
+      static void
+      _S_vdsp(float* __r, const float* __a, const float* __b, size_t __n)
+      { vDSP_vmul(__a, 1, __b, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, const double* __b, size_t __n)
+      { vDSP_vmulD(__a, 1, __b, 1, __r, 1, __n); }
+
+      static void
+      _S_vdsp(float* __r, const float* __a, float __t, size_t __n)
+      { vDSP_vsmul(__a, 1, &__t, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, double __t, size_t __n)
+      { vDSP_vsmulD(__a, 1, &__t, __r, 1, __n); }
+#endif
+    };
+
+  template<>
+    struct __valarray_simd_op<__divides>
+    {
+      enum { __value = 1 };
+
+      template<typename _Vp>
+        static _Vp
+        _S_apply(_Vp __x, _Vp __y)
+        { return __x / __y; }
+
+#ifdef _GLIBCXX_VALARRAY_VDSP
+      // NB: vDSP_vdiv divides its second operand by its first.
+      static void
+      _S_vdsp(float* __r, const float* __a, const float* __b, size_t __n)
+      {
+	vDSP_vdiv(const_cast<float*>(__b), 1, const_cast<float*>(__a), 1,
+		  __r, 1, __n);
+      }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, const double* __b, size_t __n)
+      {
+	vDSP_vdivD(const_cast<double*>(__b), 1, const_cast<double*>(__a), 1,
+		   __r, 1, __n);
+      }
+
+      static void
+      _S_vdsp(float* __r, const float* __a, float __t, size_t __n)
+      { vDSP_vsdiv(const_cast<float*>(__a), 1, &__t, __r, 1, __n); }
+
+      static void
+      _S_vdsp(double* __r, const double* __a, double __t, size_t __n)
+      { vDSP_vsdivD(const_cast<double*>(__a), 1, &__t, __r, 1, __n); }
+#endif
+    };
+
+  // __valarray_simd_expr<_Dom>::__value is true when every node of
+  // the expression closure _Dom is a __valarray_simd_op applied to
+  // valarrays, constants or other such closures of a packet type.
+  // The partial specializations live in valarray_before.h.
+  template<class _Dom>
+    struct __valarray_simd_expr
+    { enum { __value = 0 }; };
+
+  // Packet sources wrapping a plain array and a scalar, so that the
+  // kernels see them through the same interface as an expression
+  // closure: _M_packet(__i) and _M_simd_aligned().
+  template<typename _Tp>
+    struct __valarray_simd_array
+    {
+      typedef __valarray_packet<_Tp> _Packet;
+
+      explicit
+      __valarray_simd_array(const _Tp* __p) : _M_data(__p) {}
+
+      typename _Packet::__type
+      _M_packet(size_t __i) const
+      { return _Packet::_S_load(_M_data + __i); }
+
+      bool
+      _M_simd_aligned() const
+      { return _Packet::_S_aligned(_M_data); }
+
+      const _Tp* _M_data;
+    };
+
+  template<typename _Tp>
+    struct __valarray_simd_scalar
+    {
+      typedef __valarray_packet<_Tp> _Packet;
+
+      explicit
+      __valarray_simd_scalar(const _Tp& __t)
+      : _M_value(_Packet::_S_splat(__t)) {}
+
+      typename _Packet::__type
+      _M_packet(size_t) const
+      { return _M_value; }
+
+      bool
+      _M_simd_aligned() const
+      { return true; }
+
+      typename _Packet::__type _M_value;
+    };
+
+  // The packet kernels proper.  Each processes the longest prefix of
+  // [0, __n) that is a multiple of the packet width and returns its
+  // length; the caller finishes the remaining elements with its
+  // scalar loop.  The primary template is selected whenever packet
+  // evaluation does not apply, and processes nothing.
+  template<typename _Tp, bool>
+    struct __valarray_simd_eval
+    {
+      template<class _Src>
+        static size_t
+        _S_copy(_Tp*, const _Src&, size_t)
+        { return 0; }
+
+      template<class _Oper, class _Src>
+        static size_t
+        _S_augment(_Tp*, const _Src&, size_t)
+        { return 0; }
+
+      template<class _Oper>
+        static size_t
+        _S_augment_array(_Tp*, const _Tp*, size_t)
+        { return 0; }
+
+      template<class _Oper>
+        static size_t
+        _S_augment_scalar(_Tp*, const _Tp&, size_t)
+        { return 0; }
+    };
+
+  template<typename _Tp>
+    struct __valarray_simd_eval<_Tp, true>
+    {
+      typedef __valarray_packet<_Tp> _Packet;
+
+      // __p[__i] = __s[__i]
+      template<class _Src>
+        static size_t
+        _S_copy(_Tp* __p, const _Src& __s, size_t __n)
+        {
+	  if (__n < size_t(_Packet::__width) || !_Packet::_S_aligned(__p)
+	      || !__s._M_simd_aligned())
+	    return 0;
+
+	  const size_t __m = __n - __n % _Packet::__width;
+	  for (size_t __i = 0; __i < __m; __i += _Packet::__width)
+	    _Packet::_S_store(__p + __i, __s._M_packet(__i));
+	  return __m;
+	}
+
+      // __p[__i] = _Oper(__p[__i], __s[__i])
+      template<class _Oper, class _Src>
+        static size_t
+        _S_augment(_Tp* __p, const _Src& __s, size_t __n)
+        {
+	  if (__n < size_t(_Packet::__width) || !_Packet::_S_aligned(__p)
+	      || !__s._M_simd_aligned())
+	    return 0;
+
+	  const size_t __m = __n - __n % _Packet::__width;
+	  for (size_t __i = 0; __i < __m; __i += _Packet::__width)
+	    _Packet::_S_store(__p + __i, __valarray_simd_op<_Oper>::
+			      _S_apply(_Packet::_S_load(__p + __i),
+				       __s._M_packet(__i)));
+	  return __m;
+	}
+
+      template<class _Oper>
+        static size_t
+        _S_augment_array(_Tp* __p, const _Tp* __q, size_t __n)
+        {
+#ifdef _GLIBCXX_VALARRAY_VDSP
+	  if (__n >= _GLIBCXX_VALARRAY_VDSP_THRESHOLD)
+	    {
+	      __valarray_simd_op<_Oper>::_S_vdsp(__p, __p, __q, __n);
+	      return __n;
+	    }
+#endif
+	  return _S_augment<_Oper>(__p, __valarray_simd_array<_Tp>(__q), __n);
+	}
+
+      template<class _Oper>
+        static size_t
+        _S_augment_scalar(_Tp* __p, const _Tp& __t, size_t __n)
+        {
+#ifdef _GLIBCXX_VALARRAY_VDSP
+	  if (__n >= _GLIBCXX_VALARRAY_VDSP_THRESHOLD)
+	    {
+	      __valarray_simd_op<_Oper>::_S_vdsp(__p, __p, __t, __n);
+	      return __n;
+	    }
+#endif
+	  return _S_augment<_Oper>(__p, __valarray_simd_scalar<_Tp>(__t), __n);
+	}
+    };
+
   // Turn a raw-memory into an array of _Tp filled with _Tp()
   // This is required in 'valarray<T> v(n);'
   template<typename _Tp, bool>
@@ -539,7 +955,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, const _Tp& __t) \
     {									\
-      for (_Tp* __p = __a._M_data; __p < __a._M_data + __n; ++__p)	\
+      _Tp* __p = __a._M_data + __valarray_simd_eval<_Tp,		\
+	(__valarray_simd_op<_Name>::__value				\
+	 && __valarray_packet<_Tp>::__value)>::template			\
+	_S_augment_scalar<_Name>(__a._M_data, __t, __n);		\
+      for (; __p < __a._M_data + __n; ++__p)				\
         *__p _Op##= __t;						\
     }									\
 									\
@@ -547,8 +967,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, _Array<_Tp> __b) \
     {									\
-      _Tp* __p = __a._M_data;						\
-      for (_Tp* __q = __b._M_data; __q < __b._M_data + __n; ++__p, ++__q) \
+      const size_t __m = __valarray_simd_eval<_Tp,			\
+	(__valarray_simd_op<_Name>::__value				\
+	 && __valarray_packet<_Tp>::__value)>::template			\
+	_S_augment_array<_Name>(__a._M_data, __b._M_data, __n);		\
+      _Tp* __p = __a._M_data + __m;					\
+      for (_Tp* __q = __b._M_data + __m; __q < __b._M_data + __n;	\
+	   ++__p, ++__q)						\
         *__p _Op##= *__q;						\
     }									\
 									\
@@ -557,8 +982,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array_augmented_##_Name(_Array<_Tp> __a,	        		\
                              const _Expr<_Dom, _Tp>& __e, size_t __n)	\
     {									\
-      _Tp* __p(__a._M_data);						\
-      for (size_t __i = 0; __i < __n; ++__i, ++__p)                     \
+      size_t __i = __valarray_simd_eval<_Tp,				\
+	(__valarray_simd_op<_Name>::__value				\
+	 && __valarray_simd_expr<_Dom>::__value)>::template		\
+	_S_augment<_Name>(__a._M_data, __e(), __n);			\
+      _Tp* __p(__a._M_data + __i);					\
+      for (; __i < __n; ++__i, ++__p)					\
         *__p _Op##= __e[__i];                                          	\
     }									\
 									\
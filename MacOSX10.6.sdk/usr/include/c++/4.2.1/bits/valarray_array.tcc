@@ -144,8 +144,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     void
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n, _Array<_Tp> __a)
     {
-      _Tp* __p (__a._M_data);
-      for (size_t __i = 0; __i < __n; ++__i, ++__p)
+      size_t __i = __valarray_simd_eval<_Tp, __valarray_simd_expr<_Dom>::
+	__value>::_S_copy(__a._M_data, __e(), __n);
+      _Tp* __p (__a._M_data + __i);
+      for (; __i < __n; ++__i, ++__p)
 	*__p = __e[__i];
     }
 
@@ -217,8 +219,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy_construct(const _Expr<_Dom, _Tp>& __e, size_t __n,
 			      _Array<_Tp> __a)
     {
-      _Tp* __p (__a._M_data);
-      for (size_t __i = 0; __i < __n; ++__i, ++__p)
+      size_t __i = __valarray_simd_eval<_Tp, __valarray_simd_expr<_Dom>::
+	__value>::_S_copy(__a._M_data, __e(), __n);
+      _Tp* __p (__a._M_data + __i);
+      for (; __i < __n; ++__i, ++__p)
 	new (__p) _Tp(__e[__i]);
     }
 
@@ -464,6 +464,32 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       : _Base(__v, __f) {}
     };
 
+  //
+  // Packet access to the operands of the closures below.  An operand
+  // is either a valarray, read straight from its storage, or another
+  // closure, which computes the packet itself.
+  //
+
+  template<class _Clos>
+    inline typename __valarray_packet<typename _Clos::value_type>::__type
+    __valarray_packet_at(const _Clos& __e, size_t __i)
+    { return __e._M_packet(__i); }
+
+  template<typename _Tp>
+    inline typename __valarray_packet<_Tp>::__type
+    __valarray_packet_at(const valarray<_Tp>& __v, size_t __i)
+    { return __valarray_packet<_Tp>::_S_load(&__v[__i]); }
+
+  template<class _Clos>
+    inline bool
+    __valarray_simd_aligned(const _Clos& __e)
+    { return __e._M_simd_aligned(); }
+
+  template<typename _Tp>
+    inline bool
+    __valarray_simd_aligned(const valarray<_Tp>& __v)
+    { return __valarray_packet<_Tp>::_S_aligned(&__v[0]); }
+
   //
   // Unary expression closure.
   //
@@ -481,6 +507,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       { return _Oper()(_M_expr[__i]); }
 
       size_t size() const { return _M_expr.size(); }
+
+      typename __valarray_packet<value_type>::__type
+      _M_packet(size_t __i) const
+      {
+	return __valarray_simd_op<_Oper>::
+	  _S_apply(std::__valarray_packet_at(_M_expr, __i));
+      }
+
+      bool _M_simd_aligned() const
+      { return std::__valarray_simd_aligned(_M_expr); }
       
     private:
       const _Arg& _M_expr;
@@ -528,6 +564,20 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
       size_t size() const { return _M_expr1.size(); }
 
+      typename __valarray_packet<value_type>::__type
+      _M_packet(size_t __i) const
+      {
+	return __valarray_simd_op<_Oper>::
+	  _S_apply(std::__valarray_packet_at(_M_expr1, __i),
+		   std::__valarray_packet_at(_M_expr2, __i));
+      }
+
+      bool _M_simd_aligned() const
+      {
+	return (std::__valarray_simd_aligned(_M_expr1)
+		&& std::__valarray_simd_aligned(_M_expr2));
+      }
+
     private:
       const _FirstArg& _M_expr1;
       const _SecondArg& _M_expr2;
@@ -549,6 +599,17 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
       size_t size() const { return _M_expr1.size(); }
 
+      typename __valarray_packet<value_type>::__type
+      _M_packet(size_t __i) const
+      {
+	return __valarray_simd_op<_Oper>::
+	  _S_apply(std::__valarray_packet_at(_M_expr1, __i),
+		   __valarray_packet<_Vt>::_S_splat(_M_expr2));
+      }
+
+      bool _M_simd_aligned() const
+      { return std::__valarray_simd_aligned(_M_expr1); }
+
     private:
       const _Clos& _M_expr1;
       const _Vt& _M_expr2;
@@ -569,6 +630,17 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
       size_t size() const { return _M_expr2.size(); }
 
+      typename __valarray_packet<value_type>::__type
+      _M_packet(size_t __i) const
+      {
+	return __valarray_simd_op<_Oper>::
+	  _S_apply(__valarray_packet<_Vt>::_S_splat(_M_expr1),
+		   std::__valarray_packet_at(_M_expr2, __i));
+      }
+
+      bool _M_simd_aligned() const
+      { return std::__valarray_simd_aligned(_M_expr2); }
+
     private:
       const _Vt& _M_expr1;
       const _Clos& _M_expr2;
@@ -661,6 +733,44 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       _BinClos(const _Tp& __t, const valarray<_Tp>& __v) : _Base(__t, __v) {}
     };
 
+  //
+  // Which closures __valarray_simd_eval may evaluate a packet at a
+  // time: see valarray_array.h.
+  //
+
+  template<template<class, class> class _Meta, class _Dom>
+    struct __valarray_simd_arg;
+
+  template<class _Dom>
+    struct __valarray_simd_arg<_Expr, _Dom>
+    { enum { __value = __valarray_simd_expr<_Dom>::__value }; };
+
+  template<typename _Tp>
+    struct __valarray_simd_arg<_ValArray, _Tp>
+    { enum { __value = __valarray_packet<_Tp>::__value }; };
+
+  template<typename _Tp>
+    struct __valarray_simd_arg<_Constant, _Tp>
+    { enum { __value = __valarray_packet<_Tp>::__value }; };
+
+  template<class _Oper, template<class, class> class _Meta, class _Dom>
+    struct __valarray_simd_expr<_UnClos<_Oper, _Meta, _Dom> >
+    {
+      enum { __value = (__valarray_simd_op<_Oper>::__value
+			&& __valarray_simd_arg<_Meta, _Dom>::__value) };
+    };
+
+  template<class _Oper,
+	   template<class, class> class _Meta1,
+	   template<class, class> class _Meta2,
+	   class _Dom1, class _Dom2>
+    struct __valarray_simd_expr<_BinClos<_Oper, _Meta1, _Meta2, _Dom1, _Dom2> >
+    {
+      enum { __value = (__valarray_simd_op<_Oper>::__value
+			&& __valarray_simd_arg<_Meta1, _Dom1>::__value
+			&& __valarray_simd_arg<_Meta2, _Dom2>::__value) };
+    };
+
     //
     // slice_array closure.
     //
@@ -0,0 +1,340 @@
+// Arena allocator -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+
+/** @file ext/arena_allocator.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _ARENA_ALLOCATOR_H
+#define _ARENA_ALLOCATOR_H 1
+
+#include <cstddef>
+#include <new>
+#include <bits/functexcept.h>
+#include <bits/allocator.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  using std::size_t;
+  using std::ptrdiff_t;
+
+  /**
+   *  @brief  A region of memory handed out by bumping a pointer.
+   *
+   *  Memory is obtained from operator new in chunks of at least
+   *  chunk_size() bytes.  Individual blocks are never freed: the
+   *  whole arena is released at once by reset() or by the destructor,
+   *  and everything allocated since a given point can be released by
+   *  rewinding to a marker taken at that point (see arena_scope).
+   */
+  class arena
+  {
+    struct _Chunk
+    {
+      _Chunk*	_M_prev;
+      size_t	_M_size;
+    };
+
+  public:
+    typedef size_t	size_type;
+
+    /// A position in an arena, as returned by mark().
+    class marker
+    {
+      friend class arena;
+
+      _Chunk*	_M_chunk;
+      char*	_M_cur;
+
+      marker(_Chunk* __chunk, char* __cur)
+      : _M_chunk(__chunk), _M_cur(__cur) { }
+
+    public:
+      /// The position of an empty arena.
+      marker() : _M_chunk(0), _M_cur(0) { }
+    };
+
+    explicit
+    arena(size_type __chunk_size = 64 * 1024)
+    : _M_chunk(0), _M_spare(0), _M_cur(0), _M_end(0),
+      _M_chunk_size(__chunk_size) { }
+
+    ~arena()
+    { release(); }
+
+    /// Allocate __bytes bytes aligned on __align, a power of 2.
+    void*
+    allocate(size_type __bytes, size_type __align = __alignof__(long double))
+    {
+      size_type __pad = _S_padding(_M_cur, __align);
+      if (__builtin_expect(size_type(_M_end - _M_cur) < __bytes + __pad,
+			   false))
+	{
+	  _M_new_chunk(__bytes + __align);
+	  __pad = _S_padding(_M_cur, __align);
+	}
+      char* __p = _M_cur + __pad;
+      _M_cur = __p + __bytes;
+      return __p;
+    }
+
+    /// Blocks are only released together, this does nothing.
+    void
+    deallocate(void*, size_type) { }
+
+    marker
+    mark() const
+    { return marker(_M_chunk, _M_cur); }
+
+    /**
+     *  Release everything allocated since __m was taken.  Markers
+     *  taken after __m become invalid.  The most recently released
+     *  chunk is kept for reuse.
+     */
+    void
+    rewind(const marker& __m)
+    {
+      while (_M_chunk != __m._M_chunk)
+	{
+	  _Chunk* __c = _M_chunk;
+	  _M_chunk = __c->_M_prev;
+	  _M_keep_spare(__c);
+	}
+      _M_cur = __m._M_cur;
+      _M_end = _M_chunk ? _S_data(_M_chunk) + _M_chunk->_M_size : 0;
+    }
+
+    /// Release everything, keeping one chunk for reuse.
+    void
+    reset()
+    { rewind(marker()); }
+
+    /// Release everything and return all memory to operator delete.
+    void
+    release()
+    {
+      reset();
+      if (_M_spare)
+	{
+	  ::operator delete(_M_spare);
+	  _M_spare = 0;
+	}
+    }
+
+    size_type
+    chunk_size() const
+    { return _M_chunk_size; }
+
+  private:
+    arena(const arena&);
+
+    arena&
+    operator=(const arena&);
+
+    static char*
+    _S_data(_Chunk* __c)
+    { return reinterpret_cast<char*>(__c + 1); }
+
+    static size_type
+    _S_padding(const char* __p, size_type __align)
+    { return -reinterpret_cast<size_t>(__p) & (__align - 1); }
+
+    void
+    _M_keep_spare(_Chunk* __c)
+    {
+      if (_M_spare)
+	::operator delete(_M_spare);
+      _M_spare = __c;
+    }
+
+    void
+    _M_new_chunk(size_type __bytes)
+    {
+      _Chunk* __c;
+      if (_M_spare && _M_spare->_M_size >= __bytes)
+	{
+	  __c = _M_spare;
+	  _M_spare = 0;
+	}
+      else
+	{
+	  size_type __size = _M_chunk_size - sizeof(_Chunk);
+	  if (__size < __bytes)
+	    __size = __bytes;
+	  if (__size > size_type(-1) - sizeof(_Chunk))
+	    std::__throw_bad_alloc();
+	  __c = static_cast<_Chunk*>(::operator new(sizeof(_Chunk) + __size));
+	  __c->_M_size = __size;
+	}
+      __c->_M_prev = _M_chunk;
+      _M_chunk = __c;
+      _M_cur = _S_data(__c);
+      _M_end = _M_cur + __c->_M_size;
+    }
+
+    _Chunk*	_M_chunk;
+    _Chunk*	_M_spare;
+    char*	_M_cur;
+    char*	_M_end;
+    size_type	_M_chunk_size;
+  };
+
+  /**
+   *  @brief  Rewinds an arena, on destruction, to where it was on
+   *  construction.
+   *
+   *  Containers allocating from the arena within the scope must be
+   *  destroyed before it ends, i.e. declared after the arena_scope.
+   */
+  class arena_scope
+  {
+  public:
+    explicit
+    arena_scope(arena& __a)
+    : _M_arena(__a), _M_mark(__a.mark()) { }
+
+    ~arena_scope()
+    { _M_arena.rewind(_M_mark); }
+
+  private:
+    arena_scope(const arena_scope&);
+
+    arena_scope&
+    operator=(const arena_scope&);
+
+    arena&		_M_arena;
+    arena::marker	_M_mark;
+  };
+
+  /**
+   *  @brief  An allocator that takes its memory from an arena.
+   *
+   *  deallocate does nothing; memory comes back when the arena is
+   *  rewound or reset.  Node-based containers (list, map, set and
+   *  their multi variants) using this allocator with elements that
+   *  need no destruction skip walking their nodes on clear() and on
+   *  destruction altogether.
+   *
+   *  The arena has to be given to the container explicitly.  A
+   *  default constructed arena_allocator (which basic_string needs to
+   *  exist) has no arena and throws bad_alloc from allocate.
+   */
+  template<typename _Tp>
+    class arena_allocator
+    {
+    public:
+      typedef size_t     	size_type;
+      typedef ptrdiff_t  	difference_type;
+      typedef _Tp*       	pointer;
+      typedef const _Tp* 	const_pointer;
+      typedef _Tp&       	reference;
+      typedef const _Tp&	const_reference;
+      typedef _Tp        	value_type;
+
+      template<typename _Tp1>
+        struct rebind
+        { typedef arena_allocator<_Tp1> other; };
+
+      arena_allocator() throw()
+      : _M_arena(0) { }
+
+      explicit
+      arena_allocator(arena& __a) throw()
+      : _M_arena(&__a) { }
+
+      arena_allocator(const arena_allocator& __a) throw()
+      : _M_arena(__a._M_arena) { }
+
+      template<typename _Tp1>
+        arena_allocator(const arena_allocator<_Tp1>& __a) throw()
+	: _M_arena(__a._M_get_arena()) { }
+
+      ~arena_allocator() throw() { }
+
+      pointer
+      address(reference __x) const { return &__x; }
+
+      const_pointer
+      address(const_reference __x) const { return &__x; }
+
+      pointer
+      allocate(size_type __n, const void* = 0)
+      {
+	if (__builtin_expect(__n > this->max_size() || !_M_arena, false))
+	  std::__throw_bad_alloc();
+	return static_cast<_Tp*>(_M_arena->allocate(__n * sizeof(_Tp),
+						    __alignof__(_Tp)));
+      }
+
+      void
+      deallocate(pointer, size_type) { }
+
+      size_type
+      max_size() const throw() 
+      { return size_t(-1) / sizeof(_Tp); }
+
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 402. wrong new expression in [some_] allocator::construct
+      void 
+      construct(pointer __p, const _Tp& __val) 
+      { ::new(__p) _Tp(__val); }
+
+      void 
+      destroy(pointer __p) { __p->~_Tp(); }
+
+      arena*
+      _M_get_arena() const
+      { return _M_arena; }
+
+    private:
+      arena*	_M_arena;
+    };
+
+  template<typename _Tp>
+    inline bool
+    operator==(const arena_allocator<_Tp>& __a, const arena_allocator<_Tp>& __b)
+    { return __a._M_get_arena() == __b._M_get_arena(); }
+  
+  template<typename _Tp>
+    inline bool
+    operator!=(const arena_allocator<_Tp>& __a, const arena_allocator<_Tp>& __b)
+    { return __a._M_get_arena() != __b._M_get_arena(); }
+
+_GLIBCXX_END_NAMESPACE
+
+_GLIBCXX_BEGIN_NAMESPACE(std)
+
+  template<typename _Tp>
+    struct __alloc_noop_deallocate<__gnu_cxx::arena_allocator<_Tp> >
+    { enum { __value = 1 }; };
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
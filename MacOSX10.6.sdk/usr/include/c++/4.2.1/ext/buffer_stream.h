@@ -0,0 +1,585 @@
+// Streams over caller buffers and reusable arenas -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+
+/** @file ext/buffer_stream.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _BUFFER_STREAM_H
+#define _BUFFER_STREAM_H 1
+
+#pragma GCC system_header
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <memory>
+#include <climits>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  /**
+   *  @brief Output buffer over caller memory or a reusable arena.
+   *
+   *  This GNU extension is an output-only alternative to
+   *  std::basic_stringbuf for formatting many short messages.  It
+   *  writes either into a fixed array supplied by the caller, which it
+   *  never reallocates, or into an arena of its own that grows
+   *  geometrically and is kept across reset(), so that a buffer reused
+   *  for every message stops allocating once it has seen the longest
+   *  one.  The characters written are available in place through
+   *  data() and size(); they are not null-terminated.
+   *
+   *  When a caller-supplied array is full, further output fails and
+   *  the stream sets badbit; data() and size() then hold what fit.
+   *  Seeking is supported within what has been written, as with
+   *  basic_stringbuf.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT>,
+	   typename _Alloc = std::allocator<_CharT> >
+    class buffer_streambuf : public std::basic_streambuf<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT					char_type;
+      typedef _Traits					traits_type;
+      typedef _Alloc					allocator_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t				size_type;
+
+      typedef std::basic_streambuf<char_type, traits_type>  __streambuf_type;
+      typedef std::basic_string<char_type, traits_type, allocator_type>
+							__string_type;
+
+    private:
+      allocator_type	_M_alloc;
+      char_type*	_M_base;
+      size_type		_M_capacity;
+      // End of the written sequence as of the last seek; pptr() may be
+      // past it.
+      char_type*	_M_end;
+      bool		_M_owned;
+
+      buffer_streambuf(const buffer_streambuf&);
+      buffer_streambuf& operator=(const buffer_streambuf&);
+
+    public:
+      /**
+       *  @brief  Writes into an arena of its own.
+       *  @param  reserve  Initial capacity, in characters; the arena is
+       *                   otherwise allocated on the first write.
+      */
+      explicit
+      buffer_streambuf(size_type __reserve = 0,
+		       const allocator_type& __a = allocator_type())
+      : __streambuf_type(), _M_alloc(__a), _M_base(0), _M_capacity(0),
+	_M_end(0), _M_owned(true)
+      {
+	if (__reserve)
+	  _M_grow(__reserve);
+      }
+
+      /**
+       *  @brief  Writes into [buf, buf + n), without ever allocating.
+      */
+      buffer_streambuf(char_type* __buf, size_type __n)
+      : __streambuf_type(), _M_alloc(), _M_base(0), _M_capacity(0),
+	_M_end(0), _M_owned(false)
+      { _M_bind(__buf, __n); }
+
+      virtual
+      ~buffer_streambuf()
+      { _M_release(); }
+
+      /// The characters written so far, in place.
+      const char_type*
+      data() const
+      { return _M_base; }
+
+      size_type
+      size() const
+      { return _M_written() - _M_base; }
+
+      size_type
+      capacity() const
+      { return _M_capacity; }
+
+      /// A copy of the characters written so far.
+      __string_type
+      str() const
+      { return __string_type(data(), size(), _M_alloc); }
+
+      /**
+       *  @brief  Discards the output, keeping the buffer.
+       *
+       *  The arena, or the caller's array, is written again from the
+       *  start; nothing is freed or allocated.
+      */
+      void
+      reset()
+      {
+	_M_end = _M_base;
+	this->setp(_M_base, _M_base + _M_capacity);
+      }
+
+      /**
+       *  @brief  Discards the output and switches to [buf, buf + n).
+       *
+       *  Frees the arena, if any.  With a null @a buf, switches back to
+       *  an arena instead.
+      */
+      void
+      reset(char_type* __buf, size_type __n)
+      {
+	_M_release();
+	_M_owned = !__buf;
+	_M_bind(__buf, __buf ? __n : 0);
+      }
+
+      /// Makes the arena hold at least @a n characters.  No effect on a
+      /// caller-supplied array.
+      void
+      reserve(size_type __n)
+      {
+	if (_M_owned && __n > _M_capacity)
+	  _M_grow(__n);
+      }
+
+    protected:
+      virtual int_type
+      overflow(int_type __c = traits_type::eof());
+
+      virtual std::streamsize
+      xsputn(const char_type* __s, std::streamsize __n);
+
+      /// Same as reset(s, n).
+      virtual __streambuf_type*
+      setbuf(char_type* __s, std::streamsize __n)
+      {
+	reset(__s, __n);
+	return this;
+      }
+
+      virtual pos_type
+      seekoff(off_type __off, std::ios_base::seekdir __way,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out);
+
+      virtual pos_type
+      seekpos(pos_type __sp,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out)
+      { return seekoff(off_type(__sp), std::ios_base::beg, __mode); }
+
+    private:
+      char_type*
+      _M_written() const
+      { return this->pptr() > _M_end ? this->pptr() : _M_end; }
+
+      // pbump takes an int.
+      void
+      _M_pbump(size_type __n)
+      {
+	for (; __n > size_type(INT_MAX); __n -= INT_MAX)
+	  this->pbump(INT_MAX);
+	this->pbump(int(__n));
+      }
+
+      void
+      _M_bind(char_type* __buf, size_type __n)
+      {
+	_M_base = _M_end = __buf;
+	_M_capacity = __n;
+	this->setp(__buf, __buf + __n);
+      }
+
+      void
+      _M_release()
+      {
+	if (_M_owned && _M_base)
+	  _M_alloc.deallocate(_M_base, _M_capacity);
+	_M_base = _M_end = 0;
+	_M_capacity = 0;
+	this->setp(0, 0);
+      }
+
+      void
+      _M_grow(size_type __n);
+    };
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    buffer_streambuf<_CharT, _Traits, _Alloc>::
+    _M_grow(size_type __n)
+    {
+      // Double, so that writing n characters one at a time costs
+      // O(log n) allocations.
+      size_type __cap = 2 * _M_capacity;
+      if (__cap < 128)
+	__cap = 128;
+      if (__cap < __n)
+	__cap = __n;
+
+      char_type* __p = _M_alloc.allocate(__cap);
+      const size_type __len = size();
+      const size_type __off = this->pptr() - this->pbase();
+      if (__len)
+	traits_type::copy(__p, _M_base, __len);
+      _M_release();
+      _M_base = __p;
+      _M_end = __p + __len;
+      _M_capacity = __cap;
+      this->setp(__p, __p + __cap);
+      _M_pbump(__off);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename buffer_streambuf<_CharT, _Traits, _Alloc>::int_type
+    buffer_streambuf<_CharT, _Traits, _Alloc>::
+    overflow(int_type __c)
+    {
+      if (traits_type::eq_int_type(__c, traits_type::eof()))
+	return traits_type::not_eof(__c);
+
+      if (this->pptr() == this->epptr())
+	{
+	  if (!_M_owned)
+	    return traits_type::eof();
+	  _M_grow(_M_capacity + 1);
+	}
+      *this->pptr() = traits_type::to_char_type(__c);
+      this->pbump(1);
+      return __c;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    std::streamsize
+    buffer_streambuf<_CharT, _Traits, _Alloc>::
+    xsputn(const char_type* __s, std::streamsize __n)
+    {
+      if (__n <= 0)
+	return 0;
+
+      const size_type __off = this->pptr() - this->pbase();
+      if (size_type(__n) > _M_capacity - __off && _M_owned)
+	_M_grow(__off + __n);
+
+      size_type __len = this->epptr() - this->pptr();
+      if (__len > size_type(__n))
+	__len = __n;
+      traits_type::copy(this->pptr(), __s, __len);
+      _M_pbump(__len);
+      return __len;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename buffer_streambuf<_CharT, _Traits, _Alloc>::pos_type
+    buffer_streambuf<_CharT, _Traits, _Alloc>::
+    seekoff(off_type __off, std::ios_base::seekdir __way,
+	    std::ios_base::openmode __mode)
+    {
+      pos_type __ret = pos_type(off_type(-1));
+      if (!(__mode & std::ios_base::out))
+	return __ret;
+
+      // Remember how far the output went before moving back.
+      _M_end = _M_written();
+      const off_type __size = _M_end - _M_base;
+      off_type __newoff = __off;
+      if (__way == std::ios_base::cur)
+	__newoff += this->pptr() - this->pbase();
+      else if (__way == std::ios_base::end)
+	__newoff += __size;
+
+      if (__newoff >= 0 && __newoff <= __size)
+	{
+	  this->setp(_M_base, _M_base + _M_capacity);
+	  _M_pbump(__newoff);
+	  __ret = pos_type(__newoff);
+	}
+      return __ret;
+    }
+
+  /**
+   *  @brief Input buffer over caller memory.
+   *
+   *  This GNU extension reads [s, s + n) in place, where an
+   *  std::basic_istringstream would first copy it into a string.  The
+   *  characters must stay valid, and unchanged, while they are being
+   *  read; they are never written to, so putting back a character
+   *  other than the one read fails.  Input only.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT> >
+    class view_streambuf : public std::basic_streambuf<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT					char_type;
+      typedef _Traits					traits_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t				size_type;
+
+      typedef std::basic_streambuf<char_type, traits_type>  __streambuf_type;
+
+      /// An empty view.
+      view_streambuf()
+      : __streambuf_type()
+      { }
+
+      view_streambuf(const char_type* __s, size_type __n)
+      : __streambuf_type()
+      { reset(__s, __n); }
+
+      /// The whole viewed sequence, including what has been read.
+      const char_type*
+      data() const
+      { return this->eback(); }
+
+      size_type
+      size() const
+      { return this->egptr() - this->eback(); }
+
+      /// Reads the same characters again from the start.
+      void
+      reset()
+      { this->setg(this->eback(), this->eback(), this->egptr()); }
+
+      /// Reads [s, s + n) from now on.
+      void
+      reset(const char_type* __s, size_type __n)
+      {
+	char_type* __p = const_cast<char_type*>(__s);
+	this->setg(__p, __p, __p + __n);
+      }
+
+    protected:
+      virtual std::streamsize
+      showmanyc()
+      {
+	const std::streamsize __avail = this->egptr() - this->gptr();
+	return __avail ? __avail : -1;
+      }
+
+      /// Same as reset(s, n).
+      virtual __streambuf_type*
+      setbuf(char_type* __s, std::streamsize __n)
+      {
+	reset(__s, __n);
+	return this;
+      }
+
+      virtual pos_type
+      seekoff(off_type __off, std::ios_base::seekdir __way,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out)
+      {
+	pos_type __ret = pos_type(off_type(-1));
+	if (!(__mode & std::ios_base::in))
+	  return __ret;
+
+	off_type __newoff = __off;
+	if (__way == std::ios_base::cur)
+	  __newoff += this->gptr() - this->eback();
+	else if (__way == std::ios_base::end)
+	  __newoff += this->egptr() - this->eback();
+
+	if (__newoff >= 0 && __newoff <= this->egptr() - this->eback())
+	  {
+	    this->setg(this->eback(), this->eback() + __newoff,
+		       this->egptr());
+	    __ret = pos_type(__newoff);
+	  }
+	return __ret;
+      }
+
+      virtual pos_type
+      seekpos(pos_type __sp,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out)
+      { return seekoff(off_type(__sp), std::ios_base::beg, __mode); }
+    };
+
+  /**
+   *  @brief Output stream over a buffer_streambuf.
+   *
+   *  reset() starts a new message on the same stream: the buffer is
+   *  rewound and the error state cleared, while the formatting flags,
+   *  precision, fill and locale are kept.  Constructing a stream, by
+   *  contrast, initializes its ios_base and copies the locale each
+   *  time, so reusing one buffer_ostream per thread is the cheap way
+   *  to format many short messages.
+   *
+   *  @code
+   *  __gnu_cxx::buffer_ostream<char> os;
+   *  for (...)
+   *    {
+   *      os.reset();
+   *      os << "id=" << id << " value=" << value << '\n';
+   *      write(fd, os.data(), os.size());
+   *    }
+   *  @endcode
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT>,
+	   typename _Alloc = std::allocator<_CharT> >
+    class buffer_ostream : public std::basic_ostream<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT					char_type;
+      typedef _Traits					traits_type;
+      typedef _Alloc					allocator_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t				size_type;
+
+      typedef buffer_streambuf<_CharT, _Traits, _Alloc>	__buffer_type;
+      typedef typename __buffer_type::__string_type	__string_type;
+      typedef std::basic_ostream<char_type, traits_type> __ostream_type;
+
+    private:
+      __buffer_type	_M_buf;
+
+    public:
+      /// Writes into an arena; see buffer_streambuf.
+      explicit
+      buffer_ostream(size_type __reserve = 0,
+		     const allocator_type& __a = allocator_type())
+      : __ostream_type(), _M_buf(__reserve, __a)
+      { this->init(&_M_buf); }
+
+      /// Writes into [buf, buf + n).
+      buffer_ostream(char_type* __buf, size_type __n)
+      : __ostream_type(), _M_buf(__buf, __n)
+      { this->init(&_M_buf); }
+
+      __buffer_type*
+      rdbuf() const
+      { return const_cast<__buffer_type*>(&_M_buf); }
+
+      const char_type*
+      data() const
+      { return _M_buf.data(); }
+
+      size_type
+      size() const
+      { return _M_buf.size(); }
+
+      __string_type
+      str() const
+      { return _M_buf.str(); }
+
+      void
+      reset()
+      {
+	_M_buf.reset();
+	this->clear();
+      }
+
+      void
+      reset(char_type* __buf, size_type __n)
+      {
+	_M_buf.reset(__buf, __n);
+	this->clear();
+      }
+    };
+
+  /**
+   *  @brief Input stream over a view_streambuf.
+   *
+   *  Parses caller memory in place.  reset() moves the stream to new
+   *  input, clearing the error state and keeping the formatting flags
+   *  and locale.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT> >
+    class view_istream : public std::basic_istream<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT					char_type;
+      typedef _Traits					traits_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t				size_type;
+
+      typedef view_streambuf<_CharT, _Traits>		__view_type;
+      typedef std::basic_istream<char_type, traits_type> __istream_type;
+
+    private:
+      __view_type	_M_buf;
+
+    public:
+      view_istream()
+      : __istream_type(), _M_buf()
+      { this->init(&_M_buf); }
+
+      view_istream(const char_type* __s, size_type __n)
+      : __istream_type(), _M_buf(__s, __n)
+      { this->init(&_M_buf); }
+
+      /// Views the contents of @a str, which must outlive the reading.
+      template<typename _Alloc>
+        explicit
+        view_istream(const std::basic_string<_CharT, _Traits, _Alloc>& __str)
+	: __istream_type(), _M_buf(__str.data(), __str.size())
+        { this->init(&_M_buf); }
+
+      __view_type*
+      rdbuf() const
+      { return const_cast<__view_type*>(&_M_buf); }
+
+      void
+      reset()
+      {
+	_M_buf.reset();
+	this->clear();
+      }
+
+      void
+      reset(const char_type* __s, size_type __n)
+      {
+	_M_buf.reset(__s, __n);
+	this->clear();
+      }
+
+      template<typename _Alloc>
+        void
+        reset(const std::basic_string<_CharT, _Traits, _Alloc>& __str)
+        { reset(__str.data(), __str.size()); }
+    };
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -40,6 +40,11 @@
 #include <exception>
 #include <bits/gthr.h> 
 #include <bits/functexcept.h>
+#include <ext/atomic>
+
+#ifndef _GLIBCXX_CPU_RELAX
+# define _GLIBCXX_CPU_RELAX __asm __volatile ("":::"memory")
+#endif
 
 _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 
@@ -83,6 +88,22 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     { return "__gnu_cxx::__concurrence_unlock_error"; }
   };
 
+  class __concurrence_broadcast_error : public std::exception
+  {
+  public:
+    virtual char const*
+    what() const throw()
+    { return "__gnu_cxx::__concurrence_broadcast_error"; }
+  };
+
+  class __concurrence_wait_error : public std::exception
+  {
+  public:
+    virtual char const*
+    what() const throw()
+    { return "__gnu_cxx::__concurrence_wait_error"; }
+  };
+
   // Substitute for concurrence_error object in the case of -fno-exceptions.
   inline void
   __throw_concurrence_lock_error()
@@ -104,6 +125,26 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 #endif
   }
 
+  inline void
+  __throw_concurrence_broadcast_error()
+  {
+#if __EXCEPTIONS
+    throw __concurrence_broadcast_error();
+#else
+    std::abort();
+#endif
+  }
+
+  inline void
+  __throw_concurrence_wait_error()
+  {
+#if __EXCEPTIONS
+    throw __concurrence_wait_error();
+#else
+    std::abort();
+#endif
+  }
+
   class __mutex 
   {
   private:
@@ -149,6 +190,12 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	}
 #endif
     }
+
+#if __GTHREADS
+    __gthread_mutex_t*
+    gthread_mutex()
+    { return &_M_mutex; }
+#endif
   };
 
   class __recursive_mutex 
@@ -198,6 +245,56 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     }
   };
 
+#ifdef __GTHREADS_CXX0X
+  /// @brief  Condition variable, used together with __mutex.
+  class __cond
+  {
+  private:
+    __gthread_cond_t _M_cond;
+
+    __cond(const __cond&);
+    __cond& operator=(const __cond&);
+
+  public:
+    __cond()
+    {
+      if (__gthread_active_p())
+	{
+	  __gthread_cond_t __tmp = __GTHREAD_COND_INIT;
+	  _M_cond = __tmp;
+	}
+    }
+
+    void broadcast()
+    {
+      if (__gthread_active_p())
+	{
+	  if (__gthread_cond_broadcast(&_M_cond) != 0)
+	    __throw_concurrence_broadcast_error();
+	}
+    }
+
+    void signal()
+    {
+      if (__gthread_active_p())
+	{
+	  if (__gthread_cond_signal(&_M_cond) != 0)
+	    __throw_concurrence_broadcast_error();
+	}
+    }
+
+    // The caller must hold __mutex.
+    void wait(__mutex* __mutex)
+    {
+      if (__gthread_active_p())
+	{
+	  if (__gthread_cond_wait(&_M_cond, __mutex->gthread_mutex()) != 0)
+	    __throw_concurrence_wait_error();
+	}
+    }
+  };
+#endif
+
   /// @brief  Scoped lock idiom.
   // Acquire the mutex here with a constructor call, then release with
   // the destructor call in accordance with RAII style.
@@ -220,6 +317,344 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     { _M_device.unlock(); }
   };
 
+  // Number of times the locks below retry before a waiter blocks.
+  enum { _S_spin_count = 100 };
+
+  /// @brief  Mutex that spins briefly before it blocks.
+  // For critical sections of a few dozen instructions, where the
+  // holder is almost always about to release the lock and putting the
+  // waiter to sleep costs more than the wait.  Uncontended lock and
+  // unlock are a single atomic instruction each.  Not recursive.
+  class __adaptive_mutex
+  {
+  private:
+    // 0: unlocked, 1: locked, 2: locked and a thread may be blocked.
+    atomic<unsigned int> _M_state;
+#ifdef __GTHREADS_CXX0X
+    __mutex _M_mutex;
+    __cond _M_cond;
+#endif
+
+    __adaptive_mutex(const __adaptive_mutex&);
+    __adaptive_mutex& operator=(const __adaptive_mutex&);
+
+    void _M_lock_slow()
+    {
+      for (int __i = 0; __i < _S_spin_count; ++__i)
+	{
+	  _GLIBCXX_CPU_RELAX;
+	  if (_M_state.load(memory_order_relaxed) == 0 && try_lock())
+	    return;
+	}
+#ifdef __GTHREADS_CXX0X
+      __scoped_lock __sentry(_M_mutex);
+      while (_M_state.exchange(2, memory_order_acquire) != 0)
+	_M_cond.wait(&_M_mutex);
+#else
+      while (_M_state.exchange(2, memory_order_acquire) != 0)
+	_GLIBCXX_CPU_RELAX;
+#endif
+    }
+
+    void _M_wake()
+    {
+#ifdef __GTHREADS_CXX0X
+      __scoped_lock __sentry(_M_mutex);
+      _M_cond.signal();
+#endif
+    }
+
+  public:
+    __adaptive_mutex() : _M_state(0) { }
+
+    bool try_lock()
+    {
+      unsigned int __unlocked = 0;
+      return _M_state.compare_exchange_strong(__unlocked, 1,
+					      memory_order_acquire,
+					      memory_order_relaxed);
+    }
+
+    void lock()
+    {
+      if (__builtin_expect(!try_lock(), false))
+	_M_lock_slow();
+    }
+
+    void unlock()
+    {
+      if (__builtin_expect(_M_state.exchange(0, memory_order_release) == 2,
+			   false))
+	_M_wake();
+    }
+  };
+
+  /// @brief  Shared/exclusive lock.
+  // Any number of readers, or one writer.  A blocked writer keeps new
+  // readers out, so a steady stream of readers cannot starve it.
+  // Uncontended shared locking is one compare-and-swap on a word the
+  // readers share; nobody blocks unless a writer is involved.
+  class __rw_mutex
+  {
+  private:
+    enum
+      {
+	_S_writer = 1,		// Held exclusively.
+	_S_parked = 2,		// A thread may be blocked on _M_cond.
+	_S_writer_waiting = 4,	// A writer is blocked; readers wait.
+	_S_reader = 8		// Unit of the reader count.
+      };
+
+    atomic<unsigned int> _M_state;
+#ifdef __GTHREADS_CXX0X
+    __mutex _M_mutex;
+    __cond _M_cond;
+#endif
+    // Writers blocked in _M_lock_slow; guarded by _M_mutex.
+    unsigned int _M_writers;
+
+    __rw_mutex(const __rw_mutex&);
+    __rw_mutex& operator=(const __rw_mutex&);
+
+    // Sets _S_parked in __state and blocks.  Returns without blocking
+    // if the state changed meanwhile.  Called with _M_mutex held.
+    void _M_park(unsigned int __state)
+    {
+      if ((__state & _S_parked)
+	  || _M_state.compare_exchange_strong(__state, __state | _S_parked,
+					      memory_order_relaxed))
+	{
+#ifdef __GTHREADS_CXX0X
+	  _M_cond.wait(&_M_mutex);
+#else
+	  _GLIBCXX_CPU_RELAX;
+#endif
+	}
+    }
+
+    void _M_wake()
+    {
+#ifdef __GTHREADS_CXX0X
+      __scoped_lock __sentry(_M_mutex);
+      _M_state.fetch_and(~unsigned(_S_parked), memory_order_relaxed);
+      _M_cond.broadcast();
+#endif
+    }
+
+    bool _M_try_lock_shared(unsigned int __state)
+    {
+      return !(__state & (_S_writer | _S_writer_waiting))
+	&& _M_state.compare_exchange_weak(__state, __state + _S_reader,
+					  memory_order_acquire,
+					  memory_order_relaxed);
+    }
+
+    void _M_lock_shared_slow()
+    {
+      for (int __i = 0; __i < _S_spin_count; ++__i)
+	{
+	  _GLIBCXX_CPU_RELAX;
+	  if (_M_try_lock_shared(_M_state.load(memory_order_relaxed)))
+	    return;
+	}
+#ifdef __GTHREADS_CXX0X
+      __scoped_lock __sentry(_M_mutex);
+#endif
+      for (;;)
+	{
+	  const unsigned int __state = _M_state.load(memory_order_relaxed);
+	  if (_M_try_lock_shared(__state))
+	    return;
+	  if (__state & (_S_writer | _S_writer_waiting))
+	    _M_park(__state);
+	}
+    }
+
+    void _M_lock_slow()
+    {
+      for (int __i = 0; __i < _S_spin_count; ++__i)
+	{
+	  _GLIBCXX_CPU_RELAX;
+	  if (try_lock())
+	    return;
+	}
+#ifdef __GTHREADS_CXX0X
+      __scoped_lock __sentry(_M_mutex);
+#endif
+      ++_M_writers;
+      _M_state.fetch_or(_S_writer_waiting, memory_order_relaxed);
+      for (;;)
+	{
+	  unsigned int __state = _M_state.load(memory_order_relaxed);
+	  if (__state & ~unsigned(_S_parked | _S_writer_waiting))
+	    {
+	      _M_park(__state);
+	      continue;
+	    }
+	  unsigned int __locked = __state | _S_writer;
+	  if (_M_writers == 1)
+	    __locked &= ~unsigned(_S_writer_waiting);
+	  if (_M_state.compare_exchange_weak(__state, __locked,
+					     memory_order_acquire,
+					     memory_order_relaxed))
+	    break;
+	}
+      --_M_writers;
+    }
+
+  public:
+    __rw_mutex() : _M_state(0), _M_writers(0) { }
+
+    bool try_lock()
+    {
+      unsigned int __state = _M_state.load(memory_order_relaxed);
+      return !(__state & ~unsigned(_S_parked | _S_writer_waiting))
+	&& _M_state.compare_exchange_strong(__state, __state | _S_writer,
+					    memory_order_acquire,
+					    memory_order_relaxed);
+    }
+
+    void lock()
+    {
+      if (__builtin_expect(!try_lock(), false))
+	_M_lock_slow();
+    }
+
+    void unlock()
+    {
+      const unsigned int __state
+	= _M_state.fetch_and(~unsigned(_S_writer), memory_order_release);
+      if (__builtin_expect(__state & _S_parked, false))
+	_M_wake();
+    }
+
+    bool try_lock_shared()
+    {
+      unsigned int __state = _M_state.load(memory_order_relaxed);
+      while (!(__state & (_S_writer | _S_writer_waiting)))
+	if (_M_state.compare_exchange_weak(__state, __state + _S_reader,
+					   memory_order_acquire,
+					   memory_order_relaxed))
+	  return true;
+      return false;
+    }
+
+    void lock_shared()
+    {
+      if (__builtin_expect(!try_lock_shared(), false))
+	_M_lock_shared_slow();
+    }
+
+    void unlock_shared()
+    {
+      const unsigned int __state
+	= _M_state.fetch_sub(_S_reader, memory_order_release);
+      // Only a writer waits for the readers to drain.
+      if (__builtin_expect((__state & _S_parked)
+			   && __state < 2 * _S_reader, false))
+	_M_wake();
+    }
+  };
+
+  /// @brief  Flag for __call_once.
+  // An aggregate, so that a static __once_flag is initialized before
+  // any code runs: declare it without an initializer.
+  struct __once_flag
+  {
+    // 0: not run, 1: running, 2: done.
+    volatile unsigned int _M_state;
+  };
+
+  template<typename _Callable>
+    void
+    __call_once_slow(__once_flag& __flag, _Callable __f)
+    {
+      for (;;)
+	{
+	  unsigned int __state = 0;
+	  if (__atomic_compare_exchange(&__flag._M_state, __state, 1u,
+					memory_order_acquire,
+					memory_order_acquire, false))
+	    {
+	      try
+		{ __f(); }
+	      catch(...)
+		{
+		  __atomic_store(&__flag._M_state, 0u, memory_order_release);
+		  __throw_exception_again;
+		}
+	      __atomic_store(&__flag._M_state, 2u, memory_order_release);
+	      return;
+	    }
+	  if (__state == 2)
+	    return;
+	  // Someone else is running __f; initialization is rare and
+	  // short, so wait without a kernel object.
+#ifdef __GTHREADS
+	  __gthread_yield();
+#else
+	  _GLIBCXX_CPU_RELAX;
+#endif
+	}
+    }
+
+  /// @brief  Calls __f unless a call through __flag has completed.
+  // Concurrent callers wait until the running call completes.  If __f
+  // throws, the next caller tries again.  After completion the cost is
+  // one load with acquire semantics, inlined: no function call, no
+  // lock, and no barrier on x86.
+  template<typename _Callable>
+    inline void
+    __call_once(__once_flag& __flag, _Callable __f)
+    {
+      if (__builtin_expect(__atomic_load(&__flag._M_state,
+					 memory_order_acquire) != 2, false))
+	__call_once_slow(__flag, __f);
+    }
+
+  /// @brief  Scoped shared lock of a __rw_mutex.
+  class __scoped_shared_lock
+  {
+  public:
+    typedef __rw_mutex __mutex_type;
+
+  private:
+    __mutex_type& _M_device;
+
+    __scoped_shared_lock(const __scoped_shared_lock&);
+    __scoped_shared_lock& operator=(const __scoped_shared_lock&);
+
+  public:
+    explicit __scoped_shared_lock(__mutex_type& __name) : _M_device(__name)
+    { _M_device.lock_shared(); }
+
+    ~__scoped_shared_lock() throw()
+    { _M_device.unlock_shared(); }
+  };
+
+  /// @brief  Scoped lock of any of the mutexes above.
+  // __scoped_lock itself is tied to __mutex.
+  template<typename _Mutex>
+    class __scoped_exclusive_lock
+    {
+    public:
+      typedef _Mutex __mutex_type;
+
+    private:
+      __mutex_type& _M_device;
+
+      __scoped_exclusive_lock(const __scoped_exclusive_lock&);
+      __scoped_exclusive_lock& operator=(const __scoped_exclusive_lock&);
+
+    public:
+      explicit __scoped_exclusive_lock(__mutex_type& __name)
+      : _M_device(__name)
+      { _M_device.lock(); }
+
+      ~__scoped_exclusive_lock() throw()
+      { _M_device.unlock(); }
+    };
+
 _GLIBCXX_END_NAMESPACE
 
 #endif
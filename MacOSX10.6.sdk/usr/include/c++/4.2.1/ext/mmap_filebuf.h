@@ -0,0 +1,569 @@
+// Memory-mapped input file buffer -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/mmap_filebuf.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _MMAP_FILEBUF_H
+#define _MMAP_FILEBUF_H 1
+
+#pragma GCC system_header
+
+#include <istream>
+#include <climits>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  /**
+   *  @brief Zero-copy input buffer for files.
+   *
+   *  This GNU extension reads a file without copying it into a buffer
+   *  of its own.  A regular file is mapped into memory when it is
+   *  opened and its pages become the get area: reading through
+   *  sgetn, getline or operator>> touches the file contents in place,
+   *  and there is no read system call per buffer.  Pipes, sockets,
+   *  terminals and files that cannot be mapped are read instead, into
+   *  a page-aligned buffer whose size is given at construction;
+   *  large sgetn requests go straight into the caller's memory, and
+   *  for regular files the next buffer is requested from the kernel
+   *  in advance.
+   *
+   *  Input only.  Characters are not converted through the locale:
+   *  the file holds a raw sequence of @c _CharT, as for a binary
+   *  basic_filebuf, which for @c char is the same as text mode on
+   *  POSIX systems.  The mapping covers the file as it was when
+   *  opened; truncating a mapped file while it is being read raises
+   *  SIGBUS, as with any mapping.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT> >
+    class mmap_filebuf : public std::basic_streambuf<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT				        char_type;
+      typedef _Traits				        traits_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t                               size_t;
+
+      /// Default size of the read buffer for unmapped files, in bytes.
+      static const size_t _S_default_size = 256 * 1024;
+
+    private:
+      int		_M_fd;
+      bool		_M_mapped;
+      // Mapped mode: the whole file.
+      char*		_M_map;
+      size_t		_M_map_len;
+      // Read mode: one page for putback, then the page-aligned read
+      // area of _M_buf_size bytes.
+      char*		_M_buf;
+      size_t		_M_buf_size;
+      size_t		_M_page;
+      // Read mode: file offset of egptr(), and whether lseek works.
+      off_t		_M_offset;
+      bool		_M_seekable;
+
+      mmap_filebuf(const mmap_filebuf&);
+      mmap_filebuf& operator=(const mmap_filebuf&);
+
+    public:
+      /**
+       *  @param  size  Size of the read buffer used when the file cannot
+       *                be mapped, in bytes.  Rounded up to whole pages.
+      */
+      explicit
+      mmap_filebuf(size_t __size = _S_default_size);
+
+      /**
+       *  @param  fd  An open file descriptor.
+       *  @param  mode  Must not request output.
+       *  @param  size  As above.
+       *
+       *  Reading starts at the current offset of @a fd.  The descriptor
+       *  is closed when the mmap_filebuf is closed or destroyed.
+      */
+      mmap_filebuf(int __fd, std::ios_base::openmode __mode,
+		   size_t __size = _S_default_size);
+
+      virtual
+      ~mmap_filebuf();
+
+      bool
+      is_open() const
+      { return _M_fd >= 0; }
+
+      /// True if the file is read through a memory mapping.
+      bool
+      is_mapped() const
+      { return is_open() && _M_mapped; }
+
+      /**
+       *  @return  @c this on success, a null pointer otherwise.
+       *
+       *  Fails if a file is already open or if @a mode requests output.
+      */
+      mmap_filebuf*
+      open(const char* __s, std::ios_base::openmode __mode
+	   = std::ios_base::in);
+
+      /// Unmaps and closes the file.  A null pointer if none was open.
+      mmap_filebuf*
+      close();
+
+      int
+      fd() const
+      { return _M_fd; }
+
+    protected:
+      virtual std::streamsize
+      showmanyc();
+
+      virtual int_type
+      underflow();
+
+      virtual std::streamsize
+      xsgetn(char_type* __s, std::streamsize __n);
+
+      virtual pos_type
+      seekoff(off_type __off, std::ios_base::seekdir __way,
+	      std::ios_base::openmode __mode = std::ios_base::in);
+
+      virtual pos_type
+      seekpos(pos_type __pos,
+	      std::ios_base::openmode __mode = std::ios_base::in);
+
+    private:
+      bool
+      _M_attach(int __fd);
+
+      // Start of the read area of _M_buf.
+      char_type*
+      _M_area() const
+      { return reinterpret_cast<char_type*>(_M_buf + _M_page); }
+
+      // Reads whole characters into __p, at most __n bytes; retries
+      // when interrupted.  Returns the number of bytes read, 0 at end
+      // of file and -1 on error.
+      ssize_t
+      _M_read(char* __p, size_t __n);
+
+      // Makes the get area empty, keeping *__last for putback.
+      void
+      _M_empty_area(const char_type* __last);
+    };
+
+  template<typename _CharT, typename _Traits>
+    const std::size_t mmap_filebuf<_CharT, _Traits>::_S_default_size;
+
+  template<typename _CharT, typename _Traits>
+    mmap_filebuf<_CharT, _Traits>::
+    mmap_filebuf(size_t __size)
+    : _M_fd(-1), _M_mapped(false), _M_map(0), _M_map_len(0), _M_buf(0),
+      _M_buf_size(__size), _M_page(::getpagesize()), _M_offset(0),
+      _M_seekable(false)
+    { }
+
+  template<typename _CharT, typename _Traits>
+    mmap_filebuf<_CharT, _Traits>::
+    mmap_filebuf(int __fd, std::ios_base::openmode __mode, size_t __size)
+    : _M_fd(-1), _M_mapped(false), _M_map(0), _M_map_len(0), _M_buf(0),
+      _M_buf_size(__size), _M_page(::getpagesize()), _M_offset(0),
+      _M_seekable(false)
+    {
+      if (__fd >= 0)
+	{
+	  if (!(__mode & (std::ios_base::out | std::ios_base::app
+			  | std::ios_base::trunc)))
+	    _M_attach(__fd);
+	  else
+	    ::close(__fd);
+	}
+    }
+
+  template<typename _CharT, typename _Traits>
+    mmap_filebuf<_CharT, _Traits>::~mmap_filebuf()
+    {
+      this->close();
+      if (_M_buf)
+	::munmap(_M_buf, _M_page + _M_buf_size);
+    }
+
+  template<typename _CharT, typename _Traits>
+    mmap_filebuf<_CharT, _Traits>*
+    mmap_filebuf<_CharT, _Traits>::
+    open(const char* __s, std::ios_base::openmode __mode)
+    {
+      if (this->is_open() || (__mode & (std::ios_base::out
+					  | std::ios_base::app
+					  | std::ios_base::trunc)))
+	return 0;
+      int __fd;
+      do
+	__fd = ::open(__s, O_RDONLY);
+      while (__fd < 0 && errno == EINTR);
+      if (__fd < 0)
+	return 0;
+      return _M_attach(__fd) ? this : 0;
+    }
+
+  template<typename _CharT, typename _Traits>
+    bool
+    mmap_filebuf<_CharT, _Traits>::
+    _M_attach(int __fd)
+    {
+      struct stat __st;
+      if (::fstat(__fd, &__st) != 0)
+	{
+	  ::close(__fd);
+	  return false;
+	}
+      _M_fd = __fd;
+      off_t __pos = ::lseek(__fd, 0, SEEK_CUR);
+      _M_seekable = __pos >= 0;
+      if (!_M_seekable)
+	__pos = 0;
+
+      _M_mapped = false;
+      if (S_ISREG(__st.st_mode)
+	  && static_cast<unsigned long long>(__st.st_size) <= size_t(-1))
+	{
+	  const size_t __len = __st.st_size;
+	  void* __p = 0;
+	  if (__len)
+	    {
+	      __p = ::mmap(0, __len, PROT_READ, MAP_FILE | MAP_PRIVATE,
+			   __fd, 0);
+	      if (__p != MAP_FAILED)
+		::madvise(__p, __len, MADV_SEQUENTIAL);
+	    }
+	  if (__p != MAP_FAILED)
+	    {
+	      _M_mapped = true;
+	      _M_map = static_cast<char*>(__p);
+	      _M_map_len = __len;
+	      char_type* __beg = reinterpret_cast<char_type*>(_M_map);
+	      const size_t __chars = __len / sizeof(char_type);
+	      size_t __cur = size_t(__pos) / sizeof(char_type);
+	      if (__cur > __chars)
+		__cur = __chars;
+	      this->setg(__beg, __beg + __cur, __beg + __chars);
+	      return true;
+	    }
+	}
+
+      // Read mode.  The buffer is allocated once and kept across
+      // open/close cycles.
+      if (!_M_buf)
+	{
+	  _M_buf_size = ((_M_buf_size ? _M_buf_size : _S_default_size)
+			 + _M_page - 1) & ~(_M_page - 1);
+	  void* __p = ::mmap(0, _M_page + _M_buf_size,
+			     PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE,
+			     -1, 0);
+	  if (__p == MAP_FAILED)
+	    {
+	      ::close(__fd);
+	      _M_fd = -1;
+	      return false;
+	    }
+	  _M_buf = static_cast<char*>(__p);
+	}
+      _M_offset = __pos;
+      this->setg(_M_area(), _M_area(), _M_area());
+      return true;
+    }
+
+  template<typename _CharT, typename _Traits>
+    mmap_filebuf<_CharT, _Traits>*
+    mmap_filebuf<_CharT, _Traits>::
+    close()
+    {
+      if (!this->is_open())
+	return 0;
+      if (_M_map)
+	::munmap(_M_map, _M_map_len);
+      _M_map = 0;
+      _M_map_len = 0;
+      _M_mapped = false;
+      this->setg(0, 0, 0);
+      const int __err = ::close(_M_fd);
+      _M_fd = -1;
+      return __err == 0 ? this : 0;
+    }
+
+  template<typename _CharT, typename _Traits>
+    ssize_t
+    mmap_filebuf<_CharT, _Traits>::
+    _M_read(char* __p, size_t __n)
+    {
+      size_t __done = 0;
+      do
+	{
+	  const ssize_t __r = ::read(_M_fd, __p + __done, __n - __done);
+	  if (__r > 0)
+	    __done += __r;
+	  else if (__r == 0)
+	    break;
+	  else if (errno != EINTR)
+	    return __done ? ssize_t(__done) : -1;
+	}
+      while (__done == 0 || __done % sizeof(char_type) != 0);
+      _M_offset += __done;
+
+#ifdef F_RDADVISE
+      // Ask for the next buffer while the caller consumes this one.
+      if (_M_seekable && __done)
+	{
+	  struct radvisory __ra;
+	  __ra.ra_offset = _M_offset;
+	  __ra.ra_count = _M_buf_size < size_t(INT_MAX)
+	                  ? int(_M_buf_size) : INT_MAX;
+	  ::fcntl(_M_fd, F_RDADVISE, &__ra);
+	}
+#endif
+      return __done;
+    }
+
+  template<typename _CharT, typename _Traits>
+    void
+    mmap_filebuf<_CharT, _Traits>::
+    _M_empty_area(const char_type* __last)
+    {
+      char_type* __area = _M_area();
+      if (__last)
+	{
+	  __area[-1] = *__last;
+	  this->setg(__area - 1, __area, __area);
+	}
+      else
+	this->setg(__area, __area, __area);
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::int_type
+    mmap_filebuf<_CharT, _Traits>::
+    underflow()
+    {
+      if (this->gptr() < this->egptr())
+	return traits_type::to_int_type(*this->gptr());
+      if (!this->is_open() || _M_mapped)
+	return traits_type::eof();
+
+      const char_type* __last = 0;
+      if (this->gptr() > this->eback())
+	__last = this->gptr() - 1;
+      _M_empty_area(__last);
+      const ssize_t __n = _M_read(_M_buf + _M_page, _M_buf_size);
+      if (__n <= 0)
+	return traits_type::eof();
+      this->setg(this->eback(), _M_area(),
+		 _M_area() + __n / sizeof(char_type));
+      return traits_type::to_int_type(*this->gptr());
+    }
+
+  template<typename _CharT, typename _Traits>
+    std::streamsize
+    mmap_filebuf<_CharT, _Traits>::
+    xsgetn(char_type* __s, std::streamsize __n)
+    {
+      // Mapped files, and requests the buffer serves as well: copy
+      // from the get area, refilling through underflow.
+      const std::streamsize __avail = this->egptr() - this->gptr();
+      if (_M_mapped || !this->is_open() || __n <= __avail
+	  || size_t(__n - __avail) * sizeof(char_type) < _M_buf_size)
+	return std::basic_streambuf<_CharT, _Traits>::xsgetn(__s, __n);
+
+      // Large requests: drain the get area, then read the rest into
+      // the caller's memory directly.
+      traits_type::copy(__s, this->gptr(), __avail);
+      std::streamsize __ret = __avail;
+      while (__ret < __n)
+	{
+	  const ssize_t __r = _M_read(reinterpret_cast<char*>(__s + __ret),
+				      size_t(__n - __ret) * sizeof(char_type));
+	  if (__r <= 0)
+	    break;
+	  __ret += __r / sizeof(char_type);
+	}
+      _M_empty_area(__ret ? __s + __ret - 1 : 0);
+      return __ret;
+    }
+
+  template<typename _CharT, typename _Traits>
+    std::streamsize
+    mmap_filebuf<_CharT, _Traits>::
+    showmanyc()
+    {
+      if (!this->is_open())
+	return -1;
+      if (_M_mapped)
+	return -1;
+      struct stat __st;
+      if (_M_seekable && ::fstat(_M_fd, &__st) == 0
+	  && S_ISREG(__st.st_mode))
+	{
+	  const off_t __left = __st.st_size - _M_offset;
+	  return __left > 0 ? std::streamsize(__left / sizeof(char_type)) : -1;
+	}
+      return 0;
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::pos_type
+    mmap_filebuf<_CharT, _Traits>::
+    seekoff(off_type __off, std::ios_base::seekdir __way,
+	    std::ios_base::openmode __mode)
+    {
+      pos_type __ret = pos_type(off_type(-1));
+      if (!this->is_open() || !(__mode & std::ios_base::in))
+	return __ret;
+
+      if (_M_mapped)
+	{
+	  const off_type __size = this->egptr() - this->eback();
+	  off_type __pos = __off;
+	  if (__way == std::ios_base::cur)
+	    __pos += this->gptr() - this->eback();
+	  else if (__way == std::ios_base::end)
+	    __pos += __size;
+	  if (__pos >= 0 && __pos <= __size)
+	    {
+	      this->setg(this->eback(), this->eback() + __pos, this->egptr());
+	      __ret = pos_type(__pos);
+	    }
+	  return __ret;
+	}
+
+      if (!_M_seekable)
+	return __ret;
+      // Position of gptr(), in characters.
+      const off_type __cur = _M_offset / off_type(sizeof(char_type))
+	                     - (this->egptr() - this->gptr());
+      off_type __pos = __off;
+      if (__way == std::ios_base::cur)
+	__pos += __cur;
+      else if (__way == std::ios_base::end)
+	{
+	  struct stat __st;
+	  if (::fstat(_M_fd, &__st) != 0)
+	    return __ret;
+	  __pos += __st.st_size / off_type(sizeof(char_type));
+	}
+      if (__pos < 0)
+	return __ret;
+      if (__way == std::ios_base::cur && __off == 0)
+	return pos_type(__cur);
+      const off_t __bytes = __pos * off_type(sizeof(char_type));
+      if (::lseek(_M_fd, __bytes, SEEK_SET) != __bytes)
+	return __ret;
+      _M_offset = __bytes;
+      _M_empty_area(0);
+      return pos_type(__pos);
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::pos_type
+    mmap_filebuf<_CharT, _Traits>::
+    seekpos(pos_type __pos, std::ios_base::openmode __mode)
+    { return this->seekoff(off_type(__pos), std::ios_base::beg, __mode); }
+
+  /**
+   *  @brief Input stream over a mmap_filebuf.
+   *
+   *  As std::basic_ifstream, with the buffer size of the
+   *  mmap_filebuf as an extra constructor argument.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT> >
+    class mmap_ifstream : public std::basic_istream<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT 					char_type;
+      typedef _Traits 					traits_type;
+      typedef typename traits_type::int_type 		int_type;
+      typedef typename traits_type::pos_type 		pos_type;
+      typedef typename traits_type::off_type 		off_type;
+      typedef mmap_filebuf<char_type, traits_type> 	__filebuf_type;
+      typedef std::basic_istream<char_type, traits_type> __istream_type;
+
+    private:
+      __filebuf_type	_M_filebuf;
+
+    public:
+      explicit
+      mmap_ifstream(std::size_t __size = __filebuf_type::_S_default_size)
+      : __istream_type(), _M_filebuf(__size)
+      { this->init(&_M_filebuf); }
+
+      explicit
+      mmap_ifstream(const char* __s,
+		    std::size_t __size = __filebuf_type::_S_default_size)
+      : __istream_type(), _M_filebuf(__size)
+      {
+	this->init(&_M_filebuf);
+	this->open(__s);
+      }
+
+      __filebuf_type*
+      rdbuf() const
+      { return const_cast<__filebuf_type*>(&_M_filebuf); }
+
+      bool
+      is_open() const
+      { return _M_filebuf.is_open(); }
+
+      void
+      open(const char* __s)
+      {
+	if (!_M_filebuf.open(__s, std::ios_base::in))
+	  this->setstate(std::ios_base::failbit);
+	else
+	  this->clear();
+      }
+
+      void
+      close()
+      {
+	if (!_M_filebuf.close())
+	  this->setstate(std::ios_base::failbit);
+      }
+    };
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,266 @@
+// Lazily mapped file ropes -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+
+/** @file ext/mmap_rope.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _MMAP_ROPE_H
+#define _MMAP_ROPE_H 1
+
+#pragma GCC system_header
+
+#include <ext/rope>
+#include <ext/concurrence.h>
+#include <bits/functexcept.h>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  // The open file behind the producers of one mmap_rope: closed when
+  // the last of them is destroyed.
+  struct _Mmap_rope_file : public _Refcount_Base
+  {
+    int _M_fd;
+
+    explicit
+    _Mmap_rope_file(int __fd) : _Refcount_Base(1), _M_fd(__fd) { }
+
+    ~_Mmap_rope_file()
+    { ::close(_M_fd); }
+
+    void
+    _M_unref()
+    {
+      if (0 == _M_decr())
+	delete this;
+    }
+
+  private:
+    _Mmap_rope_file(const _Mmap_rope_file&);
+    _Mmap_rope_file& operator=(const _Mmap_rope_file&);
+  };
+
+  /**
+   *  @brief A char_producer reading one section of a file.
+   *
+   *  The section is mapped into memory the first time any of its
+   *  characters is asked for, and unmapped when the producer is
+   *  destroyed, so a rope made of such producers only occupies
+   *  address space for the parts of the file that have been read.
+   *  May be called from several threads at once.  Throws
+   *  std::ios_base::failure if the section cannot be mapped.
+   *
+   *  The file holds a raw sequence of @c _CharT.  It must not be
+   *  truncated or modified while it is mapped; reading a mapped page
+   *  that is no longer backed by the file raises SIGBUS.
+  */
+  template<class _CharT>
+    class mmap_char_producer : public char_producer<_CharT>
+    {
+    public:
+      /**
+       *  @param  file  The file, which gains a reference.
+       *  @param  offset  Byte offset of the section in the file; a
+       *                  multiple of the page size.
+       *  @param  len  Length of the section, in characters.
+      */
+      mmap_char_producer(_Mmap_rope_file* __file, off_t __offset,
+			 size_t __len)
+      : _M_file(__file), _M_offset(__offset), _M_len(__len), _M_data(0),
+	_M_once()
+      { _M_file->_M_incr(); }
+
+      virtual
+      ~mmap_char_producer()
+      {
+	if (_M_data)
+	  ::munmap(const_cast<_CharT*>(_M_data), _M_len * sizeof(_CharT));
+	_M_file->_M_unref();
+      }
+
+      virtual void
+      operator()(size_t __start_pos, size_t __len, _CharT* __buffer)
+      {
+	__call_once(_M_once, _Map(this));
+	std::uninitialized_copy(_M_data + __start_pos,
+				_M_data + __start_pos + __len, __buffer);
+      }
+
+    private:
+      struct _Map
+      {
+	mmap_char_producer* _M_producer;
+
+	explicit
+	_Map(mmap_char_producer* __p) : _M_producer(__p) { }
+
+	void
+	operator()() const
+	{ _M_producer->_M_map(); }
+      };
+
+      void
+      _M_map()
+      {
+	void* __p = ::mmap(0, _M_len * sizeof(_CharT), PROT_READ,
+			   MAP_FILE | MAP_PRIVATE, _M_file->_M_fd, _M_offset);
+	if (__p == MAP_FAILED)
+	  std::__throw_ios_failure(__N("mmap_char_producer: cannot map file"));
+	_M_data = static_cast<const _CharT*>(__p);
+      }
+
+      _Mmap_rope_file*	_M_file;
+      off_t		_M_offset;
+      size_t		_M_len;
+      const _CharT*	_M_data;
+      __once_flag	_M_once;
+
+      mmap_char_producer(const mmap_char_producer&);
+      mmap_char_producer& operator=(const mmap_char_producer&);
+    };
+
+  // Balanced rope over the sections [__first, __last) of __file.
+  template<class _CharT, class _Alloc>
+    rope<_CharT, _Alloc>
+    __mmap_rope_sections(_Mmap_rope_file* __file, size_t __first,
+			 size_t __last, size_t __section, size_t __chars)
+    {
+      typedef rope<_CharT, _Alloc> _Rope;
+      if (__last - __first > 1)
+	{
+	  const size_t __middle = __first + (__last - __first) / 2;
+	  return (__mmap_rope_sections<_CharT, _Alloc>(__file, __first,
+						       __middle, __section,
+						       __chars)
+		  + __mmap_rope_sections<_CharT, _Alloc>(__file, __middle,
+							 __last, __section,
+							 __chars));
+	}
+
+      const size_t __start = __first * __section;
+      const size_t __len = std::min(__section, __chars - __start);
+      mmap_char_producer<_CharT>* __fn =
+	new mmap_char_producer<_CharT>(__file,
+				       off_t(__start) * off_t(sizeof(_CharT)),
+				       __len);
+      try
+	{ return _Rope(__fn, __len, true); }
+      catch(...)
+	{
+	  delete __fn;
+	  __throw_exception_again;
+	}
+    }
+
+  /**
+   *  @brief  Makes a rope whose characters are read from a file on
+   *          demand.
+   *  @param  path  Name of a regular file.
+   *  @param  r  Set to the contents of the file on success.
+   *  @param  section  Size of the pieces the file is mapped in, in
+   *                   bytes.  Rounded up to whole pages.
+   *  @return  True on success.  On failure @a r is unchanged and
+   *           errno tells why.
+   *
+   *  The file is opened now and read lazily, one section at a time,
+   *  through mmap_char_producers arranged in a balanced tree; it stays
+   *  open until the last rope sharing any part of it is destroyed.
+   *  Substrings, concatenations and insertions copy none of the file.
+  */
+  template<class _CharT, class _Alloc>
+    bool
+    mmap_rope(const char* __path, rope<_CharT, _Alloc>& __r,
+	      size_t __section = size_t(1) << 22)
+    {
+      int __fd;
+      do
+	__fd = ::open(__path, O_RDONLY);
+      while (__fd < 0 && errno == EINTR);
+      if (__fd < 0)
+	return false;
+
+      struct stat __st;
+      int __err = 0;
+      if (::fstat(__fd, &__st) != 0)
+	__err = errno;
+      else if (!S_ISREG(__st.st_mode))
+	__err = EINVAL;
+      else if (static_cast<unsigned long long>(__st.st_size) > size_t(-1))
+	__err = EFBIG;
+      if (__err)
+	{
+	  ::close(__fd);
+	  errno = __err;
+	  return false;
+	}
+
+      const size_t __page = ::sysconf(_SC_PAGESIZE);
+      __section = std::max(__section, __page);
+      __section = (__section + __page - 1) / __page * __page;
+
+      const size_t __chars = size_t(__st.st_size) / sizeof(_CharT);
+      const size_t __section_chars = __section / sizeof(_CharT);
+
+      _Mmap_rope_file* __file;
+      try
+	{ __file = new _Mmap_rope_file(__fd); }
+      catch(...)
+	{
+	  ::close(__fd);
+	  __throw_exception_again;
+	}
+
+      rope<_CharT, _Alloc> __result;
+      try
+	{
+	  if (__chars)
+	    __result = __mmap_rope_sections<_CharT, _Alloc>
+	      (__file, 0, (__chars - 1) / __section_chars + 1,
+	       __section_chars, __chars);
+	}
+      catch(...)
+	{
+	  __file->_M_unref();
+	  __throw_exception_again;
+	}
+      __file->_M_unref();
+      __r = __result;
+      return true;
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -38,6 +38,7 @@
 #include <cstdlib>
 #include <bits/functexcept.h>
 #include <ext/atomicity.h>
+#include <ext/concurrence.h>
 
 _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 
@@ -237,6 +238,9 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
       _M_adjust_freelist(const _Bin_record&, _Block_record*, size_t)
       { }
 
+      char*
+      _M_allocate_block(size_t __bytes);
+
       explicit __pool() 
       : _M_bin(NULL), _M_bin_size(1) { }
 
@@ -353,6 +357,9 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	  }
       }
 
+      char*
+      _M_allocate_block(size_t __bytes);
+
       // XXX GLIBCXX_ABI Deprecated
       void 
       _M_destroy_thread_key(void*);
@@ -386,6 +393,460 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     };
 #endif
 
+  // Take a block from the freelist of the calling thread if it has
+  // one, without locking anything; else reserve one.
+  inline char*
+  __pool<false>::_M_allocate_block(size_t __bytes)
+  {
+    // Round up to power of 2 and figure out which bin to use.
+    const size_t __which = _M_get_binmap(__bytes);
+    const size_t __thread_id = _M_get_thread_id();
+    const _Bin_record& __bin = _M_get_bin(__which);
+    if (__bin._M_first[__thread_id])
+      {
+	// Already reserved.
+	_Block_record* __block_record = __bin._M_first[__thread_id];
+	__bin._M_first[__thread_id] = __block_record->_M_next;
+	_M_adjust_freelist(__bin, __block_record, __thread_id);
+	return reinterpret_cast<char*>(__block_record) + _M_get_align();
+      }
+    // Null, reserve.
+    return _M_reserve_block(__bytes, __thread_id);
+  }
+
+#ifdef __GTHREADS
+  inline char*
+  __pool<true>::_M_allocate_block(size_t __bytes)
+  {
+    const size_t __which = _M_get_binmap(__bytes);
+    const size_t __thread_id = _M_get_thread_id();
+    const _Bin_record& __bin = _M_get_bin(__which);
+    if (__bin._M_first[__thread_id])
+      {
+	_Block_record* __block_record = __bin._M_first[__thread_id];
+	__bin._M_first[__thread_id] = __block_record->_M_next;
+	_M_adjust_freelist(__bin, __block_record, __thread_id);
+	return reinterpret_cast<char*>(__block_record) + _M_get_align();
+      }
+    return _M_reserve_block(__bytes, __thread_id);
+  }
+#endif
+
+  /**
+   *  @brief  Pool with a per-thread cache in front of shared bins.
+   *
+   *  In the threaded specialization every thread keeps, for each bin,
+   *  a private freelist reached through a __gthread_key_t, so that the
+   *  common case of allocate and deallocate involves no lock and no
+   *  thread id.  Blocks move between a thread cache and the shared
+   *  (central) bins in batches, under the lock of the central bin:
+   *  a thread whose freelist is empty takes a batch, and a thread
+   *  whose freelist grows beyond two batches gives one back.  Blocks
+   *  carry no owner, so memory freed by a thread other than the one
+   *  that allocated it simply joins the cache of the freeing thread.
+   *  On thread exit the cache is returned to the central bins.
+   *
+   *  Use as __mt_alloc<_Tp, __common_pool_policy<__cached_pool, true> >.
+   *  The single-threaded specialization is just __pool<false>.
+   */
+  template<bool _Thread>
+    class __cached_pool;
+
+  /// Specialization for single thread.
+  template<>
+    class __cached_pool<false> : public __pool<false>
+    {
+    public:
+      explicit __cached_pool() { }
+
+      explicit __cached_pool(const __pool_base::_Tune& __tune)
+      : __pool<false>(__tune) { }
+    };
+
+#ifdef __GTHREADS
+  /// Specialization for thread enabled, via gthreads.h.
+  template<>
+    class __cached_pool<true> : public __pool_base
+    {
+    public:
+      union _Block_record
+      {
+	// Points to the block_record of the next free block.
+	_Block_record*			_M_next;
+      };
+
+      // Statistics for one bin, as returned by _M_get_stats.  The
+      // counters of running threads are read without synchronization,
+      // so the figures are approximate while other threads allocate.
+      struct _Bin_stats
+      {
+	// Size of the blocks of this bin.
+	size_t				_M_block_size;
+
+	// Allocations served directly from a thread cache.
+	size_t				_M_hits;
+
+	// Batches moved from the central bin into a thread cache.
+	size_t				_M_refills;
+
+	// Batches moved from a thread cache back to the central bin.
+	size_t				_M_flushes;
+
+	// Bytes of free blocks held in thread caches.
+	size_t				_M_thread_bytes;
+
+	// Bytes of free blocks held in the central bin.
+	size_t				_M_central_bytes;
+      };
+
+      void
+      _M_initialize_once()
+      {
+	if (__builtin_expect(_M_init == false, false))
+	  _M_initialize();
+      }
+
+      char*
+      _M_allocate_block(size_t __bytes)
+      {
+	const size_t __which = _M_get_binmap(__bytes);
+	_Cache_bin& __bin = _M_get_cache()._M_bins[__which];
+	if (__builtin_expect(__bin._M_first != 0, true))
+	  ++__bin._M_hits;
+	else
+	  _M_refill(__bin, __which);
+	_Block_record* __block = __bin._M_first;
+	__bin._M_first = __block->_M_next;
+	--__bin._M_count;
+	return reinterpret_cast<char*>(__block);
+      }
+
+      void
+      _M_reclaim_block(char* __p, size_t __bytes)
+      {
+	const size_t __which = _M_get_binmap(__bytes);
+	_Cache_bin& __bin = _M_get_cache()._M_bins[__which];
+	_Block_record* __block = reinterpret_cast<_Block_record*>(__p);
+	__block->_M_next = __bin._M_first;
+	__bin._M_first = __block;
+	if (__builtin_expect(++__bin._M_count > 2 * _M_batch[__which], false))
+	  _M_flush(__bin, __which, _M_batch[__which]);
+      }
+
+      size_t
+      _M_get_bin_count() const
+      { return _M_bin_size; }
+
+      _Bin_stats
+      _M_get_stats(size_t __which);
+
+      explicit __cached_pool()
+      : _M_central(NULL), _M_batch(NULL), _M_bin_size(1), _M_caches(NULL),
+      _M_single_cache(NULL)
+      { }
+
+      explicit __cached_pool(const __pool_base::_Tune& __tune)
+      : __pool_base(__tune), _M_central(NULL), _M_batch(NULL),
+      _M_bin_size(1), _M_caches(NULL), _M_single_cache(NULL)
+      { }
+
+    private:
+      struct _Cache_bin
+      {
+	_Block_record*			_M_first;
+	size_t				_M_count;
+	size_t				_M_hits;
+	size_t				_M_refills;
+	size_t				_M_flushes;
+      };
+
+      // The cache of one thread.  The _Cache_bin array follows it in
+      // the same allocation.
+      struct _Thread_cache
+      {
+	__cached_pool*			_M_pool;
+	_Thread_cache*			_M_next;
+	_Thread_cache*			_M_prev;
+	_Cache_bin*			_M_bins;
+      };
+
+      struct _Central_bin
+      {
+	_Block_record*			_M_first;
+	size_t				_M_count;
+
+	// Counters inherited from the caches of exited threads.
+	size_t				_M_hits;
+	size_t				_M_refills;
+	size_t				_M_flushes;
+
+	__adaptive_mutex		_M_mutex;
+
+	_Central_bin()
+	: _M_first(NULL), _M_count(0), _M_hits(0), _M_refills(0),
+	_M_flushes(0) { }
+      };
+
+      typedef __scoped_exclusive_lock<__adaptive_mutex> _Bin_lock;
+
+      // An "array" of central bins, one per power of 2 size.
+      _Central_bin*			_M_central;
+
+      // Number of blocks moved at once between a thread cache and
+      // the central bin, per bin.
+      size_t*				_M_batch;
+
+      size_t				_M_bin_size;
+
+      __gthread_key_t			_M_key;
+
+      // All live thread caches, for _M_get_stats.
+      __rw_mutex			_M_caches_mutex;
+      _Thread_cache*			_M_caches;
+
+      // Used instead of _M_key when the program is not multithreaded.
+      _Thread_cache*			_M_single_cache;
+
+      void
+      _M_initialize();
+
+      _Thread_cache&
+      _M_get_cache()
+      {
+	_Thread_cache* __cache;
+	if (__gthread_active_p())
+	  __cache = static_cast<_Thread_cache*>(__gthread_getspecific(_M_key));
+	else
+	  __cache = _M_single_cache;
+	if (__builtin_expect(__cache == NULL, false))
+	  __cache = _M_new_cache();
+	return *__cache;
+      }
+
+      _Thread_cache*
+      _M_new_cache();
+
+      void
+      _M_refill(_Cache_bin& __bin, size_t __which);
+
+      void
+      _M_flush(_Cache_bin& __bin, size_t __which, size_t __n);
+
+      static void
+      _S_destroy_cache(void* __p);
+    };
+
+  inline void
+  __cached_pool<true>::_M_initialize()
+  {
+    // Bins are powers of 2 from _M_min_bin up to _M_max_bytes.
+    size_t __bin_size = _M_options._M_min_bin;
+    _M_bin_size = 1;
+    while (_M_options._M_max_bytes > __bin_size)
+      {
+	__bin_size <<= 1;
+	++_M_bin_size;
+      }
+
+    const size_t __j = (_M_options._M_max_bytes + 1) * sizeof(_Binmap_type);
+    _M_binmap = static_cast<_Binmap_type*>(::operator new(__j));
+    _Binmap_type* __bp = _M_binmap;
+    _Binmap_type __bin_max = _M_options._M_min_bin;
+    _Binmap_type __bint = 0;
+    for (_Binmap_type __ct = 0; __ct <= _M_options._M_max_bytes; ++__ct)
+      {
+	if (__ct > __bin_max)
+	  {
+	    __bin_max <<= 1;
+	    ++__bint;
+	  }
+	*__bp++ = __bint;
+      }
+
+    _M_central = new _Central_bin[_M_bin_size];
+    _M_batch = new size_t[_M_bin_size];
+    for (size_t __n = 0; __n < _M_bin_size; ++__n)
+      {
+	// About an eighth of a chunk per batch.
+	const size_t __blocks = (_M_options._M_chunk_size
+				 / (_M_options._M_min_bin << __n));
+	_M_batch[__n] = __blocks / 8 > 2 ? __blocks / 8 : 2;
+      }
+
+    if (__gthread_active_p())
+      __gthread_key_create(&_M_key, _S_destroy_cache);
+    _M_init = true;
+  }
+
+  inline __cached_pool<true>::_Thread_cache*
+  __cached_pool<true>::_M_new_cache()
+  {
+    void* __v = ::operator new(sizeof(_Thread_cache)
+			       + _M_bin_size * sizeof(_Cache_bin));
+    _Thread_cache* __cache = static_cast<_Thread_cache*>(__v);
+    __cache->_M_pool = this;
+    __cache->_M_prev = NULL;
+    __cache->_M_bins = reinterpret_cast<_Cache_bin*>(__cache + 1);
+    for (size_t __n = 0; __n < _M_bin_size; ++__n)
+      {
+	_Cache_bin& __bin = __cache->_M_bins[__n];
+	__bin._M_first = NULL;
+	__bin._M_count = __bin._M_hits = 0;
+	__bin._M_refills = __bin._M_flushes = 0;
+      }
+
+    {
+      __scoped_exclusive_lock<__rw_mutex> __sentry(_M_caches_mutex);
+      __cache->_M_next = _M_caches;
+      if (_M_caches)
+	_M_caches->_M_prev = __cache;
+      _M_caches = __cache;
+    }
+
+    if (__gthread_active_p())
+      __gthread_setspecific(_M_key, __cache);
+    else
+      _M_single_cache = __cache;
+    return __cache;
+  }
+
+  inline void
+  __cached_pool<true>::_M_refill(_Cache_bin& __bin, size_t __which)
+  {
+    _Central_bin& __central = _M_central[__which];
+    const size_t __batch = _M_batch[__which];
+    {
+      _Bin_lock __sentry(__central._M_mutex);
+      if (__central._M_first)
+	{
+	  _Block_record* __last = __central._M_first;
+	  size_t __n = 1;
+	  for (; __n < __batch && __last->_M_next; ++__n)
+	    __last = __last->_M_next;
+	  __bin._M_first = __central._M_first;
+	  __central._M_first = __last->_M_next;
+	  __last->_M_next = NULL;
+	  __central._M_count -= __n;
+	  __bin._M_count = __n;
+	  ++__bin._M_refills;
+	  return;
+	}
+    }
+
+    // The central bin is empty: carve a new chunk into blocks, keep a
+    // batch and hand the rest to the central bin.
+    const size_t __bin_size = _M_options._M_min_bin << __which;
+    const size_t __blocks = _M_options._M_chunk_size / __bin_size;
+    char* __c = static_cast<char*>(::operator new(_M_options._M_chunk_size));
+    _Block_record* __first = reinterpret_cast<_Block_record*>(__c);
+    _Block_record* __block = __first;
+    for (size_t __n = 1; __n < __blocks; ++__n)
+      {
+	__c += __bin_size;
+	__block->_M_next = reinterpret_cast<_Block_record*>(__c);
+	__block = __block->_M_next;
+      }
+    __block->_M_next = NULL;
+
+    const size_t __keep = __blocks < __batch ? __blocks : __batch;
+    _Block_record* __last = __first;
+    for (size_t __n = 1; __n < __keep; ++__n)
+      __last = __last->_M_next;
+    if (__last->_M_next)
+      {
+	_Bin_lock __sentry(__central._M_mutex);
+	__block->_M_next = __central._M_first;
+	__central._M_first = __last->_M_next;
+	__central._M_count += __blocks - __keep;
+      }
+    __last->_M_next = NULL;
+    __bin._M_first = __first;
+    __bin._M_count = __keep;
+    ++__bin._M_refills;
+  }
+
+  inline void
+  __cached_pool<true>::_M_flush(_Cache_bin& __bin, size_t __which,
+				size_t __n)
+  {
+    if (!__n || !__bin._M_first)
+      return;
+    _Block_record* __first = __bin._M_first;
+    _Block_record* __last = __first;
+    size_t __moved = 1;
+    for (; __moved < __n && __last->_M_next; ++__moved)
+      __last = __last->_M_next;
+    __bin._M_first = __last->_M_next;
+    __bin._M_count -= __moved;
+    ++__bin._M_flushes;
+
+    _Central_bin& __central = _M_central[__which];
+    _Bin_lock __sentry(__central._M_mutex);
+    __last->_M_next = __central._M_first;
+    __central._M_first = __first;
+    __central._M_count += __moved;
+  }
+
+  inline void
+  __cached_pool<true>::_S_destroy_cache(void* __p)
+  {
+    _Thread_cache* __cache = static_cast<_Thread_cache*>(__p);
+    __cached_pool* __pool = __cache->_M_pool;
+    {
+      __scoped_exclusive_lock<__rw_mutex> __sentry(__pool->_M_caches_mutex);
+      if (__cache->_M_prev)
+	__cache->_M_prev->_M_next = __cache->_M_next;
+      else
+	__pool->_M_caches = __cache->_M_next;
+      if (__cache->_M_next)
+	__cache->_M_next->_M_prev = __cache->_M_prev;
+    }
+
+    for (size_t __n = 0; __n < __pool->_M_bin_size; ++__n)
+      {
+	_Cache_bin& __bin = __cache->_M_bins[__n];
+	__pool->_M_flush(__bin, __n, __bin._M_count);
+	_Central_bin& __central = __pool->_M_central[__n];
+	_Bin_lock __sentry(__central._M_mutex);
+	__central._M_hits += __bin._M_hits;
+	__central._M_refills += __bin._M_refills;
+	__central._M_flushes += __bin._M_flushes;
+      }
+    ::operator delete(__p);
+  }
+
+  inline __cached_pool<true>::_Bin_stats
+  __cached_pool<true>::_M_get_stats(size_t __which)
+  {
+    _Bin_stats __stats;
+    __stats._M_block_size = _M_options._M_min_bin << __which;
+    __stats._M_hits = __stats._M_refills = __stats._M_flushes = 0;
+    __stats._M_thread_bytes = __stats._M_central_bytes = 0;
+    if (!_M_init || __which >= _M_bin_size)
+      return __stats;
+
+    {
+      __scoped_shared_lock __sentry(_M_caches_mutex);
+      for (_Thread_cache* __c = _M_caches; __c; __c = __c->_M_next)
+	{
+	  const _Cache_bin& __bin = __c->_M_bins[__which];
+	  __stats._M_hits += __bin._M_hits;
+	  __stats._M_refills += __bin._M_refills;
+	  __stats._M_flushes += __bin._M_flushes;
+	  __stats._M_thread_bytes += __bin._M_count * __stats._M_block_size;
+	}
+    }
+
+    _Central_bin& __central = _M_central[__which];
+    _Bin_lock __sentry(__central._M_mutex);
+    __stats._M_hits += __central._M_hits;
+    __stats._M_refills += __central._M_refills;
+    __stats._M_flushes += __central._M_flushes;
+    __stats._M_central_bytes = __central._M_count * __stats._M_block_size;
+    return __stats;
+  }
+#endif
+
   template<template <bool> class _PoolTp, bool _Thread>
     struct __common_pool
     {
@@ -434,22 +895,8 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
       static void
       _S_initialize_once()
       { 
-	static bool __init;
-	if (__builtin_expect(__init == false, false))
-	  {
-	    if (__gthread_active_p())
-	      {
-		// On some platforms, __gthread_once_t is an aggregate.
-		static __gthread_once_t __once = __GTHREAD_ONCE_INIT;
-		__gthread_once(&__once, _S_initialize);
-	      }
-
-	    // Double check initialization. May be necessary on some
-	    // systems for proper construction when not compiling with
-	    // thread flags.
-	    _S_get_pool()._M_initialize_once(); 
-	    __init = true;
-	  }
+	static __once_flag __once;
+	__call_once(__once, _S_initialize);
       }
     };
 #endif
@@ -529,22 +976,8 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
       static void
       _S_initialize_once()
       { 
-	static bool __init;
-	if (__builtin_expect(__init == false, false))
-	  {
-	    if (__gthread_active_p())
-	      {
-		// On some platforms, __gthread_once_t is an aggregate.
-		static __gthread_once_t __once = __GTHREAD_ONCE_INIT;
-		__gthread_once(&__once, _S_initialize);
-	      }
-
-	    // Double check initialization. May be necessary on some
-	    // systems for proper construction when not compiling with
-	    // thread flags.
-	    _S_get_pool()._M_initialize_once(); 
-	    __init = true;
-	  }
+	static __once_flag __once;
+	__call_once(__once, _S_initialize);
       }
     };
 #endif
@@ -684,30 +1117,9 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	  return static_cast<_Tp*>(__ret);
 	}
       
-      // Round up to power of 2 and figure out which bin to use.
-      const size_t __which = __pool._M_get_binmap(__bytes);
-      const size_t __thread_id = __pool._M_get_thread_id();
-      
-      // Find out if we have blocks on our freelist.  If so, go ahead
-      // and use them directly without having to lock anything.
-      char* __c;
-      typedef typename __pool_type::_Bin_record _Bin_record;
-      const _Bin_record& __bin = __pool._M_get_bin(__which);
-      if (__bin._M_first[__thread_id])
-	{
-	  // Already reserved.
-	  typedef typename __pool_type::_Block_record _Block_record;
-	  _Block_record* __block_record = __bin._M_first[__thread_id];
-	  __bin._M_first[__thread_id] = __block_record->_M_next;
-	  
-	  __pool._M_adjust_freelist(__bin, __block_record, __thread_id);
-	  __c = reinterpret_cast<char*>(__block_record) + __pool._M_get_align();
-	}
-      else
-	{
-	  // Null, reserve.
-	  __c = __pool._M_reserve_block(__bytes, __thread_id);
-	}
+      // Find out if we have blocks on our freelist.  If so, the pool
+      // uses them directly without having to lock anything.
+      char* __c = __pool._M_allocate_block(__bytes);
       return static_cast<_Tp*>(static_cast<void*>(__c));
     }
   
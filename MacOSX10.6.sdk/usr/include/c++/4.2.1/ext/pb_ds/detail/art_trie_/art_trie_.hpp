@@ -0,0 +1,512 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file art_trie_.hpp
+ * Contains an implementation class for an adaptive radix trie.
+ */
+
+/*
+ * Adaptive radix tree:
+ * Viktor Leis, Alfons Kemper, Thomas Neumann,
+ *    The Adaptive Radix Tree: ARTful Indexing for Main-Memory
+ *    Databases, ICDE 2013.
+ */
+
+#include <ext/pb_ds/tag_and_trait.hpp>
+#include <ext/pb_ds/exception.hpp>
+#include <ext/pb_ds/detail/types_traits.hpp>
+#include <ext/pb_ds/detail/type_utils.hpp>
+#include <ext/pb_ds/detail/art_trie_/node.hpp>
+#include <ext/pb_ds/detail/art_trie_/point_iterators.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+#define PB_DS_CLASS_T_DEC \
+    template<typename Key, typename Mapped, typename Node_And_It_Traits, \
+	     typename Allocator>
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+#define PB_DS_CLASS_NAME art_trie_data_
+#endif 
+
+#ifdef PB_DS_DATA_FALSE_INDICATOR
+#define PB_DS_CLASS_NAME art_trie_no_data_
+#endif 
+
+#define PB_DS_CLASS_C_DEC \
+    PB_DS_CLASS_NAME<Key, Mapped, Node_And_It_Traits, Allocator>
+
+#define PB_DS_TYPES_TRAITS_C_DEC \
+    types_traits<Key, Mapped, Allocator, false>
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+#define PB_DS_V2F(X) (X).first
+#define PB_DS_V2S(X) (X).second
+#endif 
+
+#ifdef PB_DS_DATA_FALSE_INDICATOR
+#define PB_DS_V2F(X) (X)
+#define PB_DS_V2S(X) Mapped_Data()
+#endif 
+
+#define PB_DS_STATIC_ASSERT(UNIQUE, E) \
+    typedef static_assert_dumclass<sizeof(static_assert<(bool)(E)>)> \
+    UNIQUE##static_assert_type
+
+    // Adaptive radix trie. Inner nodes grow and shrink between 4, 16,
+    // 48 and 256 children, so sparse branches take little room and
+    // dense ones are indexed directly. Keys are compressed
+    // optimistically: a node records only the key position it branches
+    // on, and a lookup compares the full key once, at the leaf it
+    // reaches. Leaves are threaded in key order; they never move, so
+    // modifications do not invalidate iterators to other values.
+    // e_access_traits::max_size may not exceed 256.
+    template<typename Key,
+	     typename Mapped,
+	     typename Node_And_It_Traits,
+	     typename Allocator>
+    class PB_DS_CLASS_NAME :
+      public Node_And_It_Traits::e_access_traits,
+      public Node_And_It_Traits::node_update,
+      public PB_DS_TYPES_TRAITS_C_DEC
+    {
+    private:
+      typedef PB_DS_TYPES_TRAITS_C_DEC traits_base;
+
+      typedef typename Node_And_It_Traits::e_access_traits e_access_traits_base;
+
+      typedef typename e_access_traits_base::const_iterator const_e_iterator;
+
+      typedef art_trie_node_<Allocator> node;
+      typedef typename node::node_pointer node_pointer;
+
+      typedef art_trie_list_node_<Allocator> list_node;
+      typedef typename list_node::list_node_pointer list_node_pointer;
+      typedef typename Allocator::template rebind<list_node>::other head_allocator;
+
+      typedef art_trie_leaf_<typename traits_base::value_type, Allocator> leaf;
+      typedef typename Allocator::template rebind<leaf>::other leaf_allocator;
+      typedef typename leaf_allocator::pointer leaf_pointer;
+      typedef typename leaf_allocator::const_pointer const_leaf_pointer;
+
+      typedef art_trie_inner_node_<Allocator> inner_node;
+      typedef typename Allocator::template rebind<inner_node>::other::pointer inner_node_pointer;
+
+      typedef art_trie_node4_<Allocator> node4;
+      typedef typename Allocator::template rebind<node4>::other node4_allocator;
+      typedef typename node4_allocator::pointer node4_pointer;
+
+      typedef art_trie_node16_<Allocator> node16;
+      typedef typename Allocator::template rebind<node16>::other node16_allocator;
+      typedef typename node16_allocator::pointer node16_pointer;
+
+      typedef art_trie_node48_<Allocator> node48;
+      typedef typename Allocator::template rebind<node48>::other node48_allocator;
+      typedef typename node48_allocator::pointer node48_pointer;
+
+      typedef art_trie_node256_<Allocator> node256;
+      typedef typename Allocator::template rebind<node256>::other node256_allocator;
+      typedef typename node256_allocator::pointer node256_pointer;
+
+      typedef
+      typename Node_And_It_Traits::null_node_update_pointer
+      null_node_update_pointer;
+
+      enum
+	{
+	  null_update = is_same<
+	  typename Node_And_It_Traits::node_update*,
+	  null_node_update_pointer>::value
+	};
+
+      PB_DS_STATIC_ASSERT(art_trie_null_update, null_update);
+
+      PB_DS_STATIC_ASSERT(art_trie_byte_positions,
+			  e_access_traits_base::max_size <= 256);
+
+    public:
+      typedef art_trie_tag container_category;
+      typedef Allocator allocator;
+      typedef typename Allocator::size_type size_type;
+      typedef typename Allocator::difference_type difference_type;
+
+      typedef typename traits_base::key_type key_type;
+      typedef typename traits_base::key_pointer key_pointer;
+      typedef typename traits_base::const_key_pointer const_key_pointer;
+      typedef typename traits_base::key_reference key_reference;
+      typedef typename traits_base::const_key_reference const_key_reference;
+      typedef typename traits_base::mapped_type mapped_type;
+      typedef typename traits_base::mapped_pointer mapped_pointer;
+      typedef typename traits_base::const_mapped_pointer const_mapped_pointer;
+      typedef typename traits_base::mapped_reference mapped_reference;
+      typedef typename traits_base::const_mapped_reference const_mapped_reference;
+      typedef typename traits_base::value_type value_type;
+      typedef typename traits_base::pointer pointer;
+      typedef typename traits_base::const_pointer const_pointer;
+      typedef typename traits_base::reference reference;
+      typedef typename traits_base::const_reference const_reference;
+
+      typedef
+      art_trie_const_it_<
+	value_type,
+	pointer,
+	const_pointer,
+	reference,
+	const_reference,
+	Allocator>
+      const_iterator;
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+      typedef
+      art_trie_it_<
+	value_type,
+	pointer,
+	const_pointer,
+	reference,
+	const_reference,
+	Allocator>
+      iterator;
+#else 
+      typedef const_iterator iterator;
+#endif 
+
+      typedef const_iterator const_point_iterator;
+
+      typedef iterator point_iterator;
+
+      typedef typename Node_And_It_Traits::e_access_traits e_access_traits;
+
+      typedef typename Node_And_It_Traits::node_update node_update;
+
+      PB_DS_CLASS_NAME();
+
+      PB_DS_CLASS_NAME(const e_access_traits&);
+
+      PB_DS_CLASS_NAME(const PB_DS_CLASS_C_DEC&);
+
+      void
+      swap(PB_DS_CLASS_C_DEC&);
+
+      ~PB_DS_CLASS_NAME();
+
+      inline bool
+      empty() const;
+
+      inline size_type
+      size() const;
+
+      inline size_type
+      max_size() const;
+
+      e_access_traits& 
+      get_e_access_traits();
+
+      const e_access_traits& 
+      get_e_access_traits() const;
+
+      node_update& 
+      get_node_update();
+
+      const node_update& 
+      get_node_update() const;
+
+      inline std::pair<point_iterator, bool>
+      insert(const_reference);
+
+      inline mapped_reference
+      operator[](const_key_reference r_key)
+      {
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+	return insert(std::make_pair(r_key, mapped_type())).first->second;
+#else 
+	insert(r_key);
+	return traits_base::s_null_mapped;
+#endif 
+      }
+
+      inline point_iterator
+      find(const_key_reference);
+
+      inline const_point_iterator
+      find(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).find(r_key); }
+
+      inline point_iterator
+      lower_bound(const_key_reference);
+
+      inline const_point_iterator
+      lower_bound(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).lower_bound(r_key); }
+
+      inline point_iterator
+      upper_bound(const_key_reference);
+
+      inline const_point_iterator
+      upper_bound(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).upper_bound(r_key); }
+
+      // Returns the range of values whose keys start with r_key.
+      std::pair<iterator, iterator>
+      prefix_range(const_key_reference r_key);
+
+      std::pair<const_iterator, const_iterator>
+      prefix_range(const_key_reference r_key) const
+      {
+	std::pair<iterator, iterator> ret =
+	  const_cast<PB_DS_CLASS_C_DEC&>(*this).prefix_range(r_key);
+	return std::make_pair(const_iterator(ret.first),
+			      const_iterator(ret.second));
+      }
+
+      // Returns the value with the longest key that is a prefix of
+      // r_key (r_key itself included), or end().
+      point_iterator
+      longest_prefix_match(const_key_reference r_key);
+
+      const_point_iterator
+      longest_prefix_match(const_key_reference r_key) const
+      {
+	return const_cast<PB_DS_CLASS_C_DEC&>(*this).longest_prefix_match(r_key);
+      }
+
+      void
+      clear();
+
+      inline bool
+      erase(const_key_reference);
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+      inline iterator
+      erase(iterator);
+#endif 
+
+      inline const_iterator
+      erase(const_iterator);
+
+      template<typename Pred>
+      inline size_type
+      erase_if(Pred);
+
+      void
+      join(PB_DS_CLASS_C_DEC&);
+
+      void
+      split(const_key_reference, PB_DS_CLASS_C_DEC&);
+
+      inline iterator
+      begin();
+
+      inline const_iterator
+      begin() const;
+
+      inline iterator
+      end();
+
+      inline const_iterator
+      end() const;
+
+    protected:
+
+      template<typename It>
+      void
+      copy_from_range(It, It);
+
+    private:
+      // Where a key belongs: the slot holding the subtree it shares a
+      // prefix with, and the position at which it leaves that subtree.
+      struct locus
+      {
+	node_pointer* m_p_slot;
+	// A leaf sharing the longest prefix with the key.
+	leaf_pointer m_p_leaf;
+	size_type m_pos;
+	size_type m_size;
+	// As set by common_prefix for the key and m_p_leaf's key.
+	int m_cmp;
+      };
+
+      void
+      initialize();
+
+      inline static const_key_reference
+      leaf_key(const_leaf_pointer);
+
+      inline size_type
+      key_size(const_key_reference) const;
+
+      inline size_type
+      e_pos_at(const_e_iterator&, size_type&, size_type) const;
+
+      inline size_type
+      key_e_pos(const_key_reference, size_type) const;
+
+      inline size_type
+      common_prefix(const_key_reference, const_key_reference, int&) const;
+
+      inline node_pointer*
+      next_slot(inner_node_pointer, const_e_iterator&, size_type&,
+		size_type) const;
+
+      inline leaf_pointer
+      probe(const_key_reference, size_type) const;
+
+      void
+      locate(const_key_reference, locus&) const;
+
+      inline static node_pointer*
+      child_slot(inner_node_pointer, size_type);
+
+      inline static node_pointer
+      first_child(inner_node_pointer);
+
+      inline static node_pointer
+      last_child(inner_node_pointer);
+
+      inline static node_pointer
+      next_child(inner_node_pointer, size_type);
+
+      inline static node_pointer
+      prev_child(inner_node_pointer, size_type);
+
+      inline static leaf_pointer
+      leftmost(node_pointer);
+
+      inline static leaf_pointer
+      rightmost(node_pointer);
+
+      inline static size_type
+      num_entries(inner_node_pointer);
+
+      static inner_node_pointer
+      new_inner(unsigned char, size_type);
+
+      static void
+      delete_inner(inner_node_pointer);
+
+      inline static void
+      delete_leaf(leaf_pointer);
+
+      static void
+      delete_subtree(node_pointer);
+
+      static void
+      insert_child(inner_node_pointer, size_type, node_pointer);
+
+      static void
+      remove_child(inner_node_pointer, size_type);
+
+      static void
+      move_entries(inner_node_pointer, inner_node_pointer);
+
+      static inner_node_pointer
+      grow_reserve(inner_node_pointer);
+
+      static void
+      add_child(node_pointer&, size_type, node_pointer, inner_node_pointer);
+
+      static void
+      shrink(node_pointer&);
+
+      inline static void
+      link_before(list_node_pointer, leaf_pointer);
+
+      inline static void
+      link_after(list_node_pointer, leaf_pointer);
+
+      inline static void
+      unlink(leaf_pointer);
+
+      inner_node_pointer
+      insert_reserve(const locus&);
+
+      void
+      insert_commit(const locus&, leaf_pointer, inner_node_pointer);
+
+      leaf_pointer
+      detach(const_key_reference);
+
+      void
+      remove_entry(node_pointer&, bool, size_type);
+
+      void
+      move_leaf(leaf_pointer, PB_DS_CLASS_C_DEC&);
+
+#ifdef _GLIBCXX_DEBUG
+      void
+      assert_valid() const;
+
+      size_type
+      assert_node_valid(node_pointer, size_type) const;
+#endif 
+
+    private:
+      static head_allocator s_head_allocator;
+      static leaf_allocator s_leaf_allocator;
+      static node4_allocator s_node4_allocator;
+      static node16_allocator s_node16_allocator;
+      static node48_allocator s_node48_allocator;
+      static node256_allocator s_node256_allocator;
+
+      list_node_pointer m_p_head;
+
+      node_pointer m_p_root;
+
+      size_type m_size;
+    };
+
+#include <ext/pb_ds/detail/art_trie_/constructors_destructor_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/info_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/policy_access_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/iterators_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/node_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/find_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/insert_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/erase_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/prefix_search_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/split_join_fn_imps.hpp>
+#include <ext/pb_ds/detail/art_trie_/debug_fn_imps.hpp>
+
+#undef PB_DS_CLASS_C_DEC
+#undef PB_DS_CLASS_T_DEC
+#undef PB_DS_CLASS_NAME
+#undef PB_DS_TYPES_TRAITS_C_DEC
+#undef PB_DS_V2F
+#undef PB_DS_V2S
+#undef PB_DS_STATIC_ASSERT
+
+  } // namespace detail
+} // namespace pb_ds
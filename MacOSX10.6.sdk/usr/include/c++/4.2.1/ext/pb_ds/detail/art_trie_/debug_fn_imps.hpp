@@ -0,0 +1,109 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file debug_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+#ifdef _GLIBCXX_DEBUG
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+assert_valid() const
+{
+  _GLIBCXX_DEBUG_ASSERT(m_p_head->m_kind == art_trie_head_kind);
+  size_type count = 0;
+  for (list_node_pointer p_nd = m_p_head->m_p_next; p_nd != m_p_head;
+       p_nd = p_nd->m_p_next)
+    {
+      _GLIBCXX_DEBUG_ASSERT(p_nd->m_kind == art_trie_leaf_kind);
+      _GLIBCXX_DEBUG_ASSERT(p_nd->m_p_next->m_p_prev == p_nd);
+      const_leaf_pointer p_lf = static_cast<const_leaf_pointer>(p_nd);
+      if (p_nd->m_p_next != m_p_head)
+	{
+	  int cmp;
+	  common_prefix(leaf_key(p_lf),
+			leaf_key(static_cast<const_leaf_pointer>(p_nd->m_p_next)),
+			cmp);
+	  _GLIBCXX_DEBUG_ASSERT(cmp < 0);
+	}
+      _GLIBCXX_DEBUG_ASSERT(probe(leaf_key(p_lf), key_size(leaf_key(p_lf)))
+			    == p_lf);
+      ++count;
+    }
+  _GLIBCXX_DEBUG_ASSERT(count == m_size);
+  _GLIBCXX_DEBUG_ASSERT((m_p_root == NULL) == (m_size == 0));
+  if (m_p_root != NULL)
+    _GLIBCXX_DEBUG_ASSERT(assert_node_valid(m_p_root, 0) == m_size);
+}
+
+// Checks the subtree of p_nd, whose depth is at least min_depth, and
+// returns its number of leaves.
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+assert_node_valid(node_pointer p_nd, size_type min_depth) const
+{
+  if (p_nd->m_kind == art_trie_leaf_kind)
+    return 1;
+
+  inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+  const size_type depth = p_inner->m_depth;
+  _GLIBCXX_DEBUG_ASSERT(depth >= min_depth);
+  _GLIBCXX_DEBUG_ASSERT(num_entries(p_inner) >= 2);
+
+  size_type count = 0;
+  if (p_inner->m_p_end != NULL)
+    {
+      _GLIBCXX_DEBUG_ASSERT(p_inner->m_p_end->m_kind == art_trie_leaf_kind);
+      _GLIBCXX_DEBUG_ASSERT(key_size(leaf_key(static_cast<leaf_pointer>(p_inner->m_p_end))) == depth);
+      ++count;
+    }
+
+  size_type num = 0;
+  size_type prev_e = 0;
+  for (node_pointer p_child = first_child(p_inner); p_child != NULL;
+       p_child = next_child(p_inner, prev_e))
+    {
+      const size_type e = key_e_pos(leaf_key(leftmost(p_child)), depth);
+      _GLIBCXX_DEBUG_ASSERT(num == 0 || e > prev_e);
+      _GLIBCXX_DEBUG_ASSERT(*child_slot(p_inner, e) == p_child);
+      count += assert_node_valid(p_child, depth + 1);
+      prev_e = e;
+      ++num;
+    }
+  _GLIBCXX_DEBUG_ASSERT(num == p_inner->m_num_children);
+  return count;
+}
+
+#endif 
+
@@ -0,0 +1,186 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file erase_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+inline bool
+PB_DS_CLASS_C_DEC::
+erase(const_key_reference r_key)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  leaf_pointer p_lf = detach(r_key);
+  if (p_lf == NULL)
+    return false;
+  delete_leaf(p_lf);
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  return true;
+}
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::iterator
+PB_DS_CLASS_C_DEC::
+erase(iterator it)
+{
+  if (it == end())
+    return it;
+  iterator ret_it = it;
+  ++ret_it;
+  erase(PB_DS_V2F(*it));
+  return ret_it;
+}
+#endif 
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::const_iterator
+PB_DS_CLASS_C_DEC::
+erase(const_iterator it)
+{
+  if (it == end())
+    return it;
+  const_iterator ret_it = it;
+  ++ret_it;
+  erase(PB_DS_V2F(*it));
+  return ret_it;
+}
+
+PB_DS_CLASS_T_DEC
+template<typename Pred>
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+erase_if(Pred pred)
+{
+  size_type num_ersd = 0;
+  list_node_pointer p_nd = m_p_head->m_p_next;
+  while (p_nd != m_p_head)
+    {
+      leaf_pointer p_lf = static_cast<leaf_pointer>(p_nd);
+      p_nd = p_nd->m_p_next;
+      if (pred(p_lf->m_value))
+	{
+	  detach(leaf_key(p_lf));
+	  delete_leaf(p_lf);
+	  ++num_ersd;
+	}
+    }
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  return num_ersd;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+clear()
+{
+  if (m_p_root != NULL)
+    delete_subtree(m_p_root);
+  m_p_root = NULL;
+  m_size = 0;
+  initialize();
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+}
+
+// Takes the leaf holding r_key, if any, out of the trie and the leaf
+// list, without freeing it.
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::leaf_pointer
+PB_DS_CLASS_C_DEC::
+detach(const_key_reference r_key)
+{
+  if (m_p_root == NULL)
+    return NULL;
+
+  const size_type size_ = key_size(r_key);
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  node_pointer* p_parent_slot = NULL;
+  node_pointer* p_slot = &m_p_root;
+  bool at_end = false;
+  size_type e = 0;
+  while ((*p_slot)->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(*p_slot);
+      if (size_ < p_inner->m_depth)
+	return NULL;
+      p_parent_slot = p_slot;
+      at_end = size_ == p_inner->m_depth;
+      if (at_end)
+	p_slot = &p_inner->m_p_end;
+      else
+	{
+	  e = e_pos_at(it, pos, p_inner->m_depth);
+	  p_slot = child_slot(p_inner, e);
+	}
+      if (p_slot == NULL || *p_slot == NULL)
+	return NULL;
+    }
+
+  leaf_pointer p_lf = static_cast<leaf_pointer>(*p_slot);
+  int cmp;
+  common_prefix(r_key, leaf_key(p_lf), cmp);
+  if (cmp != 0)
+    return NULL;
+
+  if (p_parent_slot == NULL)
+    m_p_root = NULL;
+  else
+    remove_entry(*p_parent_slot, at_end, e);
+  unlink(p_lf);
+  --m_size;
+  return p_lf;
+}
+
+// Removes the end entry (at_end) or the child under e from the node
+// in r_slot. A node left with a single entry is replaced by it; the
+// skipped elements need no merging, as they are not stored.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+remove_entry(node_pointer& r_slot, bool at_end, size_type e)
+{
+  inner_node_pointer p_nd = static_cast<inner_node_pointer>(r_slot);
+  if (at_end)
+    p_nd->m_p_end = NULL;
+  else
+    remove_child(p_nd, e);
+
+  if (num_entries(p_nd) == 1)
+    {
+      r_slot = p_nd->m_p_end != NULL ? p_nd->m_p_end : first_child(p_nd);
+      delete_inner(p_nd);
+      return;
+    }
+  shrink(r_slot);
+}
+
@@ -0,0 +1,236 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file find_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::const_key_reference
+PB_DS_CLASS_C_DEC::
+leaf_key(const_leaf_pointer p_lf)
+{ return PB_DS_V2F(p_lf->m_value); }
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+key_size(const_key_reference r_key) const
+{
+  return std::distance(e_access_traits_base::begin(r_key),
+		       e_access_traits_base::end(r_key));
+}
+
+// Advances r_it, which designates element r_pos of a key, to element
+// pos, and returns that element's position.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+e_pos_at(const_e_iterator& r_it, size_type& r_pos, size_type pos) const
+{
+  _GLIBCXX_DEBUG_ASSERT(r_pos <= pos);
+  std::advance(r_it, pos - r_pos);
+  r_pos = pos;
+  return e_access_traits_base::e_pos(*r_it);
+}
+
+// Returns the length of the common prefix of r_key and r_other_key.
+// r_cmp is 0 if the keys are equal; otherwise its sign orders r_key
+// relative to r_other_key, and it is 1 or -1 if one key is a prefix
+// of the other and 2 or -2 if they differ at the returned position.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+common_prefix(const_key_reference r_key, const_key_reference r_other_key,
+	      int& r_cmp) const
+{
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  const const_e_iterator end_it = e_access_traits_base::end(r_key);
+  const_e_iterator other_it = e_access_traits_base::begin(r_other_key);
+  const const_e_iterator other_end_it = e_access_traits_base::end(r_other_key);
+  size_type pos = 0;
+  while (it != end_it && other_it != other_end_it)
+    {
+      const size_type e = e_access_traits_base::e_pos(*it);
+      const size_type other_e = e_access_traits_base::e_pos(*other_it);
+      if (e != other_e)
+	{
+	  r_cmp = e < other_e ? -2 : 2;
+	  return pos;
+	}
+      ++it;
+      ++other_it;
+      ++pos;
+    }
+  r_cmp = it == end_it ? (other_it == other_end_it ? 0 : -1) : 1;
+  return pos;
+}
+
+// Returns the slot below p_nd that a key of size_ continues in, or
+// NULL. r_it and r_pos track the key's elements.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer*
+PB_DS_CLASS_C_DEC::
+next_slot(inner_node_pointer p_nd, const_e_iterator& r_it, size_type& r_pos,
+	  size_type size_) const
+{
+  _GLIBCXX_DEBUG_ASSERT(size_ >= p_nd->m_depth);
+  if (size_ == p_nd->m_depth)
+    return p_nd->m_p_end == NULL ? NULL : &p_nd->m_p_end;
+  return child_slot(p_nd, e_pos_at(r_it, r_pos, p_nd->m_depth));
+}
+
+// Follows r_key down the trie, without checking the skipped
+// elements, and returns a leaf of the deepest subtree reached. The
+// root must not be NULL.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::leaf_pointer
+PB_DS_CLASS_C_DEC::
+probe(const_key_reference r_key, size_type size_) const
+{
+  _GLIBCXX_DEBUG_ASSERT(m_p_root != NULL);
+  node_pointer p_nd = m_p_root;
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  while (p_nd->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+      if (size_ < p_inner->m_depth)
+	return leftmost(p_nd);
+      node_pointer* p_slot = next_slot(p_inner, it, pos, size_);
+      if (p_slot == NULL)
+	return leftmost(p_nd);
+      p_nd = *p_slot;
+    }
+  return static_cast<leaf_pointer>(p_nd);
+}
+
+// Finds where r_key is or would be.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+locate(const_key_reference r_key, locus& r_locus) const
+{
+  r_locus.m_size = key_size(r_key);
+  r_locus.m_p_slot = const_cast<node_pointer*>(&m_p_root);
+  if (m_p_root == NULL)
+    {
+      r_locus.m_p_leaf = NULL;
+      r_locus.m_pos = 0;
+      r_locus.m_cmp = -1;
+      return;
+    }
+
+  // Any leaf reached by following r_key shares with r_key every
+  // element that r_key shares with the trie.
+  r_locus.m_p_leaf = probe(r_key, r_locus.m_size);
+  r_locus.m_pos = common_prefix(r_key, leaf_key(r_locus.m_p_leaf),
+				r_locus.m_cmp);
+  if (r_locus.m_cmp == 0)
+    return;
+
+  // Descend to the subtree that r_key leaves at m_pos.
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  node_pointer* p_slot = r_locus.m_p_slot;
+  while ((*p_slot)->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(*p_slot);
+      if (p_inner->m_depth >= r_locus.m_pos)
+	break;
+      p_slot = child_slot(p_inner, e_pos_at(it, pos, p_inner->m_depth));
+      _GLIBCXX_DEBUG_ASSERT(p_slot != NULL);
+    }
+  r_locus.m_p_slot = p_slot;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+find(const_key_reference r_key)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  if (m_p_root == NULL)
+    return end();
+
+  leaf_pointer p_lf = probe(r_key, key_size(r_key));
+  int cmp;
+  common_prefix(r_key, leaf_key(p_lf), cmp);
+  return cmp == 0 ? point_iterator(p_lf) : end();
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+lower_bound(const_key_reference r_key)
+{
+  if (m_p_root == NULL)
+    return end();
+
+  locus l;
+  locate(r_key, l);
+  if (l.m_cmp == 0)
+    return point_iterator(l.m_p_leaf);
+
+  node_pointer p_sub = *l.m_p_slot;
+  if (p_sub->m_kind == art_trie_leaf_kind
+      || static_cast<inner_node_pointer>(p_sub)->m_depth > l.m_pos)
+    // Every key in p_sub compares with r_key as the probed leaf does.
+    return l.m_cmp < 0 ? point_iterator(leftmost(p_sub))
+      : point_iterator(rightmost(p_sub)->m_p_next);
+
+  // r_key branches off p_sub at an element p_sub has no child for.
+  if (l.m_size == l.m_pos)
+    return point_iterator(leftmost(p_sub));
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  node_pointer p_next =
+    next_child(static_cast<inner_node_pointer>(p_sub),
+	       e_pos_at(it, pos, l.m_pos));
+  return p_next != NULL ? point_iterator(leftmost(p_next))
+    : point_iterator(rightmost(p_sub)->m_p_next);
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+upper_bound(const_key_reference r_key)
+{
+  point_iterator it = lower_bound(r_key);
+  if (it != end())
+    {
+      int cmp;
+      common_prefix(r_key, PB_DS_V2F(*it), cmp);
+      if (cmp == 0)
+	++it;
+    }
+  return it;
+}
+
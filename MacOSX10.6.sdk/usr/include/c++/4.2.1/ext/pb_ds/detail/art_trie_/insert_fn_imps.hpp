@@ -0,0 +1,165 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file insert_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+inline std::pair<typename PB_DS_CLASS_C_DEC::point_iterator, bool>
+PB_DS_CLASS_C_DEC::
+insert(const_reference r_val)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  locus l;
+  locate(PB_DS_V2F(r_val), l);
+  if (l.m_cmp == 0)
+    return std::make_pair(point_iterator(l.m_p_leaf), false);
+
+  leaf_pointer p_new = s_leaf_allocator.allocate(1);
+  try
+    {
+      new (p_new) leaf(r_val);
+    }
+  catch(...)
+    {
+      s_leaf_allocator.deallocate(p_new, 1);
+      __throw_exception_again;
+    }
+
+  inner_node_pointer p_reserved;
+  try
+    {
+      p_reserved = insert_reserve(l);
+    }
+  catch(...)
+    {
+      delete_leaf(p_new);
+      __throw_exception_again;
+    }
+  insert_commit(l, p_new, p_reserved);
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  return std::make_pair(point_iterator(p_new), true);
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+key_e_pos(const_key_reference r_key, size_type pos) const
+{
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type it_pos = 0;
+  return e_pos_at(it, it_pos, pos);
+}
+
+// Allocates the node that inserting at r_locus needs, if any, so that
+// insert_commit cannot fail.
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::inner_node_pointer
+PB_DS_CLASS_C_DEC::
+insert_reserve(const locus& r_locus)
+{
+  node_pointer p_sub = *r_locus.m_p_slot;
+  if (p_sub == NULL)
+    return NULL;
+  if (p_sub->m_kind == art_trie_leaf_kind
+      || static_cast<inner_node_pointer>(p_sub)->m_depth > r_locus.m_pos)
+    return new_inner(art_trie_node4_kind, r_locus.m_pos);
+  if (r_locus.m_size == r_locus.m_pos)
+    return NULL;
+  return grow_reserve(static_cast<inner_node_pointer>(p_sub));
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+insert_commit(const locus& r_locus, leaf_pointer p_new,
+	      inner_node_pointer p_reserved)
+{
+  node_pointer& r_slot = *r_locus.m_p_slot;
+  const size_type pos = r_locus.m_pos;
+  if (r_slot == NULL)
+    {
+      r_slot = p_new;
+      link_before(m_p_head, p_new);
+    }
+  else if (r_slot->m_kind == art_trie_leaf_kind
+	   || static_cast<inner_node_pointer>(r_slot)->m_depth > pos)
+    {
+      // The key and the subtree in r_slot part at pos; hang both off
+      // a new node branching there.
+      node_pointer p_sub = r_slot;
+      if (r_locus.m_cmp < 0)
+	link_before(leftmost(p_sub), p_new);
+      else
+	link_after(rightmost(p_sub), p_new);
+
+      inner_node_pointer p_nd = p_reserved;
+      if (r_locus.m_cmp == 1)
+	p_nd->m_p_end = p_sub;
+      else
+	insert_child(p_nd, key_e_pos(leaf_key(r_locus.m_p_leaf), pos), p_sub);
+      if (r_locus.m_cmp == -1)
+	p_nd->m_p_end = p_new;
+      else
+	insert_child(p_nd, key_e_pos(leaf_key(p_new), pos), p_new);
+      r_slot = p_nd;
+    }
+  else
+    {
+      // The node in r_slot branches at pos, and has no entry for the
+      // key.
+      inner_node_pointer p_nd = static_cast<inner_node_pointer>(r_slot);
+      if (r_locus.m_size == pos)
+	{
+	  _GLIBCXX_DEBUG_ASSERT(p_nd->m_p_end == NULL);
+	  link_before(leftmost(first_child(p_nd)), p_new);
+	  p_nd->m_p_end = p_new;
+	}
+      else
+	{
+	  const size_type e = key_e_pos(leaf_key(p_new), pos);
+	  node_pointer p_next = next_child(p_nd, e);
+	  if (p_next != NULL)
+	    link_before(leftmost(p_next), p_new);
+	  else
+	    {
+	      node_pointer p_prev = prev_child(p_nd, e);
+	      if (p_prev == NULL)
+		p_prev = p_nd->m_p_end;
+	      link_after(rightmost(p_prev), p_new);
+	    }
+	  add_child(r_slot, e, p_new, p_reserved);
+	}
+    }
+  ++m_size;
+}
+
@@ -0,0 +1,210 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file node.hpp
+ * Contains the nodes of an adaptive radix trie.
+ */
+
+#ifndef PB_DS_ART_TRIE_NODE_HPP
+#define PB_DS_ART_TRIE_NODE_HPP
+
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+    enum art_trie_node_kind
+      {
+	art_trie_head_kind,
+	art_trie_leaf_kind,
+	art_trie_node4_kind,
+	art_trie_node16_kind,
+	art_trie_node48_kind,
+	art_trie_node256_kind
+      };
+
+    template<class Allocator>
+    struct art_trie_node_
+    {
+      typedef
+      typename Allocator::template rebind<
+      art_trie_node_<Allocator> >::other::pointer
+      node_pointer;
+
+      unsigned char m_kind;
+    };
+
+    // Leaves are threaded in key order on a circular list closed by
+    // the container's head, which gives iteration without touching the
+    // inner nodes.
+    template<class Allocator>
+    struct art_trie_list_node_ : public art_trie_node_<Allocator>
+    {
+      typedef
+      typename Allocator::template rebind<
+      art_trie_list_node_<Allocator> >::other::pointer
+      list_node_pointer;
+
+      list_node_pointer m_p_prev;
+
+      list_node_pointer m_p_next;
+    };
+
+    template<typename Value_Type, class Allocator>
+    struct art_trie_leaf_ : public art_trie_list_node_<Allocator>
+    {
+      explicit
+      art_trie_leaf_(const Value_Type& r_val) : m_value(r_val)
+      { this->m_kind = art_trie_leaf_kind; }
+
+      Value_Type m_value;
+    };
+
+    // Common part of the inner nodes. An inner node branches on the
+    // element at position m_depth of its keys; all keys below it agree
+    // on the elements before m_depth, which are not stored (they are
+    // checked against a leaf when needed). The key that ends exactly
+    // at m_depth, if any, hangs off m_p_end.
+    template<class Allocator>
+    struct art_trie_inner_node_ : public art_trie_node_<Allocator>
+    {
+      typedef typename Allocator::size_type size_type;
+
+      typedef typename art_trie_node_<Allocator>::node_pointer node_pointer;
+
+      size_type m_depth;
+
+      node_pointer m_p_end;
+
+      unsigned short m_num_children;
+    };
+
+    // Up to 4 children, keys sorted.
+    template<class Allocator>
+    struct art_trie_node4_ : public art_trie_inner_node_<Allocator>
+    {
+      enum
+	{
+	  capacity = 4
+	};
+
+      unsigned char m_a_keys[capacity];
+
+      typename art_trie_inner_node_<Allocator>::node_pointer
+      m_a_children[capacity];
+    };
+
+    // Up to 16 children, keys sorted and searched 16 at a time.
+    template<class Allocator>
+    struct art_trie_node16_ : public art_trie_inner_node_<Allocator>
+    {
+      enum
+	{
+	  capacity = 16
+	};
+
+      unsigned char m_a_keys[capacity];
+
+      typename art_trie_inner_node_<Allocator>::node_pointer
+      m_a_children[capacity];
+    };
+
+    // Up to 48 children, reached through a 256-entry index holding
+    // one plus the child's slot, or 0.
+    template<class Allocator>
+    struct art_trie_node48_ : public art_trie_inner_node_<Allocator>
+    {
+      enum
+	{
+	  capacity = 48
+	};
+
+      unsigned char m_a_index[256];
+
+      typename art_trie_inner_node_<Allocator>::node_pointer
+      m_a_children[capacity];
+    };
+
+    // A child pointer per element.
+    template<class Allocator>
+    struct art_trie_node256_ : public art_trie_inner_node_<Allocator>
+    {
+      enum
+	{
+	  capacity = 256
+	};
+
+      typename art_trie_inner_node_<Allocator>::node_pointer
+      m_a_children[capacity];
+    };
+
+    // Returns a mask with bit i set for each of the first num keys
+    // equal to key (Eq) or greater than key (!Eq).
+    template<bool Eq>
+    inline unsigned int
+    art_trie_match16(const unsigned char* a_keys, unsigned char key,
+		     unsigned int num)
+    {
+      _GLIBCXX_DEBUG_ASSERT(num <= 16);
+#ifdef __SSE2__
+      typedef char v16qi __attribute__((__vector_size__(16)));
+      v16qi keys;
+      __builtin_memcpy(&keys, a_keys, 16);
+      const char c = static_cast<char>(key);
+      v16qi needle = { c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c };
+      unsigned int mask;
+      if (Eq)
+	mask = __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpeqb128(keys,
+								    needle));
+      else
+	{
+	  // pcmpgtb compares signed bytes; flipping the top bit makes
+	  // it an unsigned comparison.
+	  const char s = static_cast<char>(0x80);
+	  const v16qi bias = { s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s };
+	  mask = __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpgtb128(keys ^ bias,
+								      needle ^ bias));
+	}
+      return mask & ((1u << num) - 1);
+#else
+      unsigned int mask = 0;
+      for (unsigned int i = 0; i < num; ++i)
+	if (Eq ? a_keys[i] == key : a_keys[i] > key)
+	  mask |= 1u << i;
+      return mask;
+#endif
+    }
+
+  } // namespace detail
+} // namespace pb_ds
+
+#endif // #ifndef PB_DS_ART_TRIE_NODE_HPP
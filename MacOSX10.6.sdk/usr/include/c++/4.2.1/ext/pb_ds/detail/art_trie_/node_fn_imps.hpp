@@ -0,0 +1,562 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file node_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer*
+PB_DS_CLASS_C_DEC::
+child_slot(inner_node_pointer p_nd, size_type e)
+{
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+      {
+	node4_pointer p_n4 = static_cast<node4_pointer>(p_nd);
+	for (size_type i = 0; i < p_nd->m_num_children; ++i)
+	  if (p_n4->m_a_keys[i] == e)
+	    return &p_n4->m_a_children[i];
+	return NULL;
+      }
+    case art_trie_node16_kind:
+      {
+	node16_pointer p_n16 = static_cast<node16_pointer>(p_nd);
+	const unsigned int mask =
+	  art_trie_match16<true>(p_n16->m_a_keys,
+				 static_cast<unsigned char>(e),
+				 p_nd->m_num_children);
+	return mask == 0 ? NULL : &p_n16->m_a_children[__builtin_ctz(mask)];
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_nd);
+	const unsigned char slot = p_n48->m_a_index[e];
+	return slot == 0 ? NULL : &p_n48->m_a_children[slot - 1];
+      }
+    default:
+      {
+	_GLIBCXX_DEBUG_ASSERT(p_nd->m_kind == art_trie_node256_kind);
+	node256_pointer p_n256 = static_cast<node256_pointer>(p_nd);
+	return p_n256->m_a_children[e] == NULL ? NULL : &p_n256->m_a_children[e];
+      }
+    }
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+first_child(inner_node_pointer p_nd)
+{ return next_child(p_nd, size_type(-1)); }
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+last_child(inner_node_pointer p_nd)
+{ return prev_child(p_nd, 256); }
+
+// Returns the child with the smallest element greater than e, taking
+// size_type(-1) as smaller than every element.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+next_child(inner_node_pointer p_nd, size_type e)
+{
+  const size_type num = p_nd->m_num_children;
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+      {
+	node4_pointer p_n4 = static_cast<node4_pointer>(p_nd);
+	for (size_type i = 0; i < num; ++i)
+	  if (e == size_type(-1) || p_n4->m_a_keys[i] > e)
+	    return p_n4->m_a_children[i];
+	return NULL;
+      }
+    case art_trie_node16_kind:
+      {
+	node16_pointer p_n16 = static_cast<node16_pointer>(p_nd);
+	if (e == size_type(-1))
+	  return num == 0 ? NULL : p_n16->m_a_children[0];
+	const unsigned int mask =
+	  art_trie_match16<false>(p_n16->m_a_keys,
+				  static_cast<unsigned char>(e), num);
+	return mask == 0 ? NULL : p_n16->m_a_children[__builtin_ctz(mask)];
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_nd);
+	for (size_type b = e + 1; b < 256; ++b)
+	  if (p_n48->m_a_index[b] != 0)
+	    return p_n48->m_a_children[p_n48->m_a_index[b] - 1];
+	return NULL;
+      }
+    default:
+      {
+	node256_pointer p_n256 = static_cast<node256_pointer>(p_nd);
+	for (size_type b = e + 1; b < 256; ++b)
+	  if (p_n256->m_a_children[b] != NULL)
+	    return p_n256->m_a_children[b];
+	return NULL;
+      }
+    }
+}
+
+// Returns the child with the largest element smaller than e.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+prev_child(inner_node_pointer p_nd, size_type e)
+{
+  size_type i = p_nd->m_num_children;
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+      {
+	node4_pointer p_n4 = static_cast<node4_pointer>(p_nd);
+	while (i > 0 && p_n4->m_a_keys[i - 1] >= e)
+	  --i;
+	return i == 0 ? NULL : p_n4->m_a_children[i - 1];
+      }
+    case art_trie_node16_kind:
+      {
+	node16_pointer p_n16 = static_cast<node16_pointer>(p_nd);
+	while (i > 0 && p_n16->m_a_keys[i - 1] >= e)
+	  --i;
+	return i == 0 ? NULL : p_n16->m_a_children[i - 1];
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_nd);
+	for (size_type b = e; b > 0; --b)
+	  if (p_n48->m_a_index[b - 1] != 0)
+	    return p_n48->m_a_children[p_n48->m_a_index[b - 1] - 1];
+	return NULL;
+      }
+    default:
+      {
+	node256_pointer p_n256 = static_cast<node256_pointer>(p_nd);
+	for (size_type b = e; b > 0; --b)
+	  if (p_n256->m_a_children[b - 1] != NULL)
+	    return p_n256->m_a_children[b - 1];
+	return NULL;
+      }
+    }
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::leaf_pointer
+PB_DS_CLASS_C_DEC::
+leftmost(node_pointer p_nd)
+{
+  while (p_nd->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+      p_nd = p_inner->m_p_end != NULL ? p_inner->m_p_end : first_child(p_inner);
+    }
+  return static_cast<leaf_pointer>(p_nd);
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::leaf_pointer
+PB_DS_CLASS_C_DEC::
+rightmost(node_pointer p_nd)
+{
+  while (p_nd->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+      node_pointer p_last = last_child(p_inner);
+      p_nd = p_last != NULL ? p_last : p_inner->m_p_end;
+    }
+  return static_cast<leaf_pointer>(p_nd);
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+num_entries(inner_node_pointer p_nd)
+{ return p_nd->m_num_children + (p_nd->m_p_end != NULL ? 1 : 0); }
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::inner_node_pointer
+PB_DS_CLASS_C_DEC::
+new_inner(unsigned char kind, size_type depth)
+{
+  inner_node_pointer p_nd;
+  switch(kind)
+    {
+    case art_trie_node4_kind:
+      p_nd = s_node4_allocator.allocate(1);
+      break;
+    case art_trie_node16_kind:
+      {
+	node16_pointer p_n16 = s_node16_allocator.allocate(1);
+	// The keys are searched 16 at a time, so give the unused ones
+	// a defined value.
+	std::fill(p_n16->m_a_keys, p_n16->m_a_keys + node16::capacity, 0);
+	p_nd = p_n16;
+	break;
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = s_node48_allocator.allocate(1);
+	std::fill(p_n48->m_a_index, p_n48->m_a_index + 256, 0);
+	p_nd = p_n48;
+	break;
+      }
+    default:
+      {
+	_GLIBCXX_DEBUG_ASSERT(kind == art_trie_node256_kind);
+	node256_pointer p_n256 = s_node256_allocator.allocate(1);
+	std::fill(p_n256->m_a_children, p_n256->m_a_children + 256,
+		  node_pointer(NULL));
+	p_nd = p_n256;
+	break;
+      }
+    }
+  p_nd->m_kind = kind;
+  p_nd->m_depth = depth;
+  p_nd->m_p_end = NULL;
+  p_nd->m_num_children = 0;
+  return p_nd;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+delete_inner(inner_node_pointer p_nd)
+{
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+      s_node4_allocator.deallocate(static_cast<node4_pointer>(p_nd), 1);
+      break;
+    case art_trie_node16_kind:
+      s_node16_allocator.deallocate(static_cast<node16_pointer>(p_nd), 1);
+      break;
+    case art_trie_node48_kind:
+      s_node48_allocator.deallocate(static_cast<node48_pointer>(p_nd), 1);
+      break;
+    default:
+      s_node256_allocator.deallocate(static_cast<node256_pointer>(p_nd), 1);
+      break;
+    }
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+delete_leaf(leaf_pointer p_lf)
+{
+  p_lf->~leaf();
+  s_leaf_allocator.deallocate(p_lf, 1);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+delete_subtree(node_pointer p_nd)
+{
+  if (p_nd->m_kind == art_trie_leaf_kind)
+    {
+      delete_leaf(static_cast<leaf_pointer>(p_nd));
+      return;
+    }
+
+  inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+  if (p_inner->m_p_end != NULL)
+    delete_subtree(p_inner->m_p_end);
+  const size_type num = p_inner->m_num_children;
+  switch(p_inner->m_kind)
+    {
+    case art_trie_node4_kind:
+      for (size_type i = 0; i < num; ++i)
+	delete_subtree(static_cast<node4_pointer>(p_inner)->m_a_children[i]);
+      break;
+    case art_trie_node16_kind:
+      for (size_type i = 0; i < num; ++i)
+	delete_subtree(static_cast<node16_pointer>(p_inner)->m_a_children[i]);
+      break;
+    case art_trie_node48_kind:
+      for (size_type i = 0; i < num; ++i)
+	delete_subtree(static_cast<node48_pointer>(p_inner)->m_a_children[i]);
+      break;
+    default:
+      for (size_type b = 0; b < 256; ++b)
+	if (static_cast<node256_pointer>(p_inner)->m_a_children[b] != NULL)
+	  delete_subtree(static_cast<node256_pointer>(p_inner)->m_a_children[b]);
+      break;
+    }
+  delete_inner(p_inner);
+}
+
+// Adds p_child under element e, which must be free, to a node with
+// room for it.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+insert_child(inner_node_pointer p_nd, size_type e, node_pointer p_child)
+{
+  const size_type num = p_nd->m_num_children;
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+    case art_trie_node16_kind:
+      {
+	unsigned char* a_keys;
+	node_pointer* a_children;
+	size_type pos;
+	if (p_nd->m_kind == art_trie_node4_kind)
+	  {
+	    node4_pointer p_n4 = static_cast<node4_pointer>(p_nd);
+	    _GLIBCXX_DEBUG_ASSERT(num < node4::capacity);
+	    a_keys = p_n4->m_a_keys;
+	    a_children = p_n4->m_a_children;
+	    pos = 0;
+	    while (pos < num && a_keys[pos] < e)
+	      ++pos;
+	  }
+	else
+	  {
+	    node16_pointer p_n16 = static_cast<node16_pointer>(p_nd);
+	    _GLIBCXX_DEBUG_ASSERT(num < node16::capacity);
+	    a_keys = p_n16->m_a_keys;
+	    a_children = p_n16->m_a_children;
+	    const unsigned int mask =
+	      art_trie_match16<false>(a_keys, static_cast<unsigned char>(e),
+				      num);
+	    pos = mask == 0 ? num : __builtin_ctz(mask);
+	  }
+	for (size_type i = num; i > pos; --i)
+	  {
+	    a_keys[i] = a_keys[i - 1];
+	    a_children[i] = a_children[i - 1];
+	  }
+	a_keys[pos] = static_cast<unsigned char>(e);
+	a_children[pos] = p_child;
+	break;
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_nd);
+	_GLIBCXX_DEBUG_ASSERT(num < node48::capacity);
+	_GLIBCXX_DEBUG_ASSERT(p_n48->m_a_index[e] == 0);
+	p_n48->m_a_children[num] = p_child;
+	p_n48->m_a_index[e] = static_cast<unsigned char>(num + 1);
+	break;
+      }
+    default:
+      {
+	node256_pointer p_n256 = static_cast<node256_pointer>(p_nd);
+	_GLIBCXX_DEBUG_ASSERT(p_n256->m_a_children[e] == NULL);
+	p_n256->m_a_children[e] = p_child;
+	break;
+      }
+    }
+  ++p_nd->m_num_children;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+remove_child(inner_node_pointer p_nd, size_type e)
+{
+  const size_type num = p_nd->m_num_children;
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+    case art_trie_node16_kind:
+      {
+	unsigned char* a_keys;
+	node_pointer* a_children;
+	if (p_nd->m_kind == art_trie_node4_kind)
+	  {
+	    a_keys = static_cast<node4_pointer>(p_nd)->m_a_keys;
+	    a_children = static_cast<node4_pointer>(p_nd)->m_a_children;
+	  }
+	else
+	  {
+	    a_keys = static_cast<node16_pointer>(p_nd)->m_a_keys;
+	    a_children = static_cast<node16_pointer>(p_nd)->m_a_children;
+	  }
+	size_type pos = 0;
+	while (a_keys[pos] != e)
+	  ++pos;
+	for (; pos + 1 < num; ++pos)
+	  {
+	    a_keys[pos] = a_keys[pos + 1];
+	    a_children[pos] = a_children[pos + 1];
+	  }
+	break;
+      }
+    case art_trie_node48_kind:
+      {
+	// Keep the children packed by moving the last one into the
+	// freed slot.
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_nd);
+	const size_type slot = p_n48->m_a_index[e] - 1;
+	p_n48->m_a_index[e] = 0;
+	if (slot != num - 1)
+	  {
+	    size_type b = 0;
+	    while (p_n48->m_a_index[b] != num)
+	      ++b;
+	    p_n48->m_a_children[slot] = p_n48->m_a_children[num - 1];
+	    p_n48->m_a_index[b] = static_cast<unsigned char>(slot + 1);
+	  }
+	break;
+      }
+    default:
+      static_cast<node256_pointer>(p_nd)->m_a_children[e] = NULL;
+      break;
+    }
+  --p_nd->m_num_children;
+}
+
+// Moves the entries of p_src to the empty node p_dst.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+move_entries(inner_node_pointer p_src, inner_node_pointer p_dst)
+{
+  p_dst->m_p_end = p_src->m_p_end;
+  switch(p_src->m_kind)
+    {
+    case art_trie_node4_kind:
+      {
+	node4_pointer p_n4 = static_cast<node4_pointer>(p_src);
+	for (size_type i = 0; i < p_src->m_num_children; ++i)
+	  insert_child(p_dst, p_n4->m_a_keys[i], p_n4->m_a_children[i]);
+	break;
+      }
+    case art_trie_node16_kind:
+      {
+	node16_pointer p_n16 = static_cast<node16_pointer>(p_src);
+	for (size_type i = 0; i < p_src->m_num_children; ++i)
+	  insert_child(p_dst, p_n16->m_a_keys[i], p_n16->m_a_children[i]);
+	break;
+      }
+    case art_trie_node48_kind:
+      {
+	node48_pointer p_n48 = static_cast<node48_pointer>(p_src);
+	for (size_type b = 0; b < 256; ++b)
+	  if (p_n48->m_a_index[b] != 0)
+	    insert_child(p_dst, b,
+			 p_n48->m_a_children[p_n48->m_a_index[b] - 1]);
+	break;
+      }
+    default:
+      {
+	node256_pointer p_n256 = static_cast<node256_pointer>(p_src);
+	for (size_type b = 0; b < 256; ++b)
+	  if (p_n256->m_a_children[b] != NULL)
+	    insert_child(p_dst, b, p_n256->m_a_children[b]);
+	break;
+      }
+    }
+}
+
+// Returns a node of the next size up if p_nd is full, and NULL
+// otherwise.
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::inner_node_pointer
+PB_DS_CLASS_C_DEC::
+grow_reserve(inner_node_pointer p_nd)
+{
+  size_type capacity;
+  switch(p_nd->m_kind)
+    {
+    case art_trie_node4_kind:
+      capacity = node4::capacity;
+      break;
+    case art_trie_node16_kind:
+      capacity = node16::capacity;
+      break;
+    case art_trie_node48_kind:
+      capacity = node48::capacity;
+      break;
+    default:
+      return NULL;
+    }
+  if (p_nd->m_num_children < capacity)
+    return NULL;
+  return new_inner(p_nd->m_kind + 1, p_nd->m_depth);
+}
+
+// Adds p_child under element e of the node in r_slot, first moving
+// the node's entries to p_grown if that is not NULL.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+add_child(node_pointer& r_slot, size_type e, node_pointer p_child,
+	  inner_node_pointer p_grown)
+{
+  inner_node_pointer p_nd = static_cast<inner_node_pointer>(r_slot);
+  if (p_grown != NULL)
+    {
+      move_entries(p_nd, p_grown);
+      delete_inner(p_nd);
+      r_slot = p_nd = p_grown;
+    }
+  insert_child(p_nd, e, p_child);
+}
+
+// Moves the node in r_slot to a smaller node once it is sparse
+// enough. The thresholds leave some slack so that alternating inserts
+// and erases do not resize a node each time.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+shrink(node_pointer& r_slot)
+{
+  inner_node_pointer p_nd = static_cast<inner_node_pointer>(r_slot);
+  const size_type num = p_nd->m_num_children;
+  if (!((p_nd->m_kind == art_trie_node16_kind && num <= 3)
+	|| (p_nd->m_kind == art_trie_node48_kind && num <= 12)
+	|| (p_nd->m_kind == art_trie_node256_kind && num <= 37)))
+    return;
+
+  inner_node_pointer p_new;
+  try
+    {
+      p_new = new_inner(p_nd->m_kind - 1, p_nd->m_depth);
+    }
+  catch(...)
+    {
+      // Shrinking only saves memory; keep the larger node.
+      return;
+    }
+  move_entries(p_nd, p_new);
+  delete_inner(p_nd);
+  r_slot = p_new;
+}
+
@@ -0,0 +1,223 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file point_iterators.hpp
+ * Contains the iterators of art_trie_.
+ */
+
+#ifndef PB_DS_ART_TRIE_ITERATORS_HPP
+#define PB_DS_ART_TRIE_ITERATORS_HPP
+
+#include <iterator>
+#include <ext/pb_ds/detail/art_trie_/node.hpp>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+
+#define PB_DS_ART_CONST_IT_C_DEC					\
+    art_trie_const_it_<Value_Type, Pointer, Const_Pointer,		\
+		       Reference, Const_Reference, Allocator>
+
+#define PB_DS_ART_IT_C_DEC						\
+    art_trie_it_<Value_Type, Pointer, Const_Pointer,			\
+		 Reference, Const_Reference, Allocator>
+
+    // Const iterator. Walks the list threading the leaves; the end
+    // iterator designates the container's head.
+    template<typename Value_Type,
+	     typename Pointer,
+	     typename Const_Pointer,
+	     typename Reference,
+	     typename Const_Reference,
+	     class Allocator>
+    class art_trie_const_it_
+    {
+    protected:
+      typedef
+      typename art_trie_list_node_<Allocator>::list_node_pointer
+      list_node_pointer;
+
+      typedef art_trie_leaf_<Value_Type, Allocator> leaf;
+
+    public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+
+      typedef typename Allocator::difference_type difference_type;
+
+      typedef Value_Type value_type;
+
+      typedef Pointer pointer;
+
+      typedef Const_Pointer const_pointer;
+
+      typedef Reference reference;
+
+      typedef Const_Reference const_reference;
+
+    public:
+      inline
+      art_trie_const_it_(const list_node_pointer p_nd = NULL)
+      : m_p_nd(const_cast<list_node_pointer>(p_nd))
+      { }
+
+      inline const_pointer
+      operator->() const
+      {
+	_GLIBCXX_DEBUG_ASSERT(m_p_nd->m_kind == art_trie_leaf_kind);
+	return &static_cast<leaf*>(m_p_nd)->m_value;
+      }
+
+      inline const_reference
+      operator*() const
+      {
+	_GLIBCXX_DEBUG_ASSERT(m_p_nd->m_kind == art_trie_leaf_kind);
+	return static_cast<leaf*>(m_p_nd)->m_value;
+      }
+
+      inline bool
+      operator==(const PB_DS_ART_CONST_IT_C_DEC& other) const
+      { return m_p_nd == other.m_p_nd; }
+
+      inline bool
+      operator!=(const PB_DS_ART_CONST_IT_C_DEC& other) const
+      { return m_p_nd != other.m_p_nd; }
+
+      inline PB_DS_ART_CONST_IT_C_DEC& 
+      operator++()
+      {
+	m_p_nd = m_p_nd->m_p_next;
+	return *this;
+      }
+
+      inline PB_DS_ART_CONST_IT_C_DEC
+      operator++(int)
+      {
+	PB_DS_ART_CONST_IT_C_DEC ret_it(*this);
+	operator++();
+	return ret_it;
+      }
+
+      inline PB_DS_ART_CONST_IT_C_DEC& 
+      operator--()
+      {
+	m_p_nd = m_p_nd->m_p_prev;
+	return *this;
+      }
+
+      inline PB_DS_ART_CONST_IT_C_DEC
+      operator--(int)
+      {
+	PB_DS_ART_CONST_IT_C_DEC ret_it(*this);
+	operator--();
+	return ret_it;
+      }
+
+    public:
+      list_node_pointer m_p_nd;
+    };
+
+    // Iterator.
+    template<typename Value_Type,
+	     typename Pointer,
+	     typename Const_Pointer,
+	     typename Reference,
+	     typename Const_Reference,
+	     class Allocator>
+    class art_trie_it_ : public PB_DS_ART_CONST_IT_C_DEC
+    {
+    protected:
+      typedef PB_DS_ART_CONST_IT_C_DEC base_it_type;
+
+      typedef typename base_it_type::list_node_pointer list_node_pointer;
+
+      typedef typename base_it_type::leaf leaf;
+
+    public:
+      inline
+      art_trie_it_(const list_node_pointer p_nd = NULL)
+      : base_it_type(p_nd)
+      { }
+
+      inline typename base_it_type::pointer
+      operator->() const
+      {
+	_GLIBCXX_DEBUG_ASSERT(base_it_type::m_p_nd->m_kind == art_trie_leaf_kind);
+	return &static_cast<leaf*>(base_it_type::m_p_nd)->m_value;
+      }
+
+      inline typename base_it_type::reference
+      operator*() const
+      {
+	_GLIBCXX_DEBUG_ASSERT(base_it_type::m_p_nd->m_kind == art_trie_leaf_kind);
+	return static_cast<leaf*>(base_it_type::m_p_nd)->m_value;
+      }
+
+      inline PB_DS_ART_IT_C_DEC& 
+      operator++()
+      {
+	base_it_type::operator++();
+	return *this;
+      }
+
+      inline PB_DS_ART_IT_C_DEC
+      operator++(int)
+      {
+	PB_DS_ART_IT_C_DEC ret_it(*this);
+	operator++();
+	return ret_it;
+      }
+
+      inline PB_DS_ART_IT_C_DEC& 
+      operator--()
+      {
+	base_it_type::operator--();
+	return *this;
+      }
+
+      inline PB_DS_ART_IT_C_DEC
+      operator--(int)
+      {
+	PB_DS_ART_IT_C_DEC ret_it(*this);
+	operator--();
+	return ret_it;
+      }
+    };
+
+#undef PB_DS_ART_CONST_IT_C_DEC
+#undef PB_DS_ART_IT_C_DEC
+
+  } // namespace detail
+} // namespace pb_ds
+
+#endif // #ifndef PB_DS_ART_TRIE_ITERATORS_HPP
@@ -0,0 +1,112 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file prefix_search_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+std::pair<typename PB_DS_CLASS_C_DEC::iterator,
+	  typename PB_DS_CLASS_C_DEC::iterator>
+PB_DS_CLASS_C_DEC::
+prefix_range(const_key_reference r_key)
+{
+  if (m_p_root == NULL)
+    return std::make_pair(end(), end());
+
+  // Descend to the first node branching at or after the end of r_key.
+  const size_type size_ = key_size(r_key);
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  node_pointer p_nd = m_p_root;
+  while (p_nd->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+      if (p_inner->m_depth >= size_)
+	break;
+      node_pointer* p_slot =
+	child_slot(p_inner, e_pos_at(it, pos, p_inner->m_depth));
+      if (p_slot == NULL)
+	return std::make_pair(end(), end());
+      p_nd = *p_slot;
+    }
+
+  // The keys below p_nd agree on their first size_ elements, so one
+  // of them settles whether they all start with r_key.
+  leaf_pointer p_first = leftmost(p_nd);
+  int cmp;
+  if (common_prefix(r_key, leaf_key(p_first), cmp) != size_)
+    return std::make_pair(end(), end());
+  return std::make_pair(iterator(p_first),
+			iterator(rightmost(p_nd)->m_p_next));
+}
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+longest_prefix_match(const_key_reference r_key)
+{
+  if (m_p_root == NULL)
+    return end();
+
+  const size_type size_ = key_size(r_key);
+  leaf_pointer p_lf = probe(r_key, size_);
+  int cmp;
+  const size_type common = common_prefix(r_key, leaf_key(p_lf), cmp);
+  if (cmp == 0 || cmp == 1)
+    return point_iterator(p_lf);
+
+  // Otherwise the match is the key ending at the deepest node, on
+  // r_key's path, that branches within the common prefix: every key
+  // below such a node agrees with p_lf, and so with r_key, before the
+  // branch.
+  leaf_pointer p_best = NULL;
+  const_e_iterator it = e_access_traits_base::begin(r_key);
+  size_type pos = 0;
+  node_pointer p_nd = m_p_root;
+  while (p_nd->m_kind != art_trie_leaf_kind)
+    {
+      inner_node_pointer p_inner = static_cast<inner_node_pointer>(p_nd);
+      if (p_inner->m_depth > common)
+	break;
+      if (p_inner->m_p_end != NULL)
+	p_best = static_cast<leaf_pointer>(p_inner->m_p_end);
+      if (p_inner->m_depth == common)
+	break;
+      node_pointer* p_slot =
+	child_slot(p_inner, e_pos_at(it, pos, p_inner->m_depth));
+      if (p_slot == NULL)
+	break;
+      p_nd = *p_slot;
+    }
+  return p_best == NULL ? end() : point_iterator(p_best);
+}
+
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file split_join_fn_imps.hpp
+ * Contains an implementation class for art_trie_.
+ */
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+join(PB_DS_CLASS_C_DEC& other)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+  for (const_iterator it = other.begin(); it != other.end(); ++it)
+    if (find(PB_DS_V2F(*it)) != end())
+      __throw_join_error();
+
+  while (other.m_p_root != NULL)
+    move_leaf(static_cast<leaf_pointer>(other.m_p_head->m_p_next), other);
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+split(const_key_reference r_key, PB_DS_CLASS_C_DEC& other)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+  other.clear();
+  list_node_pointer p_nd = upper_bound(r_key).m_p_nd;
+  while (p_nd != m_p_head)
+    {
+      leaf_pointer p_lf = static_cast<leaf_pointer>(p_nd);
+      p_nd = p_nd->m_p_next;
+      other.move_leaf(p_lf, *this);
+    }
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+}
+
+// Moves p_lf, whose key is not in this container, from r_source. If
+// an allocation fails, both containers are left unchanged.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+move_leaf(leaf_pointer p_lf, PB_DS_CLASS_C_DEC& r_source)
+{
+  locus l;
+  locate(leaf_key(p_lf), l);
+  _GLIBCXX_DEBUG_ASSERT(l.m_cmp != 0);
+  inner_node_pointer p_reserved = insert_reserve(l);
+  r_source.detach(leaf_key(p_lf));
+  insert_commit(l, p_lf, p_reserved);
+}
+
@@ -86,6 +86,8 @@ namespace pb_ds
 #include <ext/pb_ds/detail/rb_tree_map_/traits.hpp>
 #include <ext/pb_ds/detail/splay_tree_/traits.hpp>
 #include <ext/pb_ds/detail/ov_tree_map_/traits.hpp>
+#include <ext/pb_ds/detail/btree_map_/traits.hpp>
 #include <ext/pb_ds/detail/pat_trie_/traits.hpp>
+#include <ext/pb_ds/detail/art_trie_/traits.hpp>
 
 #endif // #ifndef PB_DS_NODE_AND_IT_TRAITS_HPP
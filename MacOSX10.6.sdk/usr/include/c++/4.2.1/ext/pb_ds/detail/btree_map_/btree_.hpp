@@ -0,0 +1,427 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file btree_.hpp
+ * Contains an implementation class for btree_.
+ */
+
+#include <map>
+#include <set>
+#include <iterator>
+#include <ext/pb_ds/tree_policy.hpp>
+#include <ext/pb_ds/detail/types_traits.hpp>
+#include <ext/pb_ds/detail/type_utils.hpp>
+#include <ext/pb_ds/exception.hpp>
+#include <ext/pb_ds/detail/btree_map_/node.hpp>
+#include <ext/pb_ds/detail/btree_map_/iterators.hpp>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+#define PB_DS_CLASS_T_DEC \
+    template<typename Key, typename Mapped, class Cmp_Fn, \
+	     class Node_And_It_Traits, class Allocator>
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+#define PB_DS_CLASS_NAME btree_data_
+#endif 
+
+#ifdef PB_DS_DATA_FALSE_INDICATOR
+#define PB_DS_CLASS_NAME btree_no_data_
+#endif 
+
+#define PB_DS_CLASS_C_DEC \
+    PB_DS_CLASS_NAME<Key, Mapped, Cmp_Fn, Node_And_It_Traits, Allocator>
+
+#define PB_DS_TYPES_TRAITS_C_DEC \
+    types_traits<Key, Mapped, Allocator, false>
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+#define PB_DS_V2F(X) (X).first
+#define PB_DS_V2S(X) (X).second
+#endif 
+
+#ifdef PB_DS_DATA_FALSE_INDICATOR
+#define PB_DS_V2F(X) (X)
+#define PB_DS_V2S(X) Mapped_Data()
+#endif 
+
+#define PB_DS_STATIC_ASSERT(UNIQUE, E) \
+    typedef static_assert_dumclass<sizeof(static_assert<(bool)(E)>)> \
+    UNIQUE##static_assert_type
+
+    // B-tree associative container. Each node stores up to
+    // node::capacity values contiguously, so a lookup touches
+    // O(log_B n) nodes, each a few cache lines long, instead of one
+    // node per comparison. Values are relocated between nodes by
+    // copy construction when nodes split and merge; as with ov_tree_,
+    // iterators are invalidated by any modification.
+    template<typename Key, typename Mapped, class Cmp_Fn,
+	     class Node_And_It_Traits, class Allocator>
+    class PB_DS_CLASS_NAME :
+      public Cmp_Fn,
+      public Node_And_It_Traits::node_update,
+      public PB_DS_TYPES_TRAITS_C_DEC
+    {
+    private:
+      typedef PB_DS_TYPES_TRAITS_C_DEC traits_base;
+
+      typedef Cmp_Fn cmp_fn_base;
+
+      typedef btree_node_<typename traits_base::value_type, Allocator> node;
+
+      typedef btree_inner_node_<typename traits_base::value_type, Allocator> inner_node;
+
+      typedef typename node::node_pointer node_pointer;
+
+      typedef typename node::inner_node_pointer inner_node_pointer;
+
+      typedef typename Allocator::template rebind<node>::other node_allocator;
+
+      typedef typename Allocator::template rebind<inner_node>::other inner_node_allocator;
+
+      typedef
+      typename Node_And_It_Traits::null_node_update_pointer
+      null_node_update_pointer;
+
+      enum
+	{
+	  null_update = is_same<
+	  typename Node_And_It_Traits::node_update*,
+	  null_node_update_pointer>::value
+	};
+
+      PB_DS_STATIC_ASSERT(btree_null_update, null_update);
+
+    public:
+      typedef Allocator allocator;
+      typedef typename Allocator::size_type size_type;
+      typedef typename Allocator::difference_type difference_type;
+
+      typedef Cmp_Fn cmp_fn;
+
+      typedef typename Node_And_It_Traits::node_update node_update;
+
+      typedef typename traits_base::key_type key_type;
+      typedef typename traits_base::key_pointer key_pointer;
+      typedef typename traits_base::const_key_pointer const_key_pointer;
+      typedef typename traits_base::key_reference key_reference;
+      typedef typename traits_base::const_key_reference const_key_reference;
+      typedef typename traits_base::mapped_type mapped_type;
+      typedef typename traits_base::mapped_pointer mapped_pointer;
+      typedef typename traits_base::const_mapped_pointer const_mapped_pointer;
+      typedef typename traits_base::mapped_reference mapped_reference;
+      typedef typename traits_base::const_mapped_reference const_mapped_reference;
+      typedef typename traits_base::value_type value_type;
+      typedef typename traits_base::pointer pointer;
+      typedef typename traits_base::const_pointer const_pointer;
+      typedef typename traits_base::reference reference;
+      typedef typename traits_base::const_reference const_reference;
+
+      typedef
+      btree_const_it_<
+	node_pointer,
+	value_type,
+	pointer,
+	const_pointer,
+	reference,
+	const_reference,
+	Allocator>
+      const_iterator;
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+      typedef
+      btree_it_<
+	node_pointer,
+	value_type,
+	pointer,
+	const_pointer,
+	reference,
+	const_reference,
+	Allocator>
+      iterator;
+#else 
+      typedef const_iterator iterator;
+#endif 
+
+      typedef const_iterator const_point_iterator;
+
+      typedef iterator point_iterator;
+
+    public:
+
+      PB_DS_CLASS_NAME();
+
+      PB_DS_CLASS_NAME(const Cmp_Fn&);
+
+      PB_DS_CLASS_NAME(const Cmp_Fn&, const node_update&);
+
+      PB_DS_CLASS_NAME(const PB_DS_CLASS_C_DEC&);
+
+      ~PB_DS_CLASS_NAME();
+
+      void
+      swap(PB_DS_CLASS_C_DEC&);
+
+      template<typename It>
+      void
+      copy_from_range(It, It);
+
+      // Replaces the contents with the values in [first, last), which
+      // must be strictly ascending in key order. The tree is built
+      // bottom-up in linear time, without comparisons.
+      template<typename It>
+      void
+      copy_from_ordered_range(It, It);
+
+      inline size_type
+      max_size() const;
+
+      inline bool
+      empty() const;
+
+      inline size_type
+      size() const;
+
+      Cmp_Fn& 
+      get_cmp_fn();
+
+      const Cmp_Fn& 
+      get_cmp_fn() const;
+
+      inline mapped_reference
+      operator[](const_key_reference r_key)
+      {
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+	return insert(std::make_pair(r_key, mapped_type())).first->second;
+#else 
+	insert(r_key);
+	return traits_base::s_null_mapped;
+#endif 
+      }
+
+      inline std::pair<point_iterator, bool>
+      insert(const_reference);
+
+      inline point_iterator
+      lower_bound(const_key_reference);
+
+      inline const_point_iterator
+      lower_bound(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).lower_bound(r_key); }
+
+      inline point_iterator
+      upper_bound(const_key_reference);
+
+      inline const_point_iterator
+      upper_bound(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).upper_bound(r_key); }
+
+      inline point_iterator
+      find(const_key_reference);
+
+      inline const_point_iterator
+      find(const_key_reference r_key) const
+      { return const_cast<PB_DS_CLASS_C_DEC&>(*this).find(r_key); }
+
+      inline bool
+      erase(const_key_reference);
+
+      template<typename Pred>
+      inline size_type
+      erase_if(Pred);
+
+      inline iterator
+      erase(iterator);
+
+      void
+      clear();
+
+      void
+      join(PB_DS_CLASS_C_DEC&);
+
+      void
+      split(const_key_reference, PB_DS_CLASS_C_DEC&);
+
+      inline iterator
+      begin();
+
+      inline const_iterator
+      begin() const;
+
+      inline iterator
+      end();
+
+      inline const_iterator
+      end() const;
+
+    private:
+      // A value followed while rebalancing relocates it.
+      struct value_track
+      {
+	node_pointer m_p_nd;
+	size_type m_pos;
+      };
+
+      // Walks the concatenation of two ordered ranges.
+      template<typename It>
+      struct range_cursor
+      {
+	It m_it;
+	It m_end_it;
+	It m_next_it;
+	It m_next_end_it;
+
+	inline void
+	advance()
+	{
+	  if (++m_it == m_end_it)
+	    {
+	      m_it = m_next_it;
+	      m_end_it = m_next_end_it;
+	      m_next_it = m_next_end_it;
+	    }
+	}
+      };
+
+      template<typename It>
+      void
+      copy_from_ordered_range(It, It, It, It);
+
+      template<typename It>
+      bool
+      ordered_range(It, It, std::forward_iterator_tag);
+
+      template<typename It>
+      bool
+      ordered_range(It, It, std::input_iterator_tag);
+
+      template<typename It>
+      node_pointer
+      build_subtree(range_cursor<It>&, size_type, size_type, size_type);
+
+      void
+      value_swap(PB_DS_CLASS_C_DEC&);
+
+      inline size_type
+      node_lower_bound(node_pointer, const_key_reference);
+
+      inline size_type
+      node_upper_bound(node_pointer, const_key_reference);
+
+      inline node_pointer
+      new_node(bool);
+
+      inline static void
+      delete_node(node_pointer);
+
+      static void
+      delete_subtree(node_pointer);
+
+      inline static void
+      relocate(node_pointer, size_type, node_pointer, size_type,
+	       value_track&);
+
+      inline static void
+      relocate_range(node_pointer, size_type, node_pointer, size_type,
+		     size_type, value_track&);
+
+      inline static void
+      set_child(node_pointer, size_type, node_pointer);
+
+      inline static void
+      move_children(node_pointer, size_type, node_pointer, size_type,
+		    size_type);
+
+      void
+      split_overflow(node_pointer, node_pointer*, value_track&);
+
+      void
+      erase_at(node_pointer, size_type, value_track&);
+
+      void
+      rebalance(node_pointer, value_track&);
+
+      void
+      rotate_right(node_pointer, size_type, value_track&);
+
+      void
+      rotate_left(node_pointer, size_type, value_track&);
+
+      void
+      merge(node_pointer, size_type, value_track&);
+
+      void
+      update_extremes();
+
+#ifdef _GLIBCXX_DEBUG
+      void
+      assert_valid() const;
+
+      size_type
+      assert_node_valid(const node_pointer, size_type, size_type&) const;
+#endif 
+
+    private:
+      static node_allocator s_node_allocator;
+      static inner_node_allocator s_inner_node_allocator;
+
+      node_pointer m_p_root;
+      node_pointer m_p_leftmost;
+      node_pointer m_p_rightmost;
+      size_type m_size;
+    };
+
+#include <ext/pb_ds/detail/btree_map_/constructors_destructor_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/iterators_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/debug_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/find_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/insert_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/erase_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/info_fn_imps.hpp>
+#include <ext/pb_ds/detail/btree_map_/split_join_fn_imps.hpp>
+#include <ext/pb_ds/detail/bin_search_tree_/policy_access_fn_imps.hpp>
+
+#undef PB_DS_STATIC_ASSERT
+#undef PB_DS_CLASS_C_DEC
+#undef PB_DS_CLASS_T_DEC
+#undef PB_DS_CLASS_NAME
+#undef PB_DS_TYPES_TRAITS_C_DEC
+#undef PB_DS_V2F
+#undef PB_DS_V2S
+
+  } // namespace detail
+} // namespace pb_ds
@@ -0,0 +1,357 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file constructors_destructor_fn_imps.hpp
+ * Contains an implementation class for btree_.
+ */
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::node_allocator
+PB_DS_CLASS_C_DEC::s_node_allocator;
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::inner_node_allocator
+PB_DS_CLASS_C_DEC::s_inner_node_allocator;
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+PB_DS_CLASS_NAME() :
+  m_p_root(NULL),
+  m_p_leftmost(NULL),
+  m_p_rightmost(NULL),
+  m_size(0)
+{ _GLIBCXX_DEBUG_ONLY(PB_DS_CLASS_C_DEC::assert_valid();) }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+PB_DS_CLASS_NAME(const Cmp_Fn& r_cmp_fn) :
+  cmp_fn_base(r_cmp_fn),
+  m_p_root(NULL),
+  m_p_leftmost(NULL),
+  m_p_rightmost(NULL),
+  m_size(0)
+{ _GLIBCXX_DEBUG_ONLY(PB_DS_CLASS_C_DEC::assert_valid();) }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+PB_DS_CLASS_NAME(const Cmp_Fn& r_cmp_fn, const node_update& r_node_update) :
+  cmp_fn_base(r_cmp_fn),
+  node_update(r_node_update),
+  m_p_root(NULL),
+  m_p_leftmost(NULL),
+  m_p_rightmost(NULL),
+  m_size(0)
+{ _GLIBCXX_DEBUG_ONLY(PB_DS_CLASS_C_DEC::assert_valid();) }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+PB_DS_CLASS_NAME(const PB_DS_CLASS_C_DEC& other) :
+  cmp_fn_base(other),
+  node_update(other),
+  m_p_root(NULL),
+  m_p_leftmost(NULL),
+  m_p_rightmost(NULL),
+  m_size(0)
+{
+  copy_from_ordered_range(other.begin(), other.end());
+  _GLIBCXX_DEBUG_ONLY(PB_DS_CLASS_C_DEC::assert_valid();)
+}
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+void
+PB_DS_CLASS_C_DEC::
+copy_from_range(It first_it, It last_it)
+{
+  typedef typename std::iterator_traits<It>::iterator_category category;
+
+  if (ordered_range(first_it, last_it, category()))
+    {
+      copy_from_ordered_range(first_it, last_it);
+      return;
+    }
+
+#ifdef PB_DS_DATA_TRUE_INDICATOR
+  typedef
+    std::map<
+    key_type,
+    mapped_type,
+    Cmp_Fn,
+    typename Allocator::template rebind<
+    value_type>::other>
+    map_type;
+#else 
+  typedef
+    std::set<
+    key_type,
+    Cmp_Fn,
+    typename Allocator::template rebind<
+    Key>::other>
+    map_type;
+#endif 
+
+  map_type m(first_it, last_it, get_cmp_fn());
+  copy_from_ordered_range(m.begin(), m.end());
+}
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+bool
+PB_DS_CLASS_C_DEC::
+ordered_range(It first_it, It last_it, std::forward_iterator_tag)
+{
+  if (first_it == last_it)
+    return true;
+
+  It prev_it = first_it;
+  while (++first_it != last_it)
+    {
+      if (!Cmp_Fn::operator()(PB_DS_V2F(*prev_it), PB_DS_V2F(*first_it)))
+	return false;
+      prev_it = first_it;
+    }
+  return true;
+}
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+inline bool
+PB_DS_CLASS_C_DEC::
+ordered_range(It, It, std::input_iterator_tag)
+{ return false; }
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+void
+PB_DS_CLASS_C_DEC::
+copy_from_ordered_range(It first_it, It last_it)
+{ copy_from_ordered_range(first_it, last_it, last_it, last_it); }
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+void
+PB_DS_CLASS_C_DEC::
+copy_from_ordered_range(It first_it, It last_it, It other_first_it,
+			It other_last_it)
+{
+  const size_type len = std::distance(first_it, last_it)
+			+ std::distance(other_first_it, other_last_it);
+
+  node_pointer p_root = NULL;
+  if (len != 0)
+    {
+      // Find the least height whose subtrees can hold len values;
+      // span is the number of values a child subtree holds, plus one.
+      const size_type fanout = node::capacity + 1;
+      size_type height = 0;
+      size_type span = 1;
+      while (span * fanout - 1 < len)
+	{
+	  span *= fanout;
+	  ++height;
+	}
+
+      range_cursor<It> cursor;
+      if (first_it == last_it)
+	{
+	  cursor.m_it = other_first_it;
+	  cursor.m_end_it = cursor.m_next_it = other_last_it;
+	}
+      else
+	{
+	  cursor.m_it = first_it;
+	  cursor.m_end_it = last_it;
+	  cursor.m_next_it = other_first_it;
+	}
+      cursor.m_next_end_it = other_last_it;
+
+      p_root = build_subtree(cursor, len, height, span);
+    }
+
+  // No exceptions from this point.
+  clear();
+  m_p_root = p_root;
+  m_size = len;
+  update_extremes();
+  _GLIBCXX_DEBUG_ONLY(PB_DS_CLASS_C_DEC::assert_valid();)
+}
+
+// Builds a subtree of the given height holding the next num values of
+// r_cursor, spreading them evenly over as few children as possible so
+// that every node is at least half full.
+PB_DS_CLASS_T_DEC
+template<typename It>
+typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+build_subtree(range_cursor<It>& r_cursor, size_type num, size_type height,
+	      size_type span)
+{
+  _GLIBCXX_DEBUG_ASSERT(num > 0);
+  node_pointer p_nd = new_node(height == 0);
+  size_type num_children = 0;
+  try
+    {
+      if (height == 0)
+	{
+	  _GLIBCXX_DEBUG_ASSERT(num <= node::capacity);
+	  while (p_nd->m_count < num)
+	    {
+	      new (p_nd->value_ptr(p_nd->m_count)) value_type(*r_cursor.m_it);
+	      ++p_nd->m_count;
+	      r_cursor.advance();
+	    }
+	  return p_nd;
+	}
+
+      const size_type k = (num + span) / span;
+      _GLIBCXX_DEBUG_ASSERT(k >= 2 && k <= node::capacity + 1);
+      const size_type base = (num - (k - 1)) / k;
+      const size_type extra = (num - (k - 1)) % k;
+      for (size_type i = 0; i < k; ++i)
+	{
+	  node_pointer p_child = build_subtree(r_cursor, base + (i < extra),
+					       height - 1, span / (node::capacity + 1));
+	  set_child(p_nd, i, p_child);
+	  ++num_children;
+	  if (i + 1 < k)
+	    {
+	      new (p_nd->value_ptr(i)) value_type(*r_cursor.m_it);
+	      ++p_nd->m_count;
+	      r_cursor.advance();
+	    }
+	}
+      return p_nd;
+    }
+  catch(...)
+    {
+      for (size_type i = 0; i < p_nd->m_count; ++i)
+	p_nd->value_ptr(i)->~value_type();
+      for (size_type i = 0; i < num_children; ++i)
+	delete_subtree(p_nd->child(i));
+      delete_node(p_nd);
+      throw;
+    }
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+swap(PB_DS_CLASS_C_DEC& other)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  value_swap(other);
+  std::swap((Cmp_Fn& )(*this), (Cmp_Fn& )other);
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+value_swap(PB_DS_CLASS_C_DEC& other)
+{
+  std::swap(m_p_root, other.m_p_root);
+  std::swap(m_p_leftmost, other.m_p_leftmost);
+  std::swap(m_p_rightmost, other.m_p_rightmost);
+  std::swap(m_size, other.m_size);
+}
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+~PB_DS_CLASS_NAME()
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  clear();
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::node_pointer
+PB_DS_CLASS_C_DEC::
+new_node(bool leaf)
+{
+  node_pointer p_nd;
+  if (leaf)
+    p_nd = s_node_allocator.allocate(1);
+  else
+    p_nd = s_inner_node_allocator.allocate(1);
+
+  p_nd->m_p_parent = NULL;
+  p_nd->m_pos = 0;
+  p_nd->m_count = 0;
+  p_nd->m_leaf = leaf;
+  return p_nd;
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+delete_node(node_pointer p_nd)
+{
+  if (p_nd->m_leaf)
+    s_node_allocator.deallocate(p_nd, 1);
+  else
+    s_inner_node_allocator.deallocate(static_cast<inner_node_pointer>(p_nd), 1);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+delete_subtree(node_pointer p_nd)
+{
+  if (!p_nd->m_leaf)
+    for (size_type i = 0; i <= p_nd->m_count; ++i)
+      delete_subtree(p_nd->child(i));
+
+  for (size_type i = 0; i < p_nd->m_count; ++i)
+    p_nd->value_ptr(i)->~value_type();
+  delete_node(p_nd);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+update_extremes()
+{
+  if (m_p_root == NULL)
+    {
+      m_p_leftmost = m_p_rightmost = NULL;
+      return;
+    }
+
+  node_pointer p_nd = m_p_root;
+  while (!p_nd->m_leaf)
+    p_nd = p_nd->child(0);
+  m_p_leftmost = p_nd;
+
+  p_nd = m_p_root;
+  while (!p_nd->m_leaf)
+    p_nd = p_nd->child(p_nd->m_count);
+  m_p_rightmost = p_nd;
+}
@@ -0,0 +1,108 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file debug_fn_imps.hpp
+ * Contains an implementation class for btree_.
+ */
+
+#ifdef _GLIBCXX_DEBUG
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+assert_valid() const
+{
+  if (m_p_root == NULL)
+    {
+      _GLIBCXX_DEBUG_ASSERT(m_size == 0);
+      _GLIBCXX_DEBUG_ASSERT(m_p_leftmost == NULL && m_p_rightmost == NULL);
+      return;
+    }
+
+  _GLIBCXX_DEBUG_ASSERT(m_p_root->m_p_parent == NULL);
+  size_type leaf_depth = 0;
+  _GLIBCXX_DEBUG_ASSERT(assert_node_valid(m_p_root, 0, leaf_depth) == m_size);
+
+  node_pointer p_nd = m_p_root;
+  while (!p_nd->m_leaf)
+    p_nd = p_nd->child(0);
+  _GLIBCXX_DEBUG_ASSERT(p_nd == m_p_leftmost);
+  p_nd = m_p_root;
+  while (!p_nd->m_leaf)
+    p_nd = p_nd->child(p_nd->m_count);
+  _GLIBCXX_DEBUG_ASSERT(p_nd == m_p_rightmost);
+
+  size_type iterated_num = 0;
+  const_iterator prev_it = end();
+  for (const_iterator it = begin(); it != end(); ++it)
+    {
+      ++iterated_num;
+      if (prev_it != end())
+	_GLIBCXX_DEBUG_ASSERT(Cmp_Fn::operator()(PB_DS_V2F(*prev_it),
+						 PB_DS_V2F(*it)));
+      prev_it = it;
+    }
+  _GLIBCXX_DEBUG_ASSERT(iterated_num == m_size);
+}
+
+// Checks fill, links and uniform leaf depth below p_nd; returns the
+// number of values in the subtree.
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+assert_node_valid(const node_pointer p_nd, size_type depth,
+		  size_type& r_leaf_depth) const
+{
+  _GLIBCXX_DEBUG_ASSERT(p_nd->m_count <= node::capacity);
+  if (p_nd != m_p_root)
+    _GLIBCXX_DEBUG_ASSERT(p_nd->m_count >= node::min_count);
+  _GLIBCXX_DEBUG_ASSERT(p_nd->m_count > 0);
+
+  if (p_nd->m_leaf)
+    {
+      if (r_leaf_depth == 0)
+	r_leaf_depth = depth + 1;
+      _GLIBCXX_DEBUG_ASSERT(r_leaf_depth == depth + 1);
+      return p_nd->m_count;
+    }
+
+  size_type num = p_nd->m_count;
+  for (size_type i = 0; i <= p_nd->m_count; ++i)
+    {
+      const node_pointer p_child = p_nd->child(i);
+      _GLIBCXX_DEBUG_ASSERT(p_child->m_p_parent == p_nd);
+      _GLIBCXX_DEBUG_ASSERT(p_child->m_pos == i);
+      num += assert_node_valid(p_child, depth + 1, r_leaf_depth);
+    }
+  return num;
+}
+
+#endif 
@@ -0,0 +1,249 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file erase_fn_imps.hpp
+ * Contains an implementation class for btree_.
+ */
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+clear()
+{
+  if (m_p_root != NULL)
+    delete_subtree(m_p_root);
+  m_p_root = m_p_leftmost = m_p_rightmost = NULL;
+  m_size = 0;
+}
+
+PB_DS_CLASS_T_DEC
+inline bool
+PB_DS_CLASS_C_DEC::
+erase(const_key_reference r_key)
+{
+  point_iterator it = find(r_key);
+  if (it == end())
+    return false;
+
+  value_track track = { NULL, 0 };
+  erase_at(it.m_p_nd, it.m_pos, track);
+  return true;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::iterator
+PB_DS_CLASS_C_DEC::
+erase(iterator it)
+{
+  if (it == end())
+    return it;
+
+  // Follow the successor through rebalancing.
+  iterator next_it = it;
+  ++next_it;
+  value_track track = { NULL, 0 };
+  if (next_it != end())
+    {
+      track.m_p_nd = next_it.m_p_nd;
+      track.m_pos = next_it.m_pos;
+    }
+
+  erase_at(it.m_p_nd, it.m_pos, track);
+  if (track.m_p_nd == NULL)
+    return end();
+  return iterator(track.m_p_nd, track.m_pos);
+}
+
+PB_DS_CLASS_T_DEC
+template<typename Pred>
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+erase_if(Pred pred)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  size_type num_ersd = 0;
+  iterator it = begin();
+  while (it != end())
+    if (pred(*it))
+      {
+	++num_ersd;
+	it = erase(it);
+      }
+    else
+      ++it;
+
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  return num_ersd;
+}
+
+// Removes the value at (p_nd, pos). A value in an inner node is
+// replaced by its in-order predecessor, so that values only ever leave
+// the tree from leaves.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+erase_at(node_pointer p_nd, size_type pos, value_track& r_track)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  p_nd->value_ptr(pos)->~value_type();
+  if (!p_nd->m_leaf)
+    {
+      node_pointer p_leaf = p_nd->child(pos);
+      while (!p_leaf->m_leaf)
+	p_leaf = p_leaf->child(p_leaf->m_count);
+      relocate(p_nd, pos, p_leaf, p_leaf->m_count - 1, r_track);
+      p_nd = p_leaf;
+    }
+  else
+    relocate_range(p_nd, pos, p_nd, pos + 1, p_nd->m_count - pos - 1, r_track);
+
+  --p_nd->m_count;
+  --m_size;
+  rebalance(p_nd, r_track);
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+}
+
+// Restores the minimum fill of p_nd and its ancestors by borrowing
+// from a sibling or, failing that, merging with one.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+rebalance(node_pointer p_nd, value_track& r_track)
+{
+  while (p_nd != m_p_root && p_nd->m_count < node::min_count)
+    {
+      node_pointer p_parent = p_nd->m_p_parent;
+      const size_type pos = p_nd->m_pos;
+      if (pos > 0 && p_parent->child(pos - 1)->m_count > node::min_count)
+	{
+	  rotate_right(p_parent, pos - 1, r_track);
+	  return;
+	}
+
+      if (pos < p_parent->m_count
+	  && p_parent->child(pos + 1)->m_count > node::min_count)
+	{
+	  rotate_left(p_parent, pos, r_track);
+	  return;
+	}
+
+      merge(p_parent, pos > 0 ? pos - 1 : pos, r_track);
+      p_nd = p_parent;
+    }
+
+  if (m_p_root->m_count != 0)
+    return;
+
+  node_pointer p_old_root = m_p_root;
+  if (p_old_root->m_leaf)
+    m_p_root = NULL;
+  else
+    {
+      m_p_root = p_old_root->child(0);
+      m_p_root->m_p_parent = NULL;
+      m_p_root->m_pos = 0;
+    }
+  delete_node(p_old_root);
+  update_extremes();
+}
+
+// Moves the last value of child pos into the parent, and the parent's
+// separator into child pos + 1.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+rotate_right(node_pointer p_parent, size_type pos, value_track& r_track)
+{
+  node_pointer p_left = p_parent->child(pos);
+  node_pointer p_right = p_parent->child(pos + 1);
+
+  relocate_range(p_right, 1, p_right, 0, p_right->m_count, r_track);
+  relocate(p_right, 0, p_parent, pos, r_track);
+  relocate(p_parent, pos, p_left, p_left->m_count - 1, r_track);
+  if (!p_right->m_leaf)
+    {
+      move_children(p_right, 1, p_right, 0, p_right->m_count + 1);
+      set_child(p_right, 0, p_left->child(p_left->m_count));
+    }
+  --p_left->m_count;
+  ++p_right->m_count;
+}
+
+// Moves the first value of child pos + 1 into the parent, and the
+// parent's separator into child pos.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+rotate_left(node_pointer p_parent, size_type pos, value_track& r_track)
+{
+  node_pointer p_left = p_parent->child(pos);
+  node_pointer p_right = p_parent->child(pos + 1);
+
+  relocate(p_left, p_left->m_count, p_parent, pos, r_track);
+  relocate(p_parent, pos, p_right, 0, r_track);
+  relocate_range(p_right, 0, p_right, 1, p_right->m_count - 1, r_track);
+  if (!p_left->m_leaf)
+    {
+      set_child(p_left, p_left->m_count + 1, p_right->child(0));
+      move_children(p_right, 0, p_right, 1, p_right->m_count);
+    }
+  ++p_left->m_count;
+  --p_right->m_count;
+}
+
+// Folds child pos + 1 and the separator between them into child pos.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+merge(node_pointer p_parent, size_type pos, value_track& r_track)
+{
+  node_pointer p_left = p_parent->child(pos);
+  node_pointer p_right = p_parent->child(pos + 1);
+  _GLIBCXX_DEBUG_ASSERT(p_left->m_count + p_right->m_count < node::capacity);
+
+  relocate(p_left, p_left->m_count, p_parent, pos, r_track);
+  relocate_range(p_left, p_left->m_count + 1, p_right, 0, p_right->m_count,
+		 r_track);
+  if (!p_left->m_leaf)
+    move_children(p_left, p_left->m_count + 1, p_right, 0,
+		  p_right->m_count + 1);
+  p_left->m_count += p_right->m_count + 1;
+
+  relocate_range(p_parent, pos, p_parent, pos + 1,
+		 p_parent->m_count - pos - 1, r_track);
+  move_children(p_parent, pos + 1, p_parent, pos + 2,
+		p_parent->m_count - pos - 1);
+  --p_parent->m_count;
+
+  if (p_right == m_p_rightmost)
+    m_p_rightmost = p_left;
+  delete_node(p_right);
+}
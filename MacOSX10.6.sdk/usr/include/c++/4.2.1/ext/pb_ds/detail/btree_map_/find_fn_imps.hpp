@@ -0,0 +1,127 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file find_fn_imps.hpp
+ * Contains an implementation class for btree_.
+ */
+
+// Index of the first value in p_nd not less than r_key.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+node_lower_bound(node_pointer p_nd, const_key_reference r_key)
+{
+  size_type lo = 0;
+  size_type hi = p_nd->m_count;
+  while (lo != hi)
+    {
+      const size_type mid = lo + ((hi - lo) >> 1);
+      if (cmp_fn_base::operator()(PB_DS_V2F(*p_nd->value_ptr(mid)), r_key))
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
+// Index of the first value in p_nd greater than r_key.
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+node_upper_bound(node_pointer p_nd, const_key_reference r_key)
+{
+  size_type lo = 0;
+  size_type hi = p_nd->m_count;
+  while (lo != hi)
+    {
+      const size_type mid = lo + ((hi - lo) >> 1);
+      if (cmp_fn_base::operator()(r_key, PB_DS_V2F(*p_nd->value_ptr(mid))))
+	hi = mid;
+      else
+	lo = mid + 1;
+    }
+  return lo;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+lower_bound(const_key_reference r_key)
+{
+  node_pointer p_nd = m_p_root;
+  point_iterator ret_it = end();
+  while (p_nd != NULL)
+    {
+      const size_type pos = node_lower_bound(p_nd, r_key);
+      if (pos < p_nd->m_count)
+	{
+	  ret_it = point_iterator(p_nd, pos);
+	  if (!cmp_fn_base::operator()(r_key, PB_DS_V2F(*p_nd->value_ptr(pos))))
+	    return ret_it;
+	}
+      p_nd = p_nd->m_leaf ? NULL : p_nd->child(pos);
+    }
+  return ret_it;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+upper_bound(const_key_reference r_key)
+{
+  node_pointer p_nd = m_p_root;
+  point_iterator ret_it = end();
+  while (p_nd != NULL)
+    {
+      const size_type pos = node_upper_bound(p_nd, r_key);
+      if (pos < p_nd->m_count)
+	ret_it = point_iterator(p_nd, pos);
+      p_nd = p_nd->m_leaf ? NULL : p_nd->child(pos);
+    }
+  return ret_it;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+find(const_key_reference r_key)
+{
+  node_pointer p_nd = m_p_root;
+  while (p_nd != NULL)
+    {
+      const size_type pos = node_lower_bound(p_nd, r_key);
+      if (pos < p_nd->m_count
+	  && !cmp_fn_base::operator()(r_key, PB_DS_V2F(*p_nd->value_ptr(pos))))
+	return point_iterator(p_nd, pos);
+      p_nd = p_nd->m_leaf ? NULL : p_nd->child(pos);
+    }
+  return end();
+}
@@ -0,0 +1,227 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file insert_fn_imps.hpp
+ * Contains an implementation class for btree_.
+ */
+
+PB_DS_CLASS_T_DEC
+inline std::pair<typename PB_DS_CLASS_C_DEC::point_iterator, bool>
+PB_DS_CLASS_C_DEC::
+insert(const_reference r_value)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  const_key_reference r_key = PB_DS_V2F(r_value);
+  if (m_p_root == NULL)
+    {
+      node_pointer p_nd = new_node(true);
+      try
+	{
+	  new (p_nd->value_ptr(0)) value_type(r_value);
+	}
+      catch(...)
+	{
+	  delete_node(p_nd);
+	  throw;
+	}
+      p_nd->m_count = 1;
+      m_p_root = m_p_leftmost = m_p_rightmost = p_nd;
+      m_size = 1;
+      _GLIBCXX_DEBUG_ONLY(assert_valid();)
+      return std::make_pair(point_iterator(p_nd, 0), true);
+    }
+
+  node_pointer p_nd = m_p_root;
+  size_type pos;
+  while (true)
+    {
+      pos = node_lower_bound(p_nd, r_key);
+      if (pos < p_nd->m_count
+	  && !cmp_fn_base::operator()(r_key, PB_DS_V2F(*p_nd->value_ptr(pos))))
+	return std::make_pair(point_iterator(p_nd, pos), false);
+      if (p_nd->m_leaf)
+	break;
+      p_nd = p_nd->child(pos);
+    }
+
+  // Allocate the nodes a cascade of splits will need up front, so
+  // that running out of memory leaves the tree unchanged.
+  node_pointer a_p_spare[sizeof(size_type) * 8 + 1];
+  size_type num_spare = 0;
+  node_pointer p_up = p_nd;
+  while (p_up != NULL && p_up->m_count == node::capacity)
+    {
+      ++num_spare;
+      p_up = p_up->m_p_parent;
+    }
+  if (p_up == NULL && num_spare != 0)
+    ++num_spare;
+
+  size_type num_alloc = 0;
+  try
+    {
+      while (num_alloc < num_spare)
+	{
+	  a_p_spare[num_alloc] = new_node(num_alloc == 0);
+	  ++num_alloc;
+	}
+    }
+  catch(...)
+    {
+      while (num_alloc != 0)
+	delete_node(a_p_spare[--num_alloc]);
+      throw;
+    }
+
+  value_track track = { NULL, 0 };
+  relocate_range(p_nd, pos + 1, p_nd, pos, p_nd->m_count - pos, track);
+  try
+    {
+      new (p_nd->value_ptr(pos)) value_type(r_value);
+    }
+  catch(...)
+    {
+      relocate_range(p_nd, pos, p_nd, pos + 1, p_nd->m_count - pos, track);
+      while (num_alloc != 0)
+	delete_node(a_p_spare[--num_alloc]);
+      throw;
+    }
+
+  ++p_nd->m_count;
+  ++m_size;
+  track.m_p_nd = p_nd;
+  track.m_pos = pos;
+  if (p_nd->m_count > node::capacity)
+    split_overflow(p_nd, a_p_spare, track);
+
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  return std::make_pair(point_iterator(track.m_p_nd, track.m_pos), true);
+}
+
+// Splits p_nd, which holds one value too many, around its median,
+// which moves up into the parent; repeats for as long as the parent
+// overflows in turn. New nodes are taken from a_p_spare.
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+split_overflow(node_pointer p_nd, node_pointer* a_p_spare, value_track& r_track)
+{
+  while (p_nd->m_count > node::capacity)
+    {
+      const size_type mid = p_nd->m_count / 2;
+      const size_type num_right = p_nd->m_count - mid - 1;
+      node_pointer p_right = *a_p_spare++;
+      _GLIBCXX_DEBUG_ASSERT(p_right->m_leaf == p_nd->m_leaf);
+
+      relocate_range(p_right, 0, p_nd, mid + 1, num_right, r_track);
+      if (!p_nd->m_leaf)
+	move_children(p_right, 0, p_nd, mid + 1, num_right + 1);
+      p_right->m_count = num_right;
+      p_nd->m_count = mid;
+
+      node_pointer p_parent = p_nd->m_p_parent;
+      if (p_parent == NULL)
+	{
+	  p_parent = *a_p_spare++;
+	  set_child(p_parent, 0, p_nd);
+	  m_p_root = p_parent;
+	}
+
+      const size_type pos = p_nd->m_pos;
+      relocate_range(p_parent, pos + 1, p_parent, pos,
+		     p_parent->m_count - pos, r_track);
+      move_children(p_parent, pos + 2, p_parent, pos + 1,
+		    p_parent->m_count - pos);
+      relocate(p_parent, pos, p_nd, mid, r_track);
+      set_child(p_parent, pos + 1, p_right);
+      ++p_parent->m_count;
+
+      if (p_nd == m_p_rightmost)
+	m_p_rightmost = p_right;
+      p_nd = p_parent;
+    }
+}
+
+// Moves the value at (p_src, src_pos) to the raw slot (p_dst, dst_pos).
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+relocate(node_pointer p_dst, size_type dst_pos, node_pointer p_src,
+	 size_type src_pos, value_track& r_track)
+{
+  value_type* const p_value = p_src->value_ptr(src_pos);
+  new (p_dst->value_ptr(dst_pos)) value_type(*p_value);
+  p_value->~value_type();
+  if (r_track.m_p_nd == p_src && r_track.m_pos == src_pos)
+    {
+      r_track.m_p_nd = p_dst;
+      r_track.m_pos = dst_pos;
+    }
+}
+
+// Moves num values; the ranges may overlap within one node.
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+relocate_range(node_pointer p_dst, size_type dst_pos, node_pointer p_src,
+	       size_type src_pos, size_type num, value_track& r_track)
+{
+  if (p_dst == p_src && dst_pos > src_pos)
+    while (num-- != 0)
+      relocate(p_dst, dst_pos + num, p_src, src_pos + num, r_track);
+  else
+    for (size_type i = 0; i < num; ++i)
+      relocate(p_dst, dst_pos + i, p_src, src_pos + i, r_track);
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+set_child(node_pointer p_nd, size_type pos, node_pointer p_child)
+{
+  p_nd->child(pos) = p_child;
+  p_child->m_p_parent = p_nd;
+  p_child->m_pos = static_cast<unsigned short>(pos);
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+move_children(node_pointer p_dst, size_type dst_pos, node_pointer p_src,
+	      size_type src_pos, size_type num)
+{
+  if (p_dst == p_src && dst_pos > src_pos)
+    while (num-- != 0)
+      set_child(p_dst, dst_pos + num, p_src->child(src_pos + num));
+  else
+    for (size_type i = 0; i < num; ++i)
+      set_child(p_dst, dst_pos + i, p_src->child(src_pos + i));
+}
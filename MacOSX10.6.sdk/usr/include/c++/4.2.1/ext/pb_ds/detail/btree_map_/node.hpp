@@ -0,0 +1,214 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file node.hpp
+ * Contains the nodes of btree_.
+ */
+
+#ifndef PB_DS_BTREE_NODE_HPP
+#define PB_DS_BTREE_NODE_HPP
+
+#include <tr1/type_traits>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+    // Number of values a B-tree node holds. Nodes are sized so that
+    // their values span a handful of cache lines.
+    template<typename Value_Type>
+    struct btree_node_capacity
+    {
+      enum
+	{
+	  target_size = 512,
+	  raw_capacity = target_size / sizeof(Value_Type),
+	  value = raw_capacity < 4 ? 4 : (raw_capacity > 255 ? 255 : raw_capacity)
+	};
+    };
+
+    template<typename Value_Type, class Allocator>
+    struct btree_inner_node_;
+
+    // Leaf node; also the common part of inner nodes.
+    template<typename Value_Type, class Allocator>
+    struct btree_node_
+    {
+    public:
+      typedef Value_Type value_type;
+
+      typedef typename Allocator::size_type size_type;
+
+      typedef
+      typename Allocator::template rebind<
+      btree_node_<
+      Value_Type,
+      Allocator> >::other::pointer
+      node_pointer;
+
+      typedef
+      typename Allocator::template rebind<
+      btree_inner_node_<
+      Value_Type,
+      Allocator> >::other::pointer
+      inner_node_pointer;
+
+      enum
+	{
+	  capacity = btree_node_capacity<Value_Type>::value,
+	  min_count = (capacity - 1) / 2
+	};
+
+      inline value_type*
+      value_ptr(size_type pos)
+      { return static_cast<value_type*>(static_cast<void*>(&m_values)) + pos; }
+
+      inline const value_type*
+      value_ptr(size_type pos) const
+      {
+	return static_cast<const value_type*>(static_cast<const void*>(&m_values))
+	  + pos;
+      }
+
+      inline node_pointer&
+      child(size_type pos);
+
+      inline node_pointer
+      child(size_type pos) const;
+
+      node_pointer m_p_parent;
+
+      // Index of this node among its parent's children.
+      unsigned short m_pos;
+
+      unsigned short m_count;
+
+      bool m_leaf;
+
+      // The values, stored contiguously. The spare slot lets a node
+      // overflow by one value before it is split.
+      typename std::tr1::aligned_storage<
+	sizeof(value_type) * (capacity + 1),
+	std::tr1::alignment_of<value_type>::value>::type m_values;
+    };
+
+    template<typename Value_Type, class Allocator>
+    struct btree_inner_node_ : public btree_node_<Value_Type, Allocator>
+    {
+      typedef btree_node_<Value_Type, Allocator> base_type;
+
+      typename base_type::node_pointer m_a_children[base_type::capacity + 2];
+    };
+
+    template<typename Value_Type, class Allocator>
+    inline typename btree_node_<Value_Type, Allocator>::node_pointer&
+    btree_node_<Value_Type, Allocator>::
+    child(size_type pos)
+    {
+      _GLIBCXX_DEBUG_ASSERT(!m_leaf);
+      return static_cast<inner_node_pointer>(this)->m_a_children[pos];
+    }
+
+    template<typename Value_Type, class Allocator>
+    inline typename btree_node_<Value_Type, Allocator>::node_pointer
+    btree_node_<Value_Type, Allocator>::
+    child(size_type pos) const
+    {
+      _GLIBCXX_DEBUG_ASSERT(!m_leaf);
+      return const_cast<btree_node_*>(this)->child(pos);
+    }
+
+    // Advances (r_p_nd, r_pos) to the in-order successor. The position
+    // one past the last value of the rightmost leaf is the end.
+    template<typename Node_Pointer, typename Size_Type>
+    inline void
+    btree_inc(Node_Pointer& r_p_nd, Size_Type& r_pos)
+    {
+      if (!r_p_nd->m_leaf)
+	{
+	  Node_Pointer p_nd = r_p_nd->child(r_pos + 1);
+	  while (!p_nd->m_leaf)
+	    p_nd = p_nd->child(0);
+	  r_p_nd = p_nd;
+	  r_pos = 0;
+	  return;
+	}
+
+      if (++r_pos < r_p_nd->m_count)
+	return;
+
+      Node_Pointer p_nd = r_p_nd;
+      while (p_nd->m_p_parent != NULL
+	     && p_nd->m_pos == p_nd->m_p_parent->m_count)
+	p_nd = p_nd->m_p_parent;
+
+      if (p_nd->m_p_parent == NULL)
+	return;
+
+      r_pos = p_nd->m_pos;
+      r_p_nd = p_nd->m_p_parent;
+    }
+
+    // Moves (r_p_nd, r_pos) to the in-order predecessor.
+    template<typename Node_Pointer, typename Size_Type>
+    inline void
+    btree_dec(Node_Pointer& r_p_nd, Size_Type& r_pos)
+    {
+      if (!r_p_nd->m_leaf)
+	{
+	  Node_Pointer p_nd = r_p_nd->child(r_pos);
+	  while (!p_nd->m_leaf)
+	    p_nd = p_nd->child(p_nd->m_count);
+	  r_p_nd = p_nd;
+	  r_pos = p_nd->m_count - 1;
+	  return;
+	}
+
+      if (r_pos > 0)
+	{
+	  --r_pos;
+	  return;
+	}
+
+      Node_Pointer p_nd = r_p_nd;
+      while (p_nd->m_p_parent != NULL && p_nd->m_pos == 0)
+	p_nd = p_nd->m_p_parent;
+
+      _GLIBCXX_DEBUG_ASSERT(p_nd->m_p_parent != NULL);
+      r_pos = p_nd->m_pos - 1;
+      r_p_nd = p_nd->m_p_parent;
+    }
+
+  } // namespace detail
+} // namespace pb_ds
+
+#endif // #ifndef PB_DS_BTREE_NODE_HPP
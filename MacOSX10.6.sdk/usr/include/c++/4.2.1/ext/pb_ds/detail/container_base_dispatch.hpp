@@ -81,6 +81,14 @@
 #include <ext/pb_ds/detail/ov_tree_map_/ov_tree_map_.hpp>
 #undef PB_DS_DATA_FALSE_INDICATOR
 
+#define PB_DS_DATA_TRUE_INDICATOR
+#include <ext/pb_ds/detail/btree_map_/btree_.hpp>
+#undef PB_DS_DATA_TRUE_INDICATOR
+
+#define PB_DS_DATA_FALSE_INDICATOR
+#include <ext/pb_ds/detail/btree_map_/btree_.hpp>
+#undef PB_DS_DATA_FALSE_INDICATOR
+
 #define PB_DS_DATA_TRUE_INDICATOR
 #include <ext/pb_ds/detail/cc_hash_table_map_/cc_ht_map_.hpp>
 #undef PB_DS_DATA_TRUE_INDICATOR
@@ -105,6 +113,14 @@
 #include <ext/pb_ds/detail/pat_trie_/pat_trie_.hpp>
 #undef PB_DS_DATA_FALSE_INDICATOR
 
+#define PB_DS_DATA_TRUE_INDICATOR
+#include <ext/pb_ds/detail/art_trie_/art_trie_.hpp>
+#undef PB_DS_DATA_TRUE_INDICATOR
+
+#define PB_DS_DATA_FALSE_INDICATOR
+#include <ext/pb_ds/detail/art_trie_/art_trie_.hpp>
+#undef PB_DS_DATA_FALSE_INDICATOR
+
 namespace pb_ds
 {
 namespace detail
@@ -165,6 +181,29 @@ namespace detail
       typedef pat_trie_no_data_<Key, null_mapped_type, at1t, Alloc> type;
     };
 
+  template<typename Key, typename Mapped, typename Policy_Tl, typename Alloc>
+    struct container_base_dispatch<Key, Mapped, art_trie_tag, Policy_Tl, Alloc>
+    {
+    private:
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 1> 	at1;
+      typedef typename at1::type			    	at1t;
+
+    public:
+      typedef art_trie_data_<Key, Mapped, at1t, Alloc> 		type;
+    };
+
+  template<typename Key, typename Policy_Tl, typename Alloc>
+    struct container_base_dispatch<Key, null_mapped_type, art_trie_tag,
+				   Policy_Tl, Alloc>
+    {
+    private:
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 1> 	at1;
+      typedef typename at1::type			    	at1t;
+
+    public:
+      typedef art_trie_no_data_<Key, null_mapped_type, at1t, Alloc> type;
+    };
+
   template<typename Key, typename Mapped, typename Policy_Tl, typename Alloc>
     struct container_base_dispatch<Key, Mapped, rb_tree_tag, Policy_Tl, Alloc>
     {
@@ -247,6 +286,33 @@ namespace detail
       typedef ov_tree_no_data_<Key, null_mapped_type, at0t, at1t, Alloc> type;
   };
 
+  template<typename Key, typename Mapped, typename Policy_Tl, typename Alloc>
+    struct container_base_dispatch<Key, Mapped, btree_tag, Policy_Tl, Alloc>
+    {
+    private:
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 0>	at0;
+      typedef typename at0::type			    	at0t;
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 1> 	at1;
+      typedef typename at1::type			    	at1t;
+
+    public:
+      typedef btree_data_<Key, Mapped, at0t, at1t, Alloc> 	type;
+  };
+
+  template<typename Key, typename Policy_Tl, typename Alloc>
+    struct container_base_dispatch<Key, null_mapped_type, btree_tag,
+				   Policy_Tl, Alloc>
+    {
+    private:
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 0>	at0;
+      typedef typename at0::type			    	at0t;
+      typedef __gnu_cxx::typelist::at_index<Policy_Tl, 1> 	at1;
+      typedef typename at1::type			    	at1t;
+
+    public:
+      typedef btree_no_data_<Key, null_mapped_type, at0t, at1t, Alloc> type;
+  };
+
   template<typename Key, typename Mapped, typename Policy_Tl, typename Alloc>
     struct container_base_dispatch<Key, Mapped, cc_hash_tag, Policy_Tl, Alloc>
     {
@@ -0,0 +1,180 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file constructors_destructor_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::sub_queue_allocator
+PB_DS_CLASS_C_DEC::s_sub_queue_allocator;
+
+PB_DS_CLASS_T_DEC
+template<typename It>
+void
+PB_DS_CLASS_C_DEC::
+copy_from_range(It first_it, It last_it)
+{
+  // Only called while constructing, so no locking is needed.
+  size_type n = 0;
+  while (first_it != last_it)
+    {
+      m_a_queues[n % m_num_queues].m_heap.push(*(first_it++));
+      m_size.fetch_add(1, __gnu_cxx::memory_order_relaxed);
+      ++n;
+    }
+
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+    }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+multi_queue_() :
+  m_a_queues(NULL),
+  m_num_queues(0),
+  m_size(0),
+  m_seed(0)
+{
+  initialize();
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+    }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+multi_queue_(const Cmp_Fn& r_cmp_fn) :
+  Cmp_Fn(r_cmp_fn),
+  m_a_queues(NULL),
+  m_num_queues(0),
+  m_size(0),
+  m_seed(0)
+{
+  initialize();
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+    }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+multi_queue_(const PB_DS_CLASS_C_DEC& other) :
+  Cmp_Fn(other),
+  m_a_queues(NULL),
+  m_num_queues(0),
+  m_size(0),
+  m_seed(0)
+{
+  initialize();
+  other.lock_all();
+  try
+    {
+      for (size_type i = 0; i < other.m_num_queues; ++i)
+	{
+	  heap_type tmp(other.m_a_queues[i].m_heap);
+	  m_a_queues[i % m_num_queues].m_heap.join(tmp);
+	}
+    }
+  catch(...)
+    {
+      other.unlock_all();
+      deallocate_queues();
+      __throw_exception_again;
+    }
+  m_size.store(other.m_size.load(__gnu_cxx::memory_order_relaxed),
+	       __gnu_cxx::memory_order_relaxed);
+  other.unlock_all();
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+    }
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+initialize()
+{
+  size_type num_queues = 2;
+#ifdef _SC_NPROCESSORS_ONLN
+  const long num_cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+  if (num_cpus > 1)
+    num_queues = 2 * static_cast<size_type>(num_cpus);
+#endif
+
+  m_a_queues = s_sub_queue_allocator.allocate(num_queues);
+  size_type i = 0;
+  try
+    {
+      for (; i < num_queues; ++i)
+	new (m_a_queues + i) sub_queue(static_cast<const Cmp_Fn&>(*this));
+    }
+  catch(...)
+    {
+      while (i > 0)
+	m_a_queues[--i].~sub_queue();
+      s_sub_queue_allocator.deallocate(m_a_queues, num_queues);
+      m_a_queues = NULL;
+      __throw_exception_again;
+    }
+  m_num_queues = num_queues;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+deallocate_queues()
+{
+  for (size_type i = 0; i < m_num_queues; ++i)
+    m_a_queues[i].~sub_queue();
+  s_sub_queue_allocator.deallocate(m_a_queues, m_num_queues);
+  m_a_queues = NULL;
+  m_num_queues = 0;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+swap(PB_DS_CLASS_C_DEC& other)
+{
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+
+  std::swap(m_a_queues, other.m_a_queues);
+  std::swap(m_num_queues, other.m_num_queues);
+  const size_type size = m_size.load(__gnu_cxx::memory_order_relaxed);
+  m_size.store(other.m_size.load(__gnu_cxx::memory_order_relaxed),
+	       __gnu_cxx::memory_order_relaxed);
+  other.m_size.store(size, __gnu_cxx::memory_order_relaxed);
+  std::swap((Cmp_Fn& )(*this), (Cmp_Fn& )other);
+
+  _GLIBCXX_DEBUG_ONLY(assert_valid();)
+  _GLIBCXX_DEBUG_ONLY(other.assert_valid();)
+    }
+
+PB_DS_CLASS_T_DEC
+PB_DS_CLASS_C_DEC::
+~multi_queue_()
+{ deallocate_queues(); }
+
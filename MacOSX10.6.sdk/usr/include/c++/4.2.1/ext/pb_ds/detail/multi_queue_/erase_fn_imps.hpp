@@ -0,0 +1,184 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file erase_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+bool
+PB_DS_CLASS_C_DEC::
+try_pop(reference r_val)
+{
+  const size_type hash = thread_hash();
+
+  // Two random choices, skipping sub-queues other threads hold.
+  for (size_type attempt = 0; attempt < 4 * m_num_queues; ++attempt)
+    {
+      if (m_size.load(__gnu_cxx::memory_order_relaxed) == 0)
+	return false;
+
+      size_type q = random_queue(hash);
+      if (!m_a_queues[q].m_mutex.try_lock())
+	continue;
+
+      const size_type other = random_queue(hash + 1);
+      if (other != q && m_a_queues[other].m_mutex.try_lock())
+	{
+	  const heap_type& r_heap = m_a_queues[q].m_heap;
+	  const heap_type& r_other = m_a_queues[other].m_heap;
+	  if (!r_other.empty()
+	      && (r_heap.empty()
+		  || Cmp_Fn::operator()(r_heap.top(), r_other.top())))
+	    {
+	      m_a_queues[q].m_mutex.unlock();
+	      q = other;
+	    }
+	  else
+	    m_a_queues[other].m_mutex.unlock();
+	}
+
+      heap_type& r_heap = m_a_queues[q].m_heap;
+      if (!r_heap.empty())
+	{
+	  try
+	    {
+	      r_val = r_heap.top();
+	    }
+	  catch(...)
+	    {
+	      m_a_queues[q].m_mutex.unlock();
+	      __throw_exception_again;
+	    }
+	  r_heap.pop();
+	  m_a_queues[q].m_mutex.unlock();
+	  m_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+	  return true;
+	}
+      m_a_queues[q].m_mutex.unlock();
+    }
+
+  // The few values left are hidden in sub-queues the random choices
+  // missed; sweep them so that a non-empty queue is never reported
+  // as empty.
+  for (size_type q = 0; q < m_num_queues; ++q)
+    {
+      sub_queue& r_sub = m_a_queues[q];
+      r_sub.m_mutex.lock();
+      if (!r_sub.m_heap.empty())
+	{
+	  try
+	    {
+	      r_val = r_sub.m_heap.top();
+	    }
+	  catch(...)
+	    {
+	      r_sub.m_mutex.unlock();
+	      __throw_exception_again;
+	    }
+	  r_sub.m_heap.pop();
+	  r_sub.m_mutex.unlock();
+	  m_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+	  return true;
+	}
+      r_sub.m_mutex.unlock();
+    }
+  return false;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+pop()
+{
+  lock_all();
+  const size_type q = top_queue();
+  _GLIBCXX_DEBUG_ASSERT(q != m_num_queues);
+  m_a_queues[q].m_heap.pop();
+  unlock_all();
+  m_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+erase(point_iterator it)
+{
+  _GLIBCXX_DEBUG_ASSERT(it.m_queue < m_num_queues);
+  sub_queue& r_sub = m_a_queues[it.m_queue];
+  r_sub.m_mutex.lock();
+  r_sub.m_heap.erase(it);
+  r_sub.m_mutex.unlock();
+  m_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+}
+
+PB_DS_CLASS_T_DEC
+template<typename Pred>
+typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+erase_if(Pred pred)
+{
+  lock_all();
+  size_type erased = 0;
+  try
+    {
+      for (size_type i = 0; i < m_num_queues; ++i)
+	erased += m_a_queues[i].m_heap.erase_if(pred);
+    }
+  catch(...)
+    {
+      m_size.fetch_sub(erased, __gnu_cxx::memory_order_relaxed);
+      unlock_all();
+      __throw_exception_again;
+    }
+  m_size.fetch_sub(erased, __gnu_cxx::memory_order_relaxed);
+  unlock_all();
+  return erased;
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+clear()
+{
+  // Subtract rather than reset the count, since pushes in progress
+  // have already been counted.
+  lock_all();
+  size_type erased = 0;
+  for (size_type i = 0; i < m_num_queues; ++i)
+    {
+      erased += m_a_queues[i].m_heap.size();
+      m_a_queues[i].m_heap.clear();
+    }
+  m_size.fetch_sub(erased, __gnu_cxx::memory_order_relaxed);
+  unlock_all();
+}
+
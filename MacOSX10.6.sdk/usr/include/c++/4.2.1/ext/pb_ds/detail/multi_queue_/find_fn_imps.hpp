@@ -0,0 +1,64 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file find_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+top_queue() const
+{
+  // Requires every sub-queue to be locked.
+  size_type best = m_num_queues;
+  for (size_type i = 0; i < m_num_queues; ++i)
+    if (!m_a_queues[i].m_heap.empty()
+	&& (best == m_num_queues
+	    || Cmp_Fn::operator()(m_a_queues[best].m_heap.top(),
+				  m_a_queues[i].m_heap.top())))
+      best = i;
+  return best;
+}
+
+PB_DS_CLASS_T_DEC
+typename PB_DS_CLASS_C_DEC::const_reference
+PB_DS_CLASS_C_DEC::
+top() const
+{
+  lock_all();
+  const size_type q = top_queue();
+  _GLIBCXX_DEBUG_ASSERT(q != m_num_queues);
+  const_reference r_top = m_a_queues[q].m_heap.top();
+  unlock_all();
+  return r_top;
+}
+
@@ -0,0 +1,146 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file info_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+inline bool
+PB_DS_CLASS_C_DEC::
+empty() const
+{ return size() == 0; }
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+size() const
+{ return m_size.load(__gnu_cxx::memory_order_relaxed); }
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+max_size() const
+{ return m_a_queues[0].m_heap.max_size(); }
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+num_queues() const
+{ return m_num_queues; }
+
+PB_DS_CLASS_T_DEC
+Cmp_Fn& 
+PB_DS_CLASS_C_DEC::
+get_cmp_fn()
+{ return *this; }
+
+PB_DS_CLASS_T_DEC
+const Cmp_Fn& 
+PB_DS_CLASS_C_DEC::
+get_cmp_fn() const
+{ return *this; }
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+lock_all() const
+{
+  for (size_type i = 0; i < m_num_queues; ++i)
+    m_a_queues[i].m_mutex.lock();
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+unlock_all() const
+{
+  for (size_type i = m_num_queues; i > 0; --i)
+    m_a_queues[i - 1].m_mutex.unlock();
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+lock_pair(PB_DS_CLASS_C_DEC& other)
+{
+  // Lock the two containers in address order so that opposite
+  // split or join calls cannot deadlock.
+  if (this < &other)
+    {
+      lock_all();
+      other.lock_all();
+    }
+  else
+    {
+      other.lock_all();
+      lock_all();
+    }
+}
+
+PB_DS_CLASS_T_DEC
+inline void
+PB_DS_CLASS_C_DEC::
+unlock_pair(PB_DS_CLASS_C_DEC& other)
+{
+  unlock_all();
+  other.unlock_all();
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+thread_hash() const
+{
+#ifdef __GTHREADS
+  size_type h = (size_type)__gthread_self();
+#else
+  size_type h = 0;
+#endif
+  h ^= h >> 7;
+  h ^= h >> 17;
+  return h * 2654435761u;
+}
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::size_type
+PB_DS_CLASS_C_DEC::
+random_queue(size_type hash) const
+{
+  // A shared linear congruential generator; lost updates between
+  // racing threads are harmless, and the thread hash keeps them from
+  // picking the same sub-queues.
+  size_type seed = m_seed.load(__gnu_cxx::memory_order_relaxed);
+  seed = seed * 1103515245u + 12345u;
+  m_seed.store(seed, __gnu_cxx::memory_order_relaxed);
+  return ((seed >> 8) ^ hash) % m_num_queues;
+}
+
@@ -0,0 +1,92 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file insert_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+inline typename PB_DS_CLASS_C_DEC::point_iterator
+PB_DS_CLASS_C_DEC::
+push(const_reference r_val)
+{
+  const size_type start = random_queue(thread_hash());
+
+  // Prefer any uncontended sub-queue; block only if all are busy.
+  size_type q = start;
+  size_type tries = 0;
+  while (tries < m_num_queues && !m_a_queues[q].m_mutex.try_lock())
+    {
+      ++tries;
+      q = q + 1 == m_num_queues ? 0 : q + 1;
+    }
+  if (tries == m_num_queues)
+    {
+      q = start;
+      m_a_queues[q].m_mutex.lock();
+    }
+
+  m_size.fetch_add(1, __gnu_cxx::memory_order_relaxed);
+  heap_point_iterator it;
+  try
+    {
+      it = m_a_queues[q].m_heap.push(r_val);
+    }
+  catch(...)
+    {
+      m_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+      m_a_queues[q].m_mutex.unlock();
+      __throw_exception_again;
+    }
+  m_a_queues[q].m_mutex.unlock();
+  return point_iterator(it, q);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+modify(point_iterator it, const_reference r_new_val)
+{
+  _GLIBCXX_DEBUG_ASSERT(it.m_queue < m_num_queues);
+  sub_queue& r_sub = m_a_queues[it.m_queue];
+  r_sub.m_mutex.lock();
+  try
+    {
+      r_sub.m_heap.modify(it, r_new_val);
+    }
+  catch(...)
+    {
+      r_sub.m_mutex.unlock();
+      __throw_exception_again;
+    }
+  r_sub.m_mutex.unlock();
+}
+
@@ -0,0 +1,270 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file multi_queue_.hpp
+ * Contains an implementation class for a relaxed concurrent multi-queue.
+ */
+
+/*
+ * Multi-queue:
+ * Hamza Rihani, Peter Sanders, Roman Dementiev,
+ *    MultiQueues: Simpler, Faster, and Better Relaxed Concurrent
+ *    Priority Queues, arXiv:1411.1209, 2014.
+ */
+
+#ifndef PB_DS_MULTI_QUEUE_HPP
+#define PB_DS_MULTI_QUEUE_HPP
+
+#include <unistd.h>
+#include <ext/atomic>
+#include <ext/concurrence.h>
+#include <ext/pb_ds/detail/multi_queue_/point_iterators.hpp>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+
+#define PB_DS_CLASS_T_DEC \
+    template<typename Value_Type, class Cmp_Fn, class Allocator>
+
+#define PB_DS_CLASS_C_DEC \
+    multi_queue_<Value_Type, Cmp_Fn, Allocator>
+
+    /**
+     * A relaxed priority queue for concurrent use. Values are spread
+     * over several pairing heaps, each guarded by its own lock. push,
+     * try_pop, modify, erase, size and empty may be called from many
+     * threads at once; try_pop removes the better top of two randomly
+     * chosen heaps, which is near, but not always, the global top.
+     * top and pop are exact and lock every heap; they are not atomic
+     * as a pair, so concurrent consumers should use try_pop. A point
+     * iterator passed to modify or erase must still refer to a value
+     * in the container, which callers must ensure when other threads
+     * pop. The remaining operations (iteration, erase_if, split,
+     * join, clear, swap, copying) lock every heap, and iteration must
+     * not overlap with modifications.
+     **/
+    template<typename Value_Type, class Cmp_Fn, class Allocator>
+    class multi_queue_ : public Cmp_Fn
+    {
+
+    private:
+      typedef pairing_heap_<Value_Type, Cmp_Fn, Allocator> heap_type;
+
+      typedef multi_queue_sub_<heap_type> sub_queue;
+
+      typedef
+      typename Allocator::template rebind<sub_queue>::other
+      sub_queue_allocator;
+
+      typedef typename sub_queue_allocator::pointer sub_queue_pointer;
+
+      typedef typename heap_type::point_iterator heap_point_iterator;
+
+    public:
+
+      typedef typename Allocator::size_type size_type;
+
+      typedef typename Allocator::difference_type difference_type;
+
+      typedef Value_Type value_type;
+
+      typedef typename heap_type::pointer pointer;
+
+      typedef typename heap_type::const_pointer const_pointer;
+
+      typedef typename heap_type::reference reference;
+
+      typedef typename heap_type::const_reference const_reference;
+
+      typedef
+      multi_queue_point_iterator_<sub_queue, size_type>
+      const_point_iterator;
+
+      typedef const_point_iterator point_iterator;
+
+      typedef
+      multi_queue_const_iterator_<sub_queue, size_type>
+      const_iterator;
+
+      typedef const_iterator iterator;
+
+      typedef Cmp_Fn cmp_fn;
+
+      typedef Allocator allocator;
+
+
+      multi_queue_();
+
+      multi_queue_(const Cmp_Fn& r_cmp_fn);
+
+      multi_queue_(const PB_DS_CLASS_C_DEC& other);
+
+      void
+      swap(PB_DS_CLASS_C_DEC& other);
+
+      ~multi_queue_();
+
+      inline point_iterator
+      push(const_reference r_val);
+
+      void
+      modify(point_iterator it, const_reference r_new_val);
+
+      bool
+      try_pop(reference r_val);
+
+      const_reference
+      top() const;
+
+      void
+      pop();
+
+      void
+      erase(point_iterator it);
+
+      template<typename Pred>
+      size_type
+      erase_if(Pred pred);
+
+      template<typename Pred>
+      void
+      split(Pred pred, PB_DS_CLASS_C_DEC& other);
+
+      void
+      join(PB_DS_CLASS_C_DEC& other);
+
+      void
+      clear();
+
+      inline bool
+      empty() const;
+
+      inline size_type
+      size() const;
+
+      inline size_type
+      max_size() const;
+
+      // Number of sub-queues.
+      inline size_type
+      num_queues() const;
+
+      Cmp_Fn& 
+      get_cmp_fn();
+
+      const Cmp_Fn& 
+      get_cmp_fn() const;
+
+      inline iterator
+      begin();
+
+      inline const_iterator
+      begin() const;
+
+      inline iterator
+      end();
+
+      inline const_iterator
+      end() const;
+
+    protected:
+
+      template<typename It>
+      void
+      copy_from_range(It first_it, It last_it);
+
+#ifdef _GLIBCXX_DEBUG
+      void
+      assert_valid() const;
+#endif
+
+    private:
+
+      void
+      initialize();
+
+      void
+      deallocate_queues();
+
+      void
+      lock_all() const;
+
+      void
+      unlock_all() const;
+
+      size_type
+      top_queue() const;
+
+      inline size_type
+      thread_hash() const;
+
+      inline size_type
+      random_queue(size_type hash) const;
+
+      inline void
+      lock_pair(PB_DS_CLASS_C_DEC& other);
+
+      inline void
+      unlock_pair(PB_DS_CLASS_C_DEC& other);
+
+    private:
+      static sub_queue_allocator s_sub_queue_allocator;
+
+      sub_queue_pointer m_a_queues;
+
+      size_type m_num_queues;
+
+      // Never less than the number of values stored: push counts a
+      // value before adding it and removals count it afterwards.
+      __gnu_cxx::atomic<size_type> m_size;
+
+      mutable __gnu_cxx::atomic<size_type> m_seed;
+    };
+
+#include <ext/pb_ds/detail/multi_queue_/constructors_destructor_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/debug_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/info_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/iterators_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/find_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/insert_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/erase_fn_imps.hpp>
+#include <ext/pb_ds/detail/multi_queue_/split_join_fn_imps.hpp>
+
+#undef PB_DS_CLASS_C_DEC
+#undef PB_DS_CLASS_T_DEC
+
+  } // namespace detail
+} // namespace pb_ds
+
+#endif // #ifndef PB_DS_MULTI_QUEUE_HPP
@@ -0,0 +1,170 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file point_iterators.hpp
+ * Contains the sub-queues and iterators of multi_queue_.
+ */
+
+#ifndef PB_DS_MULTI_QUEUE_ITERATORS_HPP
+#define PB_DS_MULTI_QUEUE_ITERATORS_HPP
+
+#include <iterator>
+#include <ext/concurrence.h>
+#include <debug/debug.h>
+
+namespace pb_ds
+{
+  namespace detail
+  {
+    // One heap of a multi-queue together with the lock guarding it.
+    template<typename Heap>
+    struct multi_queue_sub_
+    {
+      typedef Heap heap_type;
+
+      explicit
+      multi_queue_sub_(const typename Heap::cmp_fn& r_cmp_fn)
+      : m_heap(r_cmp_fn)
+      { }
+
+      Heap m_heap;
+
+      __gnu_cxx::__adaptive_mutex m_mutex;
+
+      // Keeps the locks of neighbouring sub-queues off each other's
+      // cache lines.
+      char m_pad[64];
+    };
+
+    // Point iterator: a heap point iterator plus the index of the
+    // sub-queue holding the value.
+    template<typename Sub_Queue, typename Size_Type>
+    class multi_queue_point_iterator_
+    : public Sub_Queue::heap_type::const_point_iterator
+    {
+    protected:
+      typedef typename Sub_Queue::heap_type::const_point_iterator base_type;
+
+    public:
+      inline
+      multi_queue_point_iterator_() : m_queue(0)
+      { }
+
+      inline
+      multi_queue_point_iterator_(const base_type& r_it, Size_Type queue)
+      : base_type(r_it), m_queue(queue)
+      { }
+
+    public:
+      Size_Type m_queue;
+    };
+
+    // Const iterator; visits the sub-queues one after the other.
+    template<typename Sub_Queue, typename Size_Type>
+    class multi_queue_const_iterator_
+    : public multi_queue_point_iterator_<Sub_Queue, Size_Type>
+    {
+    private:
+      typedef multi_queue_point_iterator_<Sub_Queue, Size_Type> base_type;
+
+      typedef typename Sub_Queue::heap_type::const_iterator heap_iterator;
+
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+
+      typedef typename heap_iterator::difference_type difference_type;
+
+      typedef typename heap_iterator::value_type value_type;
+
+      typedef typename heap_iterator::pointer pointer;
+
+      typedef typename heap_iterator::const_pointer const_pointer;
+
+      typedef typename heap_iterator::reference reference;
+
+      typedef typename heap_iterator::const_reference const_reference;
+
+    public:
+      inline
+      multi_queue_const_iterator_() : m_a_queues(NULL), m_num_queues(0)
+      { }
+
+      // Iterator to the first value of sub-queue queue or of a
+      // following one.
+      inline
+      multi_queue_const_iterator_(Sub_Queue* a_queues, Size_Type num_queues,
+				  Size_Type queue)
+      : m_a_queues(a_queues), m_num_queues(num_queues)
+      {
+	base_type::m_queue = queue;
+	if (queue < num_queues)
+	  base_type::m_p_nd = a_queues[queue].m_heap.begin().m_p_nd;
+	skip_empty();
+      }
+
+      inline multi_queue_const_iterator_& 
+      operator++()
+      {
+	_GLIBCXX_DEBUG_ASSERT(base_type::m_p_nd != NULL);
+	heap_iterator it(base_type::m_p_nd);
+	++it;
+	base_type::m_p_nd = it.m_p_nd;
+	skip_empty();
+	return *this;
+      }
+
+      inline multi_queue_const_iterator_
+      operator++(int)
+      {
+	multi_queue_const_iterator_ ret_it(*this);
+	operator++();
+	return ret_it;
+      }
+
+    private:
+      inline void
+      skip_empty()
+      {
+	while (base_type::m_p_nd == NULL
+	       && base_type::m_queue + 1 < m_num_queues)
+	  base_type::m_p_nd =
+	    m_a_queues[++base_type::m_queue].m_heap.begin().m_p_nd;
+      }
+
+      Sub_Queue* m_a_queues;
+
+      Size_Type m_num_queues;
+    };
+
+  } // namespace detail
+} // namespace pb_ds
+
+#endif // #ifndef PB_DS_MULTI_QUEUE_ITERATORS_HPP
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the terms
+// of the GNU General Public License as published by the Free Software
+// Foundation; either version 2, or (at your option) any later
+// version.
+
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this library; see the file COPYING.  If not, write to
+// the Free Software Foundation, 59 Temple Place - Suite 330, Boston,
+// MA 02111-1307, USA.
+
+// As a special exception, you may use this file as part of a free
+// software library without restriction.  Specifically, if other files
+// instantiate templates or use macros or inline functions from this
+// file, or you compile this file and link it with other files to
+// produce an executable, this file does not by itself cause the
+// resulting executable to be covered by the GNU General Public
+// License.  This exception does not however invalidate any other
+// reasons why the executable file might be covered by the GNU General
+// Public License.
+
+/**
+ * @file split_join_fn_imps.hpp
+ * Contains an implementation class for a multi-queue.
+ */
+
+PB_DS_CLASS_T_DEC
+template<typename Pred>
+void
+PB_DS_CLASS_C_DEC::
+split(Pred pred, PB_DS_CLASS_C_DEC& other)
+{
+  other.clear();
+  lock_pair(other);
+  size_type moved = 0;
+  try
+    {
+      for (size_type i = 0; i < m_num_queues; ++i)
+	{
+	  heap_type tmp(static_cast<const Cmp_Fn&>(*this));
+	  m_a_queues[i].m_heap.split(pred, tmp);
+	  const size_type n = tmp.size();
+	  other.m_a_queues[i % other.m_num_queues].m_heap.join(tmp);
+	  moved += n;
+	}
+    }
+  catch(...)
+    {
+      m_size.fetch_sub(moved, __gnu_cxx::memory_order_relaxed);
+      other.m_size.fetch_add(moved, __gnu_cxx::memory_order_relaxed);
+      unlock_pair(other);
+      __throw_exception_again;
+    }
+  m_size.fetch_sub(moved, __gnu_cxx::memory_order_relaxed);
+  other.m_size.fetch_add(moved, __gnu_cxx::memory_order_relaxed);
+  unlock_pair(other);
+}
+
+PB_DS_CLASS_T_DEC
+void
+PB_DS_CLASS_C_DEC::
+join(PB_DS_CLASS_C_DEC& other)
+{
+  lock_pair(other);
+  size_type moved = 0;
+  for (size_type i = 0; i < other.m_num_queues; ++i)
+    {
+      heap_type& r_heap = other.m_a_queues[i].m_heap;
+      const size_type n = r_heap.size();
+      m_a_queues[i % m_num_queues].m_heap.join(r_heap);
+      moved += n;
+    }
+  m_size.fetch_add(moved, __gnu_cxx::memory_order_relaxed);
+  other.m_size.fetch_sub(moved, __gnu_cxx::memory_order_relaxed);
+  unlock_pair(other);
+}
+
@@ -52,6 +52,7 @@
 #include <ext/pb_ds/detail/rc_binomial_heap_/rc_binomial_heap_.hpp>
 #include <ext/pb_ds/detail/binary_heap_/binary_heap_.hpp>
 #include <ext/pb_ds/detail/thin_heap_/thin_heap_.hpp>
+#include <ext/pb_ds/detail/multi_queue_/multi_queue_.hpp>
 
 namespace pb_ds
 {
@@ -91,6 +92,12 @@ namespace pb_ds
 	typedef thin_heap_< Value_Type, Cmp_Fn, Allocator> type;
       };
 
+      template<typename Value_Type, typename Cmp_Fn, typename Allocator>
+      struct priority_queue_base_dispatch<Value_Type, Cmp_Fn, multi_queue_tag, Allocator>
+      {
+	typedef multi_queue_< Value_Type, Cmp_Fn, Allocator> type;
+      };
+
     } // namespace detail
 } // namespace pb_ds
 
@@ -121,12 +121,18 @@ namespace pb_ds
   // Ordered-vector tree.
   struct ov_tree_tag : public tree_tag { };
 
+  // B-tree.
+  struct btree_tag : public tree_tag { };
+
   // trie.
   struct trie_tag : public basic_tree_tag { };
 
   // PATRICIA trie.
   struct pat_trie_tag : public trie_tag { };
 
+  // Adaptive radix trie.
+  struct art_trie_tag : public trie_tag { };
+
   // List-update.
   struct list_update_tag : public associative_container_tag { };
 
@@ -148,6 +154,9 @@ namespace pb_ds
   // Thin heap.
   struct thin_heap_tag : public priority_queue_tag { };
 
+  // Relaxed concurrent multi-queue.
+  struct multi_queue_tag : public priority_queue_tag { };
+
 
   template<typename Tag>
   struct container_traits_base;
@@ -227,6 +236,21 @@ namespace pb_ds
       };
   };
 
+  template<>
+  struct container_traits_base<btree_tag>
+  {
+    typedef btree_tag container_category;
+    typedef basic_invalidation_guarantee invalidation_guarantee;
+
+    enum
+      {
+        order_preserving = true,
+        erase_can_throw = true,
+        split_join_can_throw = true,
+        reverse_iteration = false
+      };
+  };
+
   template<>
   struct container_traits_base<pat_trie_tag>
   {
@@ -242,6 +266,21 @@ namespace pb_ds
       };
   };
 
+  template<>
+  struct container_traits_base<art_trie_tag>
+  {
+    typedef art_trie_tag container_category;
+    typedef range_invalidation_guarantee invalidation_guarantee;
+
+    enum
+      {
+        order_preserving = true,
+        erase_can_throw = false,
+        split_join_can_throw = true,
+        reverse_iteration = false
+      };
+  };
+
   template<>
   struct container_traits_base<list_update_tag>
   {
@@ -333,6 +372,21 @@ namespace pb_ds
       };
   };
 
+  template<>
+  struct container_traits_base<multi_queue_tag>
+  {
+    typedef multi_queue_tag container_category;
+    typedef point_invalidation_guarantee invalidation_guarantee;
+
+    enum
+      {
+        order_preserving = false,
+        erase_can_throw = false,
+	split_join_can_throw = false,
+        reverse_iteration = false
+      };
+  };
+
   
   // See Matt Austern for the name, S. Meyers MEFC++ #2, others.
   template<typename Cntnr>
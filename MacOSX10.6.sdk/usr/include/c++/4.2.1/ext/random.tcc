@@ -0,0 +1,426 @@
+// Random number extensions -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/random.tcc
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+#ifdef __SSE2__
+  typedef int __sfmt_v4si
+    __attribute__((__vector_size__(16), __may_alias__));
+  typedef long long __sfmt_v2di
+    __attribute__((__vector_size__(16), __may_alias__));
+
+  // One step of the SFMT recursion on SSE2 registers.
+  template<int __sl1, int __sl2, int __sr1, int __sr2>
+    inline __sfmt_v4si
+    __sfmt_recursion(__sfmt_v4si __a, __sfmt_v4si __b, __sfmt_v4si __c,
+		     __sfmt_v4si __d, __sfmt_v4si __mask)
+    {
+      const __sfmt_v4si __x = (__sfmt_v4si)
+	__builtin_ia32_pslldqi128((__sfmt_v2di)__a, __sl2 * 8);
+      const __sfmt_v4si __y = __builtin_ia32_psrldi128(__b, __sr1) & __mask;
+      const __sfmt_v4si __z = (__sfmt_v4si)
+	__builtin_ia32_psrldqi128((__sfmt_v2di)__c, __sr2 * 8);
+      const __sfmt_v4si __v = __builtin_ia32_pslldi128(__d, __sl1);
+      return __a ^ __x ^ __y ^ __z ^ __v;
+    }
+#else
+  // One step of the SFMT recursion on four 32-bit lanes, least
+  // significant first; __sl2 and __sr2 shift the whole 128-bit word.
+  template<int __sl1, int __sl2, int __sr1, int __sr2>
+    inline void
+    __sfmt_recursion(std::tr1::__detail::_UInt32Type* __r,
+		     const std::tr1::__detail::_UInt32Type* __a,
+		     const std::tr1::__detail::_UInt32Type* __b,
+		     const std::tr1::__detail::_UInt32Type* __c,
+		     const std::tr1::__detail::_UInt32Type* __d,
+		     const std::tr1::__detail::_UInt32Type* __mask)
+    {
+      __extension__ typedef unsigned long long _UInt64Type;
+
+      const _UInt64Type __ah = (_UInt64Type(__a[3]) << 32) | __a[2];
+      const _UInt64Type __al = (_UInt64Type(__a[1]) << 32) | __a[0];
+      const _UInt64Type __xh = (__ah << (__sl2 * 8)) | (__al >> (64 - __sl2 * 8));
+      const _UInt64Type __xl = __al << (__sl2 * 8);
+
+      const _UInt64Type __ch = (_UInt64Type(__c[3]) << 32) | __c[2];
+      const _UInt64Type __cl = (_UInt64Type(__c[1]) << 32) | __c[0];
+      const _UInt64Type __zh = __ch >> (__sr2 * 8);
+      const _UInt64Type __zl = (__cl >> (__sr2 * 8)) | (__ch << (64 - __sr2 * 8));
+
+      const std::tr1::__detail::_UInt32Type __x[4] =
+	{ __xl, __xl >> 32, __xh, __xh >> 32 };
+      const std::tr1::__detail::_UInt32Type __z[4] =
+	{ __zl, __zl >> 32, __zh, __zh >> 32 };
+      for (int __i = 0; __i < 4; ++__i)
+	__r[__i] = (__a[__i] ^ __x[__i] ^ ((__b[__i] >> __sr1) & __mask[__i])
+		    ^ __z[__i] ^ (__d[__i] << __sl1));
+    }
+#endif
+
+#define _GLIBCXX_SFMT_T_DEC \
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2, \
+	   int __sr1, int __sr2, \
+	   std::tr1::__detail::_UInt32Type __msk1, \
+	   std::tr1::__detail::_UInt32Type __msk2, \
+	   std::tr1::__detail::_UInt32Type __msk3, \
+	   std::tr1::__detail::_UInt32Type __msk4, \
+	   std::tr1::__detail::_UInt32Type __parity1, \
+	   std::tr1::__detail::_UInt32Type __parity2, \
+	   std::tr1::__detail::_UInt32Type __parity3, \
+	   std::tr1::__detail::_UInt32Type __parity4>
+
+#define _GLIBCXX_SFMT_C_DEC \
+  simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2, \
+			     __sr1, __sr2, __msk1, __msk2, __msk3, __msk4, \
+			     __parity1, __parity2, __parity3, __parity4>
+
+  _GLIBCXX_SFMT_T_DEC
+    void
+    _GLIBCXX_SFMT_C_DEC::
+    seed(unsigned long __value)
+    {
+      _M_x[0] = __value & 0xfffffffful;
+      for (int __i = 1; __i < _S_n32; ++__i)
+	{
+	  _UInt32Type __x = _M_x[__i - 1];
+	  __x ^= __x >> 30;
+	  __x *= 1812433253ul;
+	  __x += __i;
+	  _M_x[__i] = __x & 0xfffffffful;
+	}
+      _M_period_certification();
+      _M_p = _S_n32;
+    }
+
+  _GLIBCXX_SFMT_T_DEC
+    template<class _Gen>
+      void
+      _GLIBCXX_SFMT_C_DEC::
+      seed(_Gen& __gen, std::tr1::false_type)
+      {
+	for (int __i = 0; __i < _S_n32; ++__i)
+	  _M_x[__i] = __gen() & 0xfffffffful;
+	_M_period_certification();
+	_M_p = _S_n32;
+      }
+
+  // Flips one bit of the state if needed to keep it off the short
+  // cycles, as the parity vector tells.
+  _GLIBCXX_SFMT_T_DEC
+    void
+    _GLIBCXX_SFMT_C_DEC::
+    _M_period_certification()
+    {
+      const _UInt32Type __parity[4] =
+	{ __parity1, __parity2, __parity3, __parity4 };
+
+      _UInt32Type __inner = 0;
+      for (int __i = 0; __i < 4; ++__i)
+	__inner ^= _M_x[__i] & __parity[__i];
+      for (int __i = 16; __i > 0; __i >>= 1)
+	__inner ^= __inner >> __i;
+      if (__inner & 1)
+	return;
+
+      for (int __i = 0; __i < 4; ++__i)
+	for (_UInt32Type __work = 1; __work != 0; __work <<= 1)
+	  if (__work & __parity[__i])
+	    {
+	      _M_x[__i] ^= __work;
+	      return;
+	    }
+    }
+
+  _GLIBCXX_SFMT_T_DEC
+    void
+    _GLIBCXX_SFMT_C_DEC::
+    _M_gen_rand()
+    {
+#ifdef __SSE2__
+      __sfmt_v4si* __x = reinterpret_cast<__sfmt_v4si*>(_M_x);
+      const __sfmt_v4si __mask = { __msk1, __msk2, __msk3, __msk4 };
+      __sfmt_v4si __r1 = __x[state_size - 2];
+      __sfmt_v4si __r2 = __x[state_size - 1];
+
+      int __i = 0;
+      for (; __i < state_size - __pos1; ++__i)
+	{
+	  __x[__i] = __sfmt_recursion<__sl1, __sl2, __sr1, __sr2>
+	    (__x[__i], __x[__i + __pos1], __r1, __r2, __mask);
+	  __r1 = __r2;
+	  __r2 = __x[__i];
+	}
+      for (; __i < state_size; ++__i)
+	{
+	  __x[__i] = __sfmt_recursion<__sl1, __sl2, __sr1, __sr2>
+	    (__x[__i], __x[__i + __pos1 - state_size], __r1, __r2, __mask);
+	  __r1 = __r2;
+	  __r2 = __x[__i];
+	}
+#else
+      const _UInt32Type __mask[4] = { __msk1, __msk2, __msk3, __msk4 };
+      const _UInt32Type* __r1 = _M_x + 4 * (state_size - 2);
+      const _UInt32Type* __r2 = _M_x + 4 * (state_size - 1);
+
+      int __i = 0;
+      for (; __i < state_size - __pos1; ++__i)
+	{
+	  _UInt32Type* __x = _M_x + 4 * __i;
+	  __sfmt_recursion<__sl1, __sl2, __sr1, __sr2>
+	    (__x, __x, __x + 4 * __pos1, __r1, __r2, __mask);
+	  __r1 = __r2;
+	  __r2 = __x;
+	}
+      for (; __i < state_size; ++__i)
+	{
+	  _UInt32Type* __x = _M_x + 4 * __i;
+	  __sfmt_recursion<__sl1, __sl2, __sr1, __sr2>
+	    (__x, __x, __x + 4 * (__pos1 - state_size), __r1, __r2, __mask);
+	  __r1 = __r2;
+	  __r2 = __x;
+	}
+#endif
+      _M_p = 0;
+    }
+
+  _GLIBCXX_SFMT_T_DEC
+    template<typename _ForwardIterator>
+      void
+      _GLIBCXX_SFMT_C_DEC::
+      __generate(_ForwardIterator __first, _ForwardIterator __last)
+      {
+	while (__first != __last)
+	  {
+	    if (_M_p >= _S_n32)
+	      _M_gen_rand();
+	    for (; _M_p < _S_n32 && __first != __last; ++__first)
+	      *__first = _M_x[_M_p++];
+	  }
+      }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2,
+	   std::tr1::__detail::_UInt32Type __msk1,
+	   std::tr1::__detail::_UInt32Type __msk2,
+	   std::tr1::__detail::_UInt32Type __msk3,
+	   std::tr1::__detail::_UInt32Type __msk4,
+	   std::tr1::__detail::_UInt32Type __parity1,
+	   std::tr1::__detail::_UInt32Type __parity2,
+	   std::tr1::__detail::_UInt32Type __parity3,
+	   std::tr1::__detail::_UInt32Type __parity4,
+	   typename _CharT, typename _Traits>
+    std::basic_ostream<_CharT, _Traits>&
+    operator<<(std::basic_ostream<_CharT, _Traits>& __os,
+	       const _GLIBCXX_SFMT_C_DEC& __x)
+    {
+      typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
+      typedef typename __ostream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __os.flags();
+      const _CharT __fill = __os.fill();
+      const _CharT __space = __os.widen(' ');
+      __os.flags(__ios_base::dec | __ios_base::fixed | __ios_base::left);
+      __os.fill(__space);
+
+      for (int __i = 0; __i < __x._S_n32; ++__i)
+	__os << __x._M_x[__i] << __space;
+      __os << __x._M_p;
+
+      __os.flags(__flags);
+      __os.fill(__fill);
+      return __os;
+    }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2,
+	   std::tr1::__detail::_UInt32Type __msk1,
+	   std::tr1::__detail::_UInt32Type __msk2,
+	   std::tr1::__detail::_UInt32Type __msk3,
+	   std::tr1::__detail::_UInt32Type __msk4,
+	   std::tr1::__detail::_UInt32Type __parity1,
+	   std::tr1::__detail::_UInt32Type __parity2,
+	   std::tr1::__detail::_UInt32Type __parity3,
+	   std::tr1::__detail::_UInt32Type __parity4,
+	   typename _CharT, typename _Traits>
+    std::basic_istream<_CharT, _Traits>&
+    operator>>(std::basic_istream<_CharT, _Traits>& __is,
+	       _GLIBCXX_SFMT_C_DEC& __x)
+    {
+      typedef std::basic_istream<_CharT, _Traits>  __istream_type;
+      typedef typename __istream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __is.flags();
+      __is.flags(__ios_base::dec | __ios_base::skipws);
+
+      for (int __i = 0; __i < __x._S_n32; ++__i)
+	__is >> __x._M_x[__i];
+      __is >> __x._M_p;
+
+      __is.flags(__flags);
+      return __is;
+    }
+
+#undef _GLIBCXX_SFMT_C_DEC
+#undef _GLIBCXX_SFMT_T_DEC
+
+
+  template<int __r>
+    void
+    philox4x32_engine<__r>::
+    _M_block(result_type* __y)
+    {
+      typedef std::tr1::__detail::_UInt32Type _UInt32Type;
+
+      _UInt32Type __x0 = _M_c[0], __x1 = _M_c[1];
+      _UInt32Type __x2 = _M_c[2], __x3 = _M_c[3];
+      _UInt32Type __k0 = _M_k[0], __k1 = _M_k[1];
+      for (int __i = 0; __i < __r; ++__i)
+	{
+	  const _UInt64Type __p0 = _UInt64Type(0xd2511f53u) * __x0;
+	  const _UInt64Type __p1 = _UInt64Type(0xcd9e8d57u) * __x2;
+	  __x0 = _UInt32Type(__p1 >> 32) ^ __x1 ^ __k0;
+	  __x2 = _UInt32Type(__p0 >> 32) ^ __x3 ^ __k1;
+	  __x1 = _UInt32Type(__p1);
+	  __x3 = _UInt32Type(__p0);
+	  __k0 += 0x9e3779b9u;
+	  __k1 += 0xbb67ae85u;
+	}
+      __y[0] = __x0;
+      __y[1] = __x1;
+      __y[2] = __x2;
+      __y[3] = __x3;
+      _M_increment(1);
+    }
+
+  template<int __r>
+    void
+    philox4x32_engine<__r>::
+    _M_increment(_UInt64Type __n)
+    {
+      for (int __i = 0; __i < 4 && __n != 0; ++__i)
+	{
+	  const _UInt64Type __sum = _M_c[__i] + (__n & 0xffffffffu);
+	  _M_c[__i] = __sum & 0xffffffffu;
+	  __n = (__n >> 32) + (__sum >> 32);
+	}
+    }
+
+  template<int __r>
+    void
+    philox4x32_engine<__r>::
+    discard(_UInt64Type __z)
+    {
+      const _UInt64Type __left = 4 - _M_p;
+      if (__z <= __left)
+	{
+	  _M_p += __z;
+	  return;
+	}
+      __z -= __left;
+      _M_increment(__z / 4);
+      _M_p = 4;
+      if (__z % 4 != 0)
+	{
+	  _M_block(_M_y);
+	  _M_p = __z % 4;
+	}
+    }
+
+  template<int __r>
+    template<typename _ForwardIterator>
+      void
+      philox4x32_engine<__r>::
+      __generate(_ForwardIterator __first, _ForwardIterator __last)
+      {
+	while (__first != __last)
+	  {
+	    if (_M_p >= 4)
+	      {
+		_M_block(_M_y);
+		_M_p = 0;
+	      }
+	    for (; _M_p < 4 && __first != __last; ++__first)
+	      *__first = _M_y[_M_p++];
+	  }
+      }
+
+  template<int __r, typename _CharT, typename _Traits>
+    std::basic_ostream<_CharT, _Traits>&
+    operator<<(std::basic_ostream<_CharT, _Traits>& __os,
+	       const philox4x32_engine<__r>& __x)
+    {
+      typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
+      typedef typename __ostream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __os.flags();
+      const _CharT __fill = __os.fill();
+      const _CharT __space = __os.widen(' ');
+      __os.flags(__ios_base::dec | __ios_base::fixed | __ios_base::left);
+      __os.fill(__space);
+
+      __os << __x._M_k[0] << __space << __x._M_k[1];
+      for (int __i = 0; __i < 4; ++__i)
+	__os << __space << __x._M_c[__i];
+      for (int __i = 0; __i < 4; ++__i)
+	__os << __space << __x._M_y[__i];
+      __os << __space << __x._M_p;
+
+      __os.flags(__flags);
+      __os.fill(__fill);
+      return __os;
+    }
+
+  template<int __r, typename _CharT, typename _Traits>
+    std::basic_istream<_CharT, _Traits>&
+    operator>>(std::basic_istream<_CharT, _Traits>& __is,
+	       philox4x32_engine<__r>& __x)
+    {
+      typedef std::basic_istream<_CharT, _Traits>  __istream_type;
+      typedef typename __istream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __is.flags();
+      __is.flags(__ios_base::dec | __ios_base::skipws);
+
+      __is >> __x._M_k[0] >> __x._M_k[1];
+      for (int __i = 0; __i < 4; ++__i)
+	__is >> __x._M_c[__i];
+      for (int __i = 0; __i < 4; ++__i)
+	__is >> __x._M_y[__i];
+      __is >> __x._M_p;
+
+      __is.flags(__flags);
+      return __is;
+    }
+
+_GLIBCXX_END_NAMESPACE
@@ -527,6 +527,130 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	return __result;
     }
 
+  template <class _CharT, class _Alloc>
+    typename rope<_CharT, _Alloc>::_RopeRep*
+    rope<_CharT, _Alloc>::
+    _S_bulk_tree(const _CharT* __s, size_t __size,
+		 allocator_type __a, _CharT** __bufs)
+    {
+      const size_t __leaf_len = size_t(_S_bulk_leaf_len);
+      if (__size <= __leaf_len)
+	{
+	  if (0 == __bufs)
+	    return _S_RopeLeaf_from_unowned_char_ptr(__s, __size, __a);
+
+	  _CharT* __buf = __a.allocate(_S_rounded_up_size(__size));
+	  _S_cond_store_eos(__buf[__size]);
+	  try
+	    {
+	      _RopeLeaf* __leaf = _S_new_RopeLeaf(__buf, __size, __a);
+	      *__bufs = __buf;
+	      return __leaf;
+	    }
+	  catch(...)
+	    {
+	      __a.deallocate(__buf, _S_rounded_up_size(__size));
+	      __throw_exception_again;
+	    }
+	}
+
+      // Split on a leaf boundary with half of the leaves on each side;
+      // the last, possibly short, leaf always ends up on the right.
+      const size_t __nleaves = (__size - 1) / __leaf_len + 1;
+      const size_t __left_len = __nleaves / 2 * __leaf_len;
+      _RopeRep* __left = _S_bulk_tree(__s, __left_len, __a, __bufs);
+      _RopeRep* __right = 0;
+      try
+	{
+	  __right = _S_bulk_tree(__s + __left_len, __size - __left_len, __a,
+				 __bufs ? __bufs + __nleaves / 2 : 0);
+	  _RopeRep* __result = _S_new_RopeConcatenation(__left, __right, __a);
+	  __result->_M_is_balanced = _S_is_balanced(__result);
+	  return __result;
+	}
+      catch(...)
+	{
+	  _S_unref(__left);
+	  _S_unref(__right);
+	  __throw_exception_again;
+	}
+    }
+
+#ifdef _GLIBCXX_PARALLEL
+  // Fills the leaves set up by rope::_S_bulk_tree, one leaf per call.
+  template <class _CharT>
+    struct _Rope_bulk_fill
+    {
+      const _CharT* _M_src;
+      size_t _M_size;
+      _CharT** _M_bufs;
+      size_t _M_leaf_len;
+
+      _Rope_bulk_fill(const _CharT* __s, size_t __size, _CharT** __bufs,
+		      size_t __leaf_len)
+      : _M_src(__s), _M_size(__size), _M_bufs(__bufs),
+	_M_leaf_len(__leaf_len) { }
+
+      void
+      operator()(size_t __i) const
+      {
+	const size_t __start = __i * _M_leaf_len;
+	const size_t __len = std::min(_M_leaf_len, _M_size - __start);
+	std::copy(_M_src + __start, _M_src + __start + __len, _M_bufs[__i]);
+      }
+    };
+#endif
+
+  template <class _CharT, class _Alloc>
+    typename rope<_CharT, _Alloc>::_RopeRep*
+    rope<_CharT, _Alloc>::
+    _S_RopeTree_from_unowned_char_ptr(const _CharT* __s, size_t __size,
+				      allocator_type __a)
+    {
+      if (__size <= size_t(_S_bulk_leaf_len))
+	return _S_RopeLeaf_from_unowned_char_ptr(__s, __size, __a);
+
+#ifdef _GLIBCXX_PARALLEL
+      // Copying is all the work there is, and it is only worth handing
+      // to other threads in pieces of a few hundred kilobytes.  Types
+      // with constructors are copied in place, by the sequential path.
+      using __gnu_parallel::_Settings;
+      const _Settings& __settings = _Settings::get();
+      const size_t __nleaves = (__size - 1) / size_t(_S_bulk_leaf_len) + 1;
+      if (std::__is_scalar<_CharT>::__value
+	  && __settings.algorithm_strategy != __gnu_parallel::force_sequential
+	  && (__settings.algorithm_strategy == __gnu_parallel::force_parallel
+	      || __size * sizeof(_CharT) >= (size_t(1) << 20)))
+	{
+	  typedef typename _Alloc::template rebind<_CharT*>::other
+	    _Ptr_alloc;
+	  _Ptr_alloc __ptr_alloc(__a);
+	  _CharT** __bufs = __ptr_alloc.allocate(__nleaves);
+	  _RopeRep* __result = 0;
+	  try
+	    {
+	      __result = _S_bulk_tree(__s, __size, __a, __bufs);
+	      __gnu_parallel::
+		parallel_for(size_t(0), __nleaves,
+			     std::max(size_t(64),
+				      __gnu_parallel::
+				      __default_grain(__nleaves)),
+			     _Rope_bulk_fill<_CharT>(__s, __size, __bufs,
+						     size_t(_S_bulk_leaf_len)));
+	    }
+	  catch(...)
+	    {
+	      _S_unref(__result);
+	      __ptr_alloc.deallocate(__bufs, __nleaves);
+	      __throw_exception_again;
+	    }
+	  __ptr_alloc.deallocate(__bufs, __nleaves);
+	  return __result;
+	}
+#endif
+      return _S_bulk_tree(__s, __size, __a, 0);
+    }
+
   template <class _CharT, class _Alloc>
     typename rope<_CharT, _Alloc>::_RopeRep*
     rope<_CharT, _Alloc>::
@@ -779,10 +903,11 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	    __result->_M_c_string = 0;  // Not eos terminated.
 #else
 	    // We should sometimes create substring node instead.
-	    __result = __STL_ROPE_FROM_UNOWNED_CHAR_PTR(__l->_M_data + __start,
-							__result_len,
-							__base->
-							get_allocator());
+	    __result = _S_RopeLeaf_from_unowned_char_ptr(__l->_M_data
+							 + __start,
+							 __result_len,
+							 __base->
+							 get_allocator());
 #endif
 	    return __result;
 	  }
@@ -277,13 +277,13 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
       if (__n == 0)
 	return __pos <= __size ? __pos : npos;
 
-      if (__n <= __size)
+      if (__pos < __size)
 	{
-	  for (; __pos <= __size - __n; ++__pos)
-	    if (traits_type::eq(__data[__pos], __s[0])
-		&& traits_type::compare(__data + __pos + 1,
-					__s + 1, __n - 1) == 0)
-	      return __pos;
+	  const _CharT* __p = std::__search_string<traits_type>(__data + __pos,
+								__size - __pos,
+								__s, __n);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -309,7 +309,7 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 
   template<typename _CharT, typename _Traits, typename _Alloc,
 	   template <typename, typename, typename> class _Base>
-    typename __versa_string<_CharT, _Traits, _Alloc, _Base>::size_type
+    inline typename __versa_string<_CharT, _Traits, _Alloc, _Base>::size_type
     __versa_string<_CharT, _Traits, _Alloc, _Base>::
     rfind(const _CharT* __s, size_type __pos, size_type __n) const
     {
@@ -318,13 +318,14 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
       if (__n <= __size)
 	{
 	  __pos = std::min(size_type(__size - __n), __pos);
+	  if (__n == 0)
+	    return __pos;
 	  const _CharT* __data = this->_M_data();
-	  do
-	    {
-	      if (traits_type::compare(__data + __pos, __s, __n) == 0)
-		return __pos;
-	    }
-	  while (__pos-- > 0);
+	  const _CharT* __p = std::__rsearch_string<traits_type>(__data,
+								 __pos + __n,
+								 __s, __n);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -354,12 +355,14 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     find_first_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
       __glibcxx_requires_string_len(__s, __n);
-      for (; __n && __pos < this->size(); ++__pos)
+      const size_type __size = this->size();
+      if (__n && __pos < __size)
 	{
-	  const _CharT* __p = traits_type::find(__s, __n,
-						this->_M_data()[__pos]);
+	  const _CharT* __data = this->_M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_find(__data + __pos, __data + __size, __s, __n, true);
 	  if (__p)
-	    return __pos;
+	    return __p - __data;
 	}
       return npos;
     }
@@ -376,12 +379,11 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	{
 	  if (--__size > __pos)
 	    __size = __pos;
-	  do
-	    {
-	      if (traits_type::find(__s, __n, this->_M_data()[__size]))
-		return __size;
-	    }
-	  while (__size-- != 0);
+	  const _CharT* __data = this->_M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_rfind(__data, __data + __size + 1, __s, __n, true);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -393,9 +395,15 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
     find_first_not_of(const _CharT* __s, size_type __pos, size_type __n) const
     {
       __glibcxx_requires_string_len(__s, __n);
-      for (; __pos < this->size(); ++__pos)
-	if (!traits_type::find(__s, __n, this->_M_data()[__pos]))
-	  return __pos;
+      const size_type __size = this->size();
+      if (__pos < __size)
+	{
+	  const _CharT* __data = this->_M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_find(__data + __pos, __data + __size, __s, __n, false);
+	  if (__p)
+	    return __p - __data;
+	}
       return npos;
     }
 
@@ -423,12 +431,11 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 	{
 	  if (--__size > __pos)
 	    __size = __pos;
-	  do
-	    {
-	      if (!traits_type::find(__s, __n, this->_M_data()[__size]))
-		return __size;
-	    }
-	  while (__size--);
+	  const _CharT* __data = this->_M_data();
+	  const _CharT* __p = std::__char_set_search<traits_type>::
+	    _S_rfind(__data, __data + __size + 1, __s, __n, false);
+	  if (__p)
+	    return __p - __data;
 	}
       return npos;
     }
@@ -560,7 +567,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       typedef typename __string_type::size_type		__size_type;
 
       __size_type __extracted = 0;
-      ios_base::iostate __err = ios_base::iostate(ios_base::goodbit);
+      typename __istream_type::iostate __err =
+	typename __istream_type::iostate(__istream_type::goodbit);
       typename __istream_type::sentry __cerb(__in, false);
       if (__cerb)
 	{
@@ -580,7 +588,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
 	      while (__extracted < __n
 		     && !_Traits::eq_int_type(__c, __eof)
-		     && !__ct.is(ctype_base::space, _Traits::to_char_type(__c)))
+		     && !__ct.is(__ctype_type::space, _Traits::to_char_type(__c)))
 		{
 		  if (__len == sizeof(__buf) / sizeof(_CharT))
 		    {
@@ -594,7 +602,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	      __str.append(__buf, __len);
 
 	      if (_Traits::eq_int_type(__c, __eof))
-		__err |= ios_base::eofbit;
+		__err |= __istream_type::eofbit;
 	      __in.width(0);
 	    }
 	  catch(...)
@@ -602,12 +610,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	      // _GLIBCXX_RESOLVE_LIB_DEFECTS
 	      // 91. Description of operator>> and getline() for string<>
 	      // might cause endless loop
-	      __in._M_setstate(ios_base::badbit);
+	      __in._M_setstate(__istream_type::badbit);
 	    }
 	}
       // 211.  operator>>(istream&, string&) doesn't set failbit
       if (!__extracted)
-	__err |= ios_base::failbit;
+	__err |= __istream_type::failbit;
       if (__err)
 	__in.setstate(__err);
       return __in;
@@ -630,7 +638,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
       __size_type __extracted = 0;
       const __size_type __n = __str.max_size();
-      ios_base::iostate __err = ios_base::iostate(ios_base::goodbit);
+      typename __istream_type::iostate __err =
+	typename __istream_type::iostate(__istream_type::goodbit);
       typename __istream_type::sentry __cerb(__in, true);
       if (__cerb)
 	{
@@ -661,25 +670,25 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	      __str.append(__buf, __len);
 
 	      if (_Traits::eq_int_type(__c, __eof))
-		__err |= ios_base::eofbit;
+		__err |= __istream_type::eofbit;
 	      else if (_Traits::eq_int_type(__c, __idelim))
 		{
 		  ++__extracted;		  
 		  __sb->sbumpc();
 		}
 	      else
-		__err |= ios_base::failbit;
+		__err |= __istream_type::failbit;
 	    }
 	  catch(...)
 	    {
 	      // _GLIBCXX_RESOLVE_LIB_DEFECTS
 	      // 91. Description of operator>> and getline() for string<>
 	      // might cause endless loop
-	      __in._M_setstate(ios_base::badbit);
+	      __in._M_setstate(__istream_type::badbit);
 	    }
 	}
       if (!__extracted)
-	__err |= ios_base::failbit;
+	__err |= __istream_type::failbit;
       if (__err)
 	__in.setstate(__err);
       return __in;
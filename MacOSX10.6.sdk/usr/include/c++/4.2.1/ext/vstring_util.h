@@ -42,9 +42,15 @@
 #include <debug/debug.h>
 #include <bits/stl_function.h>  // For less
 #include <bits/functexcept.h>
-#include <locale>
+#if _GLIBCXX_NAMESPACE_ASSOCIATION_SSO
+// std::string is built on __versa_string and <locale> needs std::string.
+# include <bits/localefwd.h>
+#else
+# include <locale>
+#endif
 #include <algorithm> // For std::distance, srd::search.
 #include <bits/ostream_insert.h>
+#include <bits/string_search.h>
 
 _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 
@@ -49,4 +49,29 @@ typedef int _Atomic_word;
 // words, a Store-Store release barrier.
 // #define _GLIBCXX_WRITE_MEM_BARRIER __asm __volatile ("":::"memory")
 
+// Barriers for the explicit memory orders of <ext/atomic>.  x86 does
+// not reorder loads with loads or stores with stores, so acquire and
+// release only have to constrain the compiler; only a store followed
+// by a load needs mfence.  Locked read-modify-write instructions are
+// full barriers by themselves.
+#define _GLIBCXX_ACQUIRE_BARRIER __asm __volatile ("":::"memory")
+#define _GLIBCXX_RELEASE_BARRIER __asm __volatile ("":::"memory")
+#define _GLIBCXX_FULL_BARRIER __asm __volatile ("mfence":::"memory")
+#define _GLIBCXX_SEQ_CST_LOAD_BARRIER __asm __volatile ("":::"memory")
+#define _GLIBCXX_ATOMIC_RMW_FENCED 1
+
+// Body of a spin-wait loop: pause keeps the spinning hyperthread from
+// starving its sibling and avoids a memory-order mis-speculation when
+// the awaited store arrives.
+#define _GLIBCXX_CPU_RELAX __asm __volatile ("pause":::"memory")
+
+// Widest plain load and store that is single-copy atomic, and widest
+// lock-free read-modify-write (cmpxchg8b on i386).
+#ifdef __x86_64__
+# define _GLIBCXX_ATOMIC_ACCESS_MAX 8
+#else
+# define _GLIBCXX_ATOMIC_ACCESS_MAX 4
+#endif
+#define _GLIBCXX_ATOMIC_RMW_MAX 8
+
 #endif 
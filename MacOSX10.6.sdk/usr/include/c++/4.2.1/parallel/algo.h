@@ -0,0 +1,936 @@
+// Parallel mode algorithms -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/algo.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  Multithreaded versions of sort, stable_sort, nth_element and
+ *  transform.  They split the work between the threads of
+ *  __gnu_parallel::_Thread_pool and run the sequential kernels of
+ *  bits/stl_algo.h (__introsort_loop, __introselect, __merge_adaptive
+ *  through inplace_merge) on each piece.  Ranges shorter than the
+ *  cutoff in _Settings use the sequential code path unchanged.
+ *
+ *  These functions may be called directly, or, when _GLIBCXX_PARALLEL
+ *  is defined, through the corresponding std:: algorithms.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_ALGO_H
+#define _GLIBCXX_PARALLEL_ALGO_H 1
+
+#include <bits/stl_algobase.h>
+#include <bits/stl_algo.h>
+#include <bits/stl_tempbuf.h>
+#include <parallel/algorithmfwd.h>
+#include <parallel/settings.h>
+#include <parallel/thread_pool.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  /// Whether a range of @a __n elements is processed in parallel.
+  inline bool
+  __is_parallel(size_t __n, size_t __minimal_n)
+  {
+    const _Settings& __s = _Settings::get();
+    if (__s.algorithm_strategy == force_sequential)
+      return false;
+    if (_Thread_pool::_S_get()._M_get_num_threads() < 2)
+      return false;
+    return __s.algorithm_strategy == force_parallel || __n >= __minimal_n;
+  }
+
+  // Start of chunk __i when __n elements are split in __chunks parts.
+  template<typename _Iterator, typename _Distance>
+    inline _Iterator
+    __chunk_begin(_Iterator __first, _Distance __n, unsigned int __chunks,
+		  unsigned int __i)
+    {
+      const _Distance __q = __n / __chunks;
+      const _Distance __r = __n % __chunks;
+      return __first + (__q * __i + std::min(_Distance(__i), __r));
+    }
+
+  /// operator< as a function object, for the overloads without one.
+  template<typename _Tp>
+    struct _Less
+    {
+      bool
+      operator()(const _Tp& __x, const _Tp& __y) const
+      { return __x < __y; }
+    };
+
+  template<typename _Tp, typename _Compare>
+    struct _Less_than_pivot
+    {
+      const _Tp* _M_pivot;
+      _Compare	 _M_comp;
+
+      _Less_than_pivot(const _Tp& __pivot, _Compare __comp)
+      : _M_pivot(&__pivot), _M_comp(__comp) { }
+
+      bool
+      operator()(const _Tp& __x)
+      { return _M_comp(__x, *_M_pivot); }
+    };
+
+  template<typename _Tp, typename _Compare>
+    struct _Not_greater_than_pivot
+    {
+      const _Tp* _M_pivot;
+      _Compare	 _M_comp;
+
+      _Not_greater_than_pivot(const _Tp& __pivot, _Compare __comp)
+      : _M_pivot(&__pivot), _M_comp(__comp) { }
+
+      bool
+      operator()(const _Tp& __x)
+      { return !_M_comp(*_M_pivot, __x); }
+    };
+
+  template<typename _RandomAccessIterator>
+    struct _Range
+    {
+      _RandomAccessIterator _M_first;
+      _RandomAccessIterator _M_last;
+    };
+
+  template<typename _RandomAccessIterator, typename _Predicate>
+    struct _Partition_job
+    {
+      _RandomAccessIterator  _M_first;
+      _RandomAccessIterator  _M_last;
+      _Predicate	     _M_pred;
+      _RandomAccessIterator* _M_split;
+
+      _Partition_job(_RandomAccessIterator __first,
+		     _RandomAccessIterator __last, _Predicate __pred,
+		     _RandomAccessIterator* __split)
+      : _M_first(__first), _M_last(__last), _M_pred(__pred),
+	_M_split(__split) { }
+
+      void
+      operator()()
+      { *_M_split = std::partition(_M_first, _M_last, _M_pred); }
+    };
+
+  // Swaps the elements at offsets [__offset, __offset + __length) of
+  // the concatenation of _M_left with those of the concatenation of
+  // _M_right.
+  template<typename _RandomAccessIterator>
+    struct _Swap_ranges_job
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Range<_RandomAccessIterator>* _M_left;
+      const _Range<_RandomAccessIterator>* _M_right;
+      _Distance _M_offset;
+      _Distance _M_length;
+
+      _Swap_ranges_job(const _Range<_RandomAccessIterator>* __left,
+		       const _Range<_RandomAccessIterator>* __right,
+		       _Distance __offset, _Distance __length)
+      : _M_left(__left), _M_right(__right), _M_offset(__offset),
+	_M_length(__length) { }
+
+      static _RandomAccessIterator
+      _S_locate(const _Range<_RandomAccessIterator>*& __r, _Distance __off)
+      {
+	while (__off >= __r->_M_last - __r->_M_first)
+	  {
+	    __off -= __r->_M_last - __r->_M_first;
+	    ++__r;
+	  }
+	return __r->_M_first + __off;
+      }
+
+      void
+      operator()()
+      {
+	const _Range<_RandomAccessIterator>* __lr = _M_left;
+	const _Range<_RandomAccessIterator>* __rr = _M_right;
+	_RandomAccessIterator __l = _S_locate(__lr, _M_offset);
+	_RandomAccessIterator __r = _S_locate(__rr, _M_offset);
+	for (_Distance __n = _M_length; __n > 0;)
+	  {
+	    const _Distance __step = std::min(__n,
+					      std::min(__lr->_M_last - __l,
+						       __rr->_M_last - __r));
+	    std::swap_ranges(__l, __l + __step, __r);
+	    __n -= __step;
+	    __l += __step;
+	    __r += __step;
+	    if (__n > 0 && __l == __lr->_M_last)
+	      __l = (++__lr)->_M_first;
+	    if (__n > 0 && __r == __rr->_M_last)
+	      __r = (++__rr)->_M_first;
+	  }
+      }
+    };
+
+  /**
+   *  @if maint
+   *  Partitions [__first, __last) with __pred using __chunks threads.
+   *  Each chunk is partitioned on its own; the elements left on the
+   *  wrong side of the global split point are then exchanged in
+   *  parallel.  Not stable.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator, typename _Predicate>
+    _RandomAccessIterator
+    __parallel_partition(_RandomAccessIterator __first,
+			 _RandomAccessIterator __last, _Predicate __pred,
+			 unsigned int __chunks)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Distance __n = __last - __first;
+      _RandomAccessIterator __splits[_S_max_chunks];
+      {
+	_Task_group __group;
+	for (unsigned int __i = 0; __i < __chunks; ++__i)
+	  __group.run(_Partition_job<_RandomAccessIterator, _Predicate>
+		      (__chunk_begin(__first, __n, __chunks, __i),
+		       __chunk_begin(__first, __n, __chunks, __i + 1),
+		       __pred, &__splits[__i]));
+	__group.wait();
+      }
+
+      _Distance __true_count = 0;
+      for (unsigned int __i = 0; __i < __chunks; ++__i)
+	__true_count += __splits[__i] - __chunk_begin(__first, __n,
+						      __chunks, __i);
+      const _RandomAccessIterator __middle = __first + __true_count;
+
+      // Misplaced elements: false ones before __middle, true ones after.
+      _Range<_RandomAccessIterator> __left[_S_max_chunks];
+      _Range<_RandomAccessIterator> __right[_S_max_chunks];
+      unsigned int __nleft = 0, __nright = 0;
+      _Distance __misplaced = 0;
+      for (unsigned int __i = 0; __i < __chunks; ++__i)
+	{
+	  const _RandomAccessIterator __b
+	    = __chunk_begin(__first, __n, __chunks, __i);
+	  const _RandomAccessIterator __e
+	    = __chunk_begin(__first, __n, __chunks, __i + 1);
+	  const _RandomAccessIterator __s = __splits[__i];
+
+	  const _RandomAccessIterator __fl = std::min(__e, __middle);
+	  if (__s < __fl)
+	    {
+	      __left[__nleft]._M_first = __s;
+	      __left[__nleft++]._M_last = __fl;
+	      __misplaced += __fl - __s;
+	    }
+	  const _RandomAccessIterator __tf = std::max(__b, __middle);
+	  if (__tf < __s)
+	    {
+	      __right[__nright]._M_first = __tf;
+	      __right[__nright++]._M_last = __s;
+	    }
+	}
+
+      if (__misplaced != 0)
+	{
+	  const unsigned int __pieces = __misplaced < _Distance(__chunks)
+	                                ? 1 : __chunks;
+	  _Task_group __group;
+	  for (unsigned int __i = 0; __i < __pieces; ++__i)
+	    {
+	      const _Distance __b = (__chunk_begin(_Distance(0), __misplaced,
+						   __pieces, __i));
+	      const _Distance __e = (__chunk_begin(_Distance(0), __misplaced,
+						   __pieces, __i + 1));
+	      __group.run(_Swap_ranges_job<_RandomAccessIterator>
+			  (__left, __right, __b, __e - __b));
+	    }
+	  __group.wait();
+	}
+      return __middle;
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    inline void
+    __sequential_sort(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, _Compare __comp)
+    {
+      if (__first != __last)
+	{
+	  std::__introsort_loop(__first, __last,
+				std::__lg(__last - __first) * 2, __comp);
+	  std::__final_insertion_sort(__first, __last, __comp);
+	}
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __parallel_sort_loop(_RandomAccessIterator, _RandomAccessIterator,
+			 _Compare, int);
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    struct _Sort_job
+    {
+      _RandomAccessIterator _M_first;
+      _RandomAccessIterator _M_last;
+      _Compare		    _M_comp;
+      int		    _M_depth_limit;
+
+      _Sort_job(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		_Compare __comp, int __depth_limit)
+      : _M_first(__first), _M_last(__last), _M_comp(__comp),
+	_M_depth_limit(__depth_limit) { }
+
+      void
+      operator()()
+      { __parallel_sort_loop(_M_first, _M_last, _M_comp, _M_depth_limit); }
+    };
+
+  /**
+   *  @if maint
+   *  Parallel counterpart of std::__introsort_loop.  Large ranges are
+   *  split three ways around a median-of-three pivot with
+   *  __parallel_partition; smaller ones with __unguarded_partition.
+   *  The upper part becomes a new task, the lower part is processed in
+   *  place, and pieces below sort_minimal_n are sorted sequentially.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __parallel_sort_loop(_RandomAccessIterator __first,
+			 _RandomAccessIterator __last, _Compare __comp,
+			 int __depth_limit)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+
+      const size_t __minimal_n = std::max(size_t(16),
+					  _Settings::get().sort_minimal_n);
+      const unsigned int __threads
+	= _Thread_pool::_S_get()._M_get_num_threads();
+
+      _Task_group __group;
+      while (size_t(__last - __first) > __minimal_n && __depth_limit > 0)
+	{
+	  --__depth_limit;
+	  const _ValueType __pivot(std::__median(*__first,
+						 *(__first
+						   + (__last - __first) / 2),
+						 *(__last - 1), __comp));
+	  _RandomAccessIterator __lo, __hi;
+	  if (size_t(__last - __first) >= __minimal_n * __threads)
+	    {
+	      __lo = __parallel_partition(__first, __last,
+					  _Less_than_pivot<_ValueType,
+					  _Compare>(__pivot, __comp),
+					  __threads);
+	      __hi = __parallel_partition(__lo, __last,
+					  _Not_greater_than_pivot<_ValueType,
+					  _Compare>(__pivot, __comp),
+					  __threads);
+	    }
+	  else
+	    __lo = __hi = std::__unguarded_partition(__first, __last,
+						     __pivot, __comp);
+
+	  __group.run(_Sort_job<_RandomAccessIterator, _Compare>
+		      (__hi, __last, __comp, __depth_limit));
+	  __last = __lo;
+	}
+      __sequential_sort(__first, __last, __comp);
+      __group.wait();
+    }
+
+  /**
+   *  @brief Sort the elements of a sequence using a predicate for
+   *         comparison, in parallel.
+   *  @param  first   An iterator.
+   *  @param  last    Another iterator.
+   *  @param  comp    A comparison functor.
+   *  @return  Nothing.
+   *
+   *  Same contract as std::sort.  @p comp is copied to every thread and
+   *  may be called concurrently.
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    sort(_RandomAccessIterator __first, _RandomAccessIterator __last,
+	 _Compare __comp)
+    {
+      if (__first == __last)
+	return;
+      if (__is_parallel(__last - __first, _Settings::get().sort_minimal_n))
+	__parallel_sort_loop(__first, __last, __comp,
+			     std::__lg(__last - __first) * 2);
+      else
+	__sequential_sort(__first, __last, __comp);
+    }
+
+  /**
+   *  @brief Sort the elements of a sequence in parallel.
+   *  @param  first   An iterator.
+   *  @param  last    Another iterator.
+   *  @return  Nothing.
+  */
+  template<typename _RandomAccessIterator>
+    void
+    sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+      __gnu_parallel::sort(__first, __last, _Less<_ValueType>());
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __sequential_stable_sort(_RandomAccessIterator __first,
+			     _RandomAccessIterator __last, _Compare __comp)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _DistanceType;
+
+      std::_Temporary_buffer<_RandomAccessIterator, _ValueType>
+	__buf(__first, __last);
+      if (__buf.begin() == 0)
+	std::__inplace_stable_sort(__first, __last, __comp);
+      else
+	std::__stable_sort_adaptive(__first, __last, __buf.begin(),
+				    _DistanceType(__buf.size()), __comp);
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    struct _Stable_sort_job
+    {
+      _RandomAccessIterator _M_first;
+      _RandomAccessIterator _M_last;
+      _Compare		    _M_comp;
+
+      _Stable_sort_job(_RandomAccessIterator __first,
+		       _RandomAccessIterator __last, _Compare __comp)
+      : _M_first(__first), _M_last(__last), _M_comp(__comp) { }
+
+      void
+      operator()()
+      { __sequential_stable_sort(_M_first, _M_last, _M_comp); }
+    };
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    struct _Inplace_merge_job
+    {
+      _RandomAccessIterator _M_first;
+      _RandomAccessIterator _M_middle;
+      _RandomAccessIterator _M_last;
+      _Compare		    _M_comp;
+
+      _Inplace_merge_job(_RandomAccessIterator __first,
+			 _RandomAccessIterator __middle,
+			 _RandomAccessIterator __last, _Compare __comp)
+      : _M_first(__first), _M_middle(__middle), _M_last(__last),
+	_M_comp(__comp) { }
+
+      void
+      operator()()
+      { std::inplace_merge(_M_first, _M_middle, _M_last, _M_comp); }
+    };
+
+  template<typename _RandomAccessIterator, typename _Pointer,
+	   typename _Compare>
+    struct _Merge_job
+    {
+      _RandomAccessIterator _M_first1;
+      _RandomAccessIterator _M_last1;
+      _RandomAccessIterator _M_first2;
+      _RandomAccessIterator _M_last2;
+      _Pointer		    _M_result;
+      _Compare		    _M_comp;
+
+      _Merge_job(_RandomAccessIterator __first1,
+		 _RandomAccessIterator __last1,
+		 _RandomAccessIterator __first2,
+		 _RandomAccessIterator __last2,
+		 _Pointer __result, _Compare __comp)
+      : _M_first1(__first1), _M_last1(__last1), _M_first2(__first2),
+	_M_last2(__last2), _M_result(__result), _M_comp(__comp) { }
+
+      void
+      operator()()
+      {
+	std::merge(_M_first1, _M_last1, _M_first2, _M_last2, _M_result,
+		   _M_comp);
+      }
+    };
+
+  template<typename _InputIterator, typename _OutputIterator>
+    struct _Copy_job
+    {
+      _InputIterator  _M_first;
+      _InputIterator  _M_last;
+      _OutputIterator _M_result;
+
+      _Copy_job(_InputIterator __first, _InputIterator __last,
+		_OutputIterator __result)
+      : _M_first(__first), _M_last(__last), _M_result(__result) { }
+
+      void
+      operator()()
+      { std::copy(_M_first, _M_last, _M_result); }
+    };
+
+  /**
+   *  @if maint
+   *  Merges the adjacent sorted runs [__first, __middle) and
+   *  [__middle, __last) into __result, split into __pieces independent
+   *  std::merge calls.  The first run is cut at equal distances and
+   *  the second at the matching lower_bound, which keeps the merge
+   *  stable.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator, typename _Pointer,
+	   typename _Compare>
+    void
+    __parallel_merge(_RandomAccessIterator __first,
+		     _RandomAccessIterator __middle,
+		     _RandomAccessIterator __last, _Pointer __result,
+		     _Compare __comp, unsigned int __pieces,
+		     _Task_group& __group)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Distance __len1 = __middle - __first;
+      _RandomAccessIterator __a = __first;
+      _RandomAccessIterator __b = __middle;
+      for (unsigned int __i = 1; __i <= __pieces; ++__i)
+	{
+	  _RandomAccessIterator __na, __nb;
+	  if (__i == __pieces)
+	    {
+	      __na = __middle;
+	      __nb = __last;
+	    }
+	  else
+	    {
+	      __na = __chunk_begin(__first, __len1, __pieces, __i);
+	      __nb = __na == __middle ? __last
+		     : std::lower_bound(__b, __last, *__na, __comp);
+	    }
+	  __group.run(_Merge_job<_RandomAccessIterator, _Pointer, _Compare>
+		      (__a, __na, __b, __nb,
+		       __result + ((__a - __first) + (__b - __middle)),
+		       __comp));
+	  __a = __na;
+	  __b = __nb;
+	}
+    }
+
+  /**
+   *  @brief Sort the elements of a sequence using a predicate for
+   *         comparison, preserving the relative order of equivalent
+   *         elements, in parallel.
+   *  @param  first   An iterator.
+   *  @param  last    Another iterator.
+   *  @param  comp    A comparison functor.
+   *  @return  Nothing.
+   *
+   *  Each thread stable-sorts one chunk; the sorted runs are then
+   *  merged pairwise in log2(threads) rounds.  With a full-size
+   *  temporary buffer every merge is itself split between the threads,
+   *  otherwise each pair is merged by std::inplace_merge.
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		_Compare __comp)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Distance __n = __last - __first;
+      if (!__is_parallel(__n, _Settings::get().stable_sort_minimal_n)
+	  || __n < 2)
+	{
+	  __sequential_stable_sort(__first, __last, __comp);
+	  return;
+	}
+
+      unsigned int __chunks = _Thread_pool::_S_get()._M_get_num_threads();
+      if (_Distance(__chunks) > __n)
+	__chunks = __n;
+
+      {
+	_Task_group __group;
+	for (unsigned int __i = 0; __i < __chunks; ++__i)
+	  __group.run(_Stable_sort_job<_RandomAccessIterator, _Compare>
+		      (__chunk_begin(__first, __n, __chunks, __i),
+		       __chunk_begin(__first, __n, __chunks, __i + 1),
+		       __comp));
+	__group.wait();
+      }
+
+      std::_Temporary_buffer<_RandomAccessIterator, _ValueType>
+	__buf(__first, __last);
+      const bool __full_buffer = (__buf.begin() != 0
+				  && _Distance(__buf.size()) == __n);
+
+      for (unsigned int __w = 1; __w < __chunks; __w *= 2)
+	{
+	  const unsigned int __pairs = (__chunks + 2 * __w - 1) / (2 * __w);
+	  const unsigned int __pieces = std::max(1u, __chunks / __pairs);
+	  _RandomAccessIterator __merged_end = __first;
+
+	  _Task_group __group;
+	  for (unsigned int __i = 0; __i + __w < __chunks; __i += 2 * __w)
+	    {
+	      const _RandomAccessIterator __f
+		= __chunk_begin(__first, __n, __chunks, __i);
+	      const _RandomAccessIterator __m
+		= __chunk_begin(__first, __n, __chunks, __i + __w);
+	      __merged_end = __chunk_begin(__first, __n, __chunks,
+					   std::min(__i + 2 * __w, __chunks));
+	      if (__full_buffer)
+		__parallel_merge(__f, __m, __merged_end,
+				 __buf.begin() + (__f - __first), __comp,
+				 __pieces, __group);
+	      else
+		__group.run(_Inplace_merge_job<_RandomAccessIterator,
+			    _Compare>(__f, __m, __merged_end, __comp));
+	    }
+	  __group.wait();
+
+	  if (__full_buffer)
+	    {
+	      const _Distance __len = __merged_end - __first;
+	      for (unsigned int __i = 0; __i < __chunks; ++__i)
+		{
+		  const _Distance __b = __chunk_begin(_Distance(0), __len,
+						      __chunks, __i);
+		  const _Distance __e = __chunk_begin(_Distance(0), __len,
+						      __chunks, __i + 1);
+		  __group.run(_Copy_job<_ValueType*, _RandomAccessIterator>
+			      (__buf.begin() + __b, __buf.begin() + __e,
+			       __first + __b));
+		}
+	      __group.wait();
+	    }
+	}
+    }
+
+  /**
+   *  @brief Sort the elements of a sequence, preserving the relative
+   *         order of equivalent elements, in parallel.
+   *  @param  first   An iterator.
+   *  @param  last    Another iterator.
+   *  @return  Nothing.
+  */
+  template<typename _RandomAccessIterator>
+    void
+    stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+      __gnu_parallel::stable_sort(__first, __last, _Less<_ValueType>());
+    }
+
+  /**
+   *  @brief Sort a sequence just enough to find a particular position
+   *         using a predicate for comparison, in parallel.
+   *  @param  first   An iterator.
+   *  @param  nth     Another iterator.
+   *  @param  last    Another iterator.
+   *  @param  comp    A comparison functor.
+   *  @return  Nothing.
+   *
+   *  While the range containing @p nth is above the cutoff it is split
+   *  three ways around a median-of-three pivot with a parallel
+   *  partition; the remainder is handled by std::__introselect.
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    nth_element(_RandomAccessIterator __first, _RandomAccessIterator __nth,
+		_RandomAccessIterator __last, _Compare __comp)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+
+      if (__first == __last || __nth == __last)
+	return;
+
+      const unsigned int __threads
+	= _Thread_pool::_S_get()._M_get_num_threads();
+      int __depth_limit = std::__lg(__last - __first) * 2;
+      while (__depth_limit-- > 0
+	     && __is_parallel(__last - __first,
+			      std::max(size_t(16), _Settings::get().
+				       nth_element_minimal_n)))
+	{
+	  const _ValueType __pivot(std::__median(*__first,
+						 *(__first
+						   + (__last - __first) / 2),
+						 *(__last - 1), __comp));
+	  const _RandomAccessIterator __lo
+	    = __parallel_partition(__first, __last,
+				   _Less_than_pivot<_ValueType,
+				   _Compare>(__pivot, __comp), __threads);
+	  if (__nth < __lo)
+	    {
+	      __last = __lo;
+	      continue;
+	    }
+	  const _RandomAccessIterator __hi
+	    = __parallel_partition(__lo, __last,
+				   _Not_greater_than_pivot<_ValueType,
+				   _Compare>(__pivot, __comp), __threads);
+	  if (__nth < __hi)
+	    return;
+	  __first = __hi;
+	}
+      std::__introselect(__first, __nth, __last,
+			 std::__lg(__last - __first) * 2, __comp);
+    }
+
+  /**
+   *  @brief Sort a sequence just enough to find a particular position,
+   *         in parallel.
+   *  @param  first   An iterator.
+   *  @param  nth     Another iterator.
+   *  @param  last    Another iterator.
+   *  @return  Nothing.
+  */
+  template<typename _RandomAccessIterator>
+    void
+    nth_element(_RandomAccessIterator __first, _RandomAccessIterator __nth,
+		_RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+      __gnu_parallel::nth_element(__first, __nth, __last,
+				  _Less<_ValueType>());
+    }
+
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation>
+    struct _Transform_job
+    {
+      _InputIterator   _M_first;
+      _InputIterator   _M_last;
+      _OutputIterator  _M_result;
+      _UnaryOperation  _M_op;
+
+      _Transform_job(_InputIterator __first, _InputIterator __last,
+		     _OutputIterator __result, _UnaryOperation __op)
+      : _M_first(__first), _M_last(__last), _M_result(__result),
+	_M_op(__op) { }
+
+      void
+      operator()()
+      {
+	for (; _M_first != _M_last; ++_M_first, ++_M_result)
+	  *_M_result = _M_op(*_M_first);
+      }
+    };
+
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation>
+    struct _Transform2_job
+    {
+      _InputIterator1  _M_first1;
+      _InputIterator1  _M_last1;
+      _InputIterator2  _M_first2;
+      _OutputIterator  _M_result;
+      _BinaryOperation _M_op;
+
+      _Transform2_job(_InputIterator1 __first1, _InputIterator1 __last1,
+		      _InputIterator2 __first2, _OutputIterator __result,
+		      _BinaryOperation __op)
+      : _M_first1(__first1), _M_last1(__last1), _M_first2(__first2),
+	_M_result(__result), _M_op(__op) { }
+
+      void
+      operator()()
+      {
+	for (; _M_first1 != _M_last1; ++_M_first1, ++_M_first2, ++_M_result)
+	  *_M_result = _M_op(*_M_first1, *_M_first2);
+      }
+    };
+
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation, typename _IteratorTag1,
+	   typename _IteratorTag2>
+    inline _OutputIterator
+    __transform_switch(_InputIterator __first, _InputIterator __last,
+		       _OutputIterator __result, _UnaryOperation __op,
+		       _IteratorTag1, _IteratorTag2)
+    {
+      _Transform_job<_InputIterator, _OutputIterator, _UnaryOperation>
+	__job(__first, __last, __result, __op);
+      __job();
+      return __job._M_result;
+    }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _UnaryOperation>
+    _RandomAccessIterator2
+    __transform_switch(_RandomAccessIterator1 __first,
+		       _RandomAccessIterator1 __last,
+		       _RandomAccessIterator2 __result, _UnaryOperation __op,
+		       std::random_access_iterator_tag,
+		       std::random_access_iterator_tag)
+    {
+      const typename std::iterator_traits<_RandomAccessIterator1>::
+	difference_type __n = __last - __first;
+      if (!__is_parallel(__n, _Settings::get().transform_minimal_n))
+	return __transform_switch(__first, __last, __result, __op,
+				  std::input_iterator_tag(),
+				  std::output_iterator_tag());
+
+      const unsigned int __chunks
+	= _Thread_pool::_S_get()._M_get_num_threads();
+      _Task_group __group;
+      for (unsigned int __i = 0; __i < __chunks; ++__i)
+	{
+	  const _RandomAccessIterator1 __b
+	    = __chunk_begin(__first, __n, __chunks, __i);
+	  __group.run(_Transform_job<_RandomAccessIterator1,
+		      _RandomAccessIterator2, _UnaryOperation>
+		      (__b, __chunk_begin(__first, __n, __chunks, __i + 1),
+		       __result + (__b - __first), __op));
+	}
+      __group.wait();
+      return __result + __n;
+    }
+
+  /**
+   *  @brief Perform an operation on a sequence, in parallel.
+   *  @param  first     An input iterator.
+   *  @param  last      An input iterator.
+   *  @param  result    An output iterator.
+   *  @param  unary_op  A unary operator.
+   *  @return   An output iterator equal to @p result+(last-first).
+   *
+   *  Runs in parallel when both iterators are random access.  The
+   *  order in which @p unary_op is applied is unspecified and it may
+   *  be called concurrently.
+  */
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation>
+    _OutputIterator
+    transform(_InputIterator __first, _InputIterator __last,
+	      _OutputIterator __result, _UnaryOperation __unary_op)
+    {
+      return __transform_switch(__first, __last, __result, __unary_op,
+				std::__iterator_category(__first),
+				std::__iterator_category(__result));
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation,
+	   typename _IteratorTag1, typename _IteratorTag2,
+	   typename _IteratorTag3>
+    inline _OutputIterator
+    __transform2_switch(_InputIterator1 __first1, _InputIterator1 __last1,
+			_InputIterator2 __first2, _OutputIterator __result,
+			_BinaryOperation __op, _IteratorTag1, _IteratorTag2,
+			_IteratorTag3)
+    {
+      _Transform2_job<_InputIterator1, _InputIterator2, _OutputIterator,
+		      _BinaryOperation>
+	__job(__first1, __last1, __first2, __result, __op);
+      __job();
+      return __job._M_result;
+    }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _RandomAccessIterator3, typename _BinaryOperation>
+    _RandomAccessIterator3
+    __transform2_switch(_RandomAccessIterator1 __first1,
+			_RandomAccessIterator1 __last1,
+			_RandomAccessIterator2 __first2,
+			_RandomAccessIterator3 __result,
+			_BinaryOperation __op,
+			std::random_access_iterator_tag,
+			std::random_access_iterator_tag,
+			std::random_access_iterator_tag)
+    {
+      const typename std::iterator_traits<_RandomAccessIterator1>::
+	difference_type __n = __last1 - __first1;
+      if (!__is_parallel(__n, _Settings::get().transform_minimal_n))
+	return __transform2_switch(__first1, __last1, __first2, __result,
+				   __op, std::input_iterator_tag(),
+				   std::input_iterator_tag(),
+				   std::output_iterator_tag());
+
+      const unsigned int __chunks
+	= _Thread_pool::_S_get()._M_get_num_threads();
+      _Task_group __group;
+      for (unsigned int __i = 0; __i < __chunks; ++__i)
+	{
+	  const _RandomAccessIterator1 __b
+	    = __chunk_begin(__first1, __n, __chunks, __i);
+	  __group.run(_Transform2_job<_RandomAccessIterator1,
+		      _RandomAccessIterator2, _RandomAccessIterator3,
+		      _BinaryOperation>
+		      (__b, __chunk_begin(__first1, __n, __chunks, __i + 1),
+		       __first2 + (__b - __first1),
+		       __result + (__b - __first1), __op));
+	}
+      __group.wait();
+      return __result + __n;
+    }
+
+  /**
+   *  @brief Perform an operation on corresponding elements of two
+   *         sequences, in parallel.
+   *  @param  first1     An input iterator.
+   *  @param  last1      An input iterator.
+   *  @param  first2     An input iterator.
+   *  @param  result     An output iterator.
+   *  @param  binary_op  A binary operator.
+   *  @return   An output iterator equal to @p result+(last-first).
+  */
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation>
+    _OutputIterator
+    transform(_InputIterator1 __first1, _InputIterator1 __last1,
+	      _InputIterator2 __first2, _OutputIterator __result,
+	      _BinaryOperation __binary_op)
+    {
+      return __transform2_switch(__first1, __last1, __first2, __result,
+				 __binary_op,
+				 std::__iterator_category(__first1),
+				 std::__iterator_category(__first2),
+				 std::__iterator_category(__result));
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
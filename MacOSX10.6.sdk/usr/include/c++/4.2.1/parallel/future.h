@@ -0,0 +1,473 @@
+// Parallel mode futures and promises -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/future.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  promise, future and async after the futures of the C++0x working
+ *  paper, running on the thread pool of the parallel mode.  Threads
+ *  waiting on a future run queued tasks in the meantime.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_FUTURE_H
+#define _GLIBCXX_PARALLEL_FUTURE_H 1
+
+#include <new>
+#include <tr1/type_traits>
+#include <tr1/functional>
+#include <parallel/thread_pool.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  // State shared by a promise, its futures and the task computing the
+  // value.  Reference counted; the last owner deletes it.
+  class _Future_state_base
+  {
+  protected:
+    enum _Status { _S_pending, _S_value, _S_failed, _S_broken };
+
+  private:
+    __gnu_cxx::atomic<unsigned int>	_M_refcount;
+    __gnu_cxx::atomic<bool>		_M_claimed;
+    __gnu_cxx::atomic<int>		_M_status;
+
+    _Future_state_base(const _Future_state_base&);
+    _Future_state_base& operator=(const _Future_state_base&);
+
+    struct _Ready
+    {
+      const _Future_state_base* _M_state;
+
+      bool
+      operator()() const
+      { return _M_state->_M_is_ready(); }
+    };
+
+  protected:
+    _Future_state_base()
+    : _M_refcount(1), _M_claimed(false), _M_status(_S_pending) { }
+
+    virtual
+    ~_Future_state_base() { }
+
+    // Reserves the right to make the state ready.  Only the first
+    // caller succeeds.
+    bool
+    _M_claim()
+    { return !_M_claimed.exchange(true); }
+
+    void
+    _M_unclaim()
+    { _M_claimed.store(false); }
+
+    void
+    _M_set_status(_Status __status)
+    {
+      _M_status.store(__status);
+      _Thread_pool::_S_get()._M_notify();
+    }
+
+    void
+    _M_claim_or_throw()
+    {
+      if (!_M_claim())
+	std::__throw_logic_error(__N("__gnu_parallel::promise::set_value "
+				     "promise already satisfied"));
+    }
+
+  public:
+    void
+    _M_add_ref()
+    { _M_refcount.fetch_add(1, __gnu_cxx::memory_order_relaxed); }
+
+    void
+    _M_release()
+    {
+      if (_M_refcount.fetch_sub(1) == 1)
+	delete this;
+    }
+
+    bool
+    _M_is_ready() const
+    { return _M_status.load() != _S_pending; }
+
+    bool
+    _M_has_value() const
+    { return _M_status.load() == _S_value; }
+
+    void
+    _M_wait() const
+    {
+      if (!_M_is_ready())
+	{
+	  _Ready __ready = { this };
+	  _Thread_pool::_S_get()._M_run_until(__ready);
+	}
+    }
+
+    // Waits, then throws unless a value was stored.
+    void
+    _M_get() const
+    {
+      _M_wait();
+      switch (_M_status.load())
+	{
+	case _S_failed:
+	  std::__throw_runtime_error(__N("__gnu_parallel::future::get "
+					 "task exited with an exception"));
+	case _S_broken:
+	  std::__throw_runtime_error(__N("__gnu_parallel::future::get "
+					 "broken promise"));
+	default:
+	  break;
+	}
+    }
+
+    void
+    _M_set_failed()
+    {
+      if (_M_claim())
+	_M_set_status(_S_failed);
+    }
+
+    void
+    _M_abandon()
+    {
+      if (_M_claim())
+	_M_set_status(_S_broken);
+    }
+  };
+
+  template<typename _Tp>
+    class _Future_state : public _Future_state_base
+    {
+      typedef typename std::tr1::aligned_storage<sizeof(_Tp),
+	std::tr1::alignment_of<_Tp>::value>::type _Storage;
+
+      _Storage _M_storage;
+
+    public:
+      ~_Future_state()
+      {
+	if (_M_has_value())
+	  _M_value().~_Tp();
+      }
+
+      _Tp&
+      _M_value()
+      { return *static_cast<_Tp*>(static_cast<void*>(&_M_storage)); }
+
+      void
+      _M_set_value(const _Tp& __value)
+      {
+	_M_claim_or_throw();
+	try
+	  { ::new(static_cast<void*>(&_M_storage)) _Tp(__value); }
+	catch(...)
+	  {
+	    _M_unclaim();
+	    __throw_exception_again;
+	  }
+	_M_set_status(_S_value);
+      }
+    };
+
+  template<>
+    class _Future_state<void> : public _Future_state_base
+    {
+    public:
+      void
+      _M_set_value()
+      {
+	_M_claim_or_throw();
+	_M_set_status(_S_value);
+      }
+    };
+
+  template<typename _Tp>
+    class _Future_base
+    {
+    protected:
+      typedef _Future_state<_Tp> _State;
+
+      _State* _M_state;
+
+      _Future_base() : _M_state(0) { }
+
+      explicit
+      _Future_base(_State* __state) : _M_state(__state)
+      { _M_state->_M_add_ref(); }
+
+      _Future_base(const _Future_base& __f) : _M_state(__f._M_state)
+      {
+	if (_M_state)
+	  _M_state->_M_add_ref();
+      }
+
+      ~_Future_base()
+      {
+	if (_M_state)
+	  _M_state->_M_release();
+      }
+
+      _State*
+      _M_checked_state() const
+      {
+	if (!_M_state)
+	  std::__throw_logic_error(__N("__gnu_parallel::future "
+				       "no associated state"));
+	return _M_state;
+      }
+
+    public:
+      /// True if the future refers to a shared state.
+      bool
+      valid() const
+      { return _M_state != 0; }
+
+      /// True if the shared state holds a value or an error.
+      bool
+      is_ready() const
+      { return _M_state && _M_state->_M_is_ready(); }
+
+      /// Blocks until the shared state is ready, running queued tasks
+      /// in the meantime.
+      void
+      wait() const
+      { _M_checked_state()->_M_wait(); }
+    };
+
+  /**
+   *  @brief  The result of an asynchronous computation.
+   *
+   *  Copies refer to the same shared state, like the shared_future of
+   *  the working paper.  get() waits for the state to become ready and
+   *  returns the stored value; it throws std::runtime_error if the
+   *  computation exited with an exception or its promise was destroyed
+   *  without a value.
+   */
+  template<typename _Tp>
+    class future : public _Future_base<_Tp>
+    {
+      typedef _Future_base<_Tp> _Base;
+
+    public:
+      future() { }
+
+      explicit
+      future(_Future_state<_Tp>* __state) : _Base(__state) { }
+
+      future&
+      operator=(const future& __f)
+      {
+	future __tmp(__f);
+	swap(__tmp);
+	return *this;
+      }
+
+      void
+      swap(future& __f)
+      {
+	_Future_state<_Tp>* __tmp = this->_M_state;
+	this->_M_state = __f._M_state;
+	__f._M_state = __tmp;
+      }
+
+      const _Tp&
+      get() const
+      {
+	this->_M_checked_state()->_M_get();
+	return this->_M_state->_M_value();
+      }
+    };
+
+  template<>
+    class future<void> : public _Future_base<void>
+    {
+    public:
+      future() { }
+
+      explicit
+      future(_Future_state<void>* __state) : _Future_base<void>(__state) { }
+
+      future&
+      operator=(const future& __f)
+      {
+	future __tmp(__f);
+	swap(__tmp);
+	return *this;
+      }
+
+      void
+      swap(future& __f)
+      {
+	_Future_state<void>* __tmp = _M_state;
+	_M_state = __f._M_state;
+	__f._M_state = __tmp;
+      }
+
+      void
+      get() const
+      { _M_checked_state()->_M_get(); }
+    };
+
+  template<typename _Tp>
+    inline void
+    swap(future<_Tp>& __x, future<_Tp>& __y)
+    { __x.swap(__y); }
+
+  template<typename _Tp>
+    class _Promise_base
+    {
+      _Promise_base(const _Promise_base&);
+      _Promise_base& operator=(const _Promise_base&);
+
+    protected:
+      _Future_state<_Tp>* _M_state;
+
+      _Promise_base() : _M_state(new _Future_state<_Tp>) { }
+
+      ~_Promise_base()
+      {
+	_M_state->_M_abandon();
+	_M_state->_M_release();
+      }
+
+    public:
+      future<_Tp>
+      get_future()
+      { return future<_Tp>(_M_state); }
+    };
+
+  /**
+   *  @brief  The producing end of a future.
+   *
+   *  set_value() stores the value and wakes the threads waiting on the
+   *  futures obtained from get_future(); it throws std::logic_error if
+   *  a value has already been set.  Destroying a promise without a
+   *  value makes its futures throw from get().  Not copyable.
+   */
+  template<typename _Tp>
+    class promise : public _Promise_base<_Tp>
+    {
+    public:
+      void
+      set_value(const _Tp& __value)
+      { this->_M_state->_M_set_value(__value); }
+    };
+
+  template<>
+    class promise<void> : public _Promise_base<void>
+    {
+    public:
+      void
+      set_value()
+      { _M_state->_M_set_value(); }
+    };
+
+  // Computes the value of a future on the pool.  Adopts the reference
+  // its creator holds on the state.
+  template<typename _Res, typename _Function>
+    struct _Async_task : public _Task_base
+    {
+      _Function		   _M_fn;
+      _Future_state<_Res>* _M_state;
+
+      _Async_task(const _Function& __fn, _Future_state<_Res>* __state)
+      : _M_fn(__fn), _M_state(__state) { }
+
+      ~_Async_task()
+      { _M_state->_M_release(); }
+
+      virtual void
+      _M_run()
+      {
+	try
+	  { _M_state->_M_set_value(_M_fn()); }
+	catch(...)
+	  { _M_state->_M_set_failed(); }
+      }
+    };
+
+  template<typename _Function>
+    struct _Async_task<void, _Function> : public _Task_base
+    {
+      _Function		    _M_fn;
+      _Future_state<void>* _M_state;
+
+      _Async_task(const _Function& __fn, _Future_state<void>* __state)
+      : _M_fn(__fn), _M_state(__state) { }
+
+      ~_Async_task()
+      { _M_state->_M_release(); }
+
+      virtual void
+      _M_run()
+      {
+	try
+	  {
+	    _M_fn();
+	    _M_state->_M_set_value();
+	  }
+	catch(...)
+	  { _M_state->_M_set_failed(); }
+      }
+    };
+
+  /**
+   *  @brief  Runs a nullary function on the thread pool.
+   *  @param  fn  A function pointer, or a function object with a
+   *              result_type member.
+   *  @return  A future for the result of @p fn().
+   *
+   *  When the pool has no threads, @p fn is called before async
+   *  returns.
+   */
+  template<typename _Function>
+    future<typename std::tr1::result_of<_Function()>::type>
+    async(_Function __fn)
+    {
+      typedef typename std::tr1::result_of<_Function()>::type _Res;
+      _Future_state<_Res>* __state = new _Future_state<_Res>;
+      future<_Res> __f(__state);
+      _Task_base* __task;
+      try
+	{ __task = new _Async_task<_Res, _Function>(__fn, __state); }
+      catch(...)
+	{
+	  __state->_M_release();
+	  __throw_exception_again;
+	}
+      _Thread_pool::_S_get()._M_spawn(__task);
+      return __f;
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,378 @@
+// Parallel mode numeric algorithms -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/numeric.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  Multithreaded versions of accumulate and inner_product.  The range
+ *  is split into one chunk per thread, each chunk is folded on its own
+ *  and the partial results are combined from left to right.  This
+ *  requires the operation to be associative; for floating-point types
+ *  the result may differ in the last bits from the sequential fold.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_NUMERIC_H
+#define _GLIBCXX_PARALLEL_NUMERIC_H 1
+
+#include <new>
+#include <bits/stl_iterator_base_types.h>
+#include <bits/stl_construct.h>
+#include <parallel/numericfwd.h>
+#include <parallel/algo.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  // Raw storage for one partial result per chunk.  Only the slots that
+  // were actually constructed are destroyed.
+  template<typename _Tp>
+    class _Partial_results
+    {
+      _Tp*  _M_storage;
+      bool  _M_built[_S_max_chunks];
+
+      _Partial_results(const _Partial_results&);
+      _Partial_results& operator=(const _Partial_results&);
+
+    public:
+      explicit
+      _Partial_results(unsigned int __n)
+      : _M_storage(static_cast<_Tp*>(::operator new(__n * sizeof(_Tp))))
+      { std::fill(_M_built, _M_built + _S_max_chunks, false); }
+
+      ~_Partial_results()
+      {
+	for (unsigned int __i = 0; __i < _S_max_chunks; ++__i)
+	  if (_M_built[__i])
+	    std::_Destroy(_M_storage + __i);
+	::operator delete(_M_storage);
+      }
+
+      void
+      _M_set(unsigned int __i, const _Tp& __value)
+      {
+	std::_Construct(_M_storage + __i, __value);
+	_M_built[__i] = true;
+      }
+
+      _Tp&
+      operator[](unsigned int __i)
+      { return _M_storage[__i]; }
+    };
+
+  template<typename _RandomAccessIterator, typename _Tp,
+	   typename _BinaryOperation>
+    struct _Accumulate_job
+    {
+      _RandomAccessIterator	_M_first;
+      _RandomAccessIterator	_M_last;
+      const _Tp*		_M_init;
+      _BinaryOperation		_M_op;
+      _Partial_results<_Tp>*	_M_results;
+      unsigned int		_M_index;
+
+      _Accumulate_job(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, const _Tp* __init,
+		      _BinaryOperation __op, _Partial_results<_Tp>* __results,
+		      unsigned int __index)
+      : _M_first(__first), _M_last(__last), _M_init(__init), _M_op(__op),
+	_M_results(__results), _M_index(__index) { }
+
+      void
+      operator()()
+      {
+	// Only the first chunk starts from the caller's initial value.
+	_Tp __acc(_M_init ? *_M_init : _Tp(*_M_first++));
+	for (; _M_first != _M_last; ++_M_first)
+	  __acc = _M_op(__acc, *_M_first);
+	_M_results->_M_set(_M_index, __acc);
+      }
+    };
+
+  template<typename _InputIterator, typename _Tp, typename _BinaryOperation>
+    inline _Tp
+    __accumulate_switch(_InputIterator __first, _InputIterator __last,
+			_Tp __init, _BinaryOperation __binary_op,
+			std::input_iterator_tag)
+    {
+      for (; __first != __last; ++__first)
+	__init = __binary_op(__init, *__first);
+      return __init;
+    }
+
+  template<typename _RandomAccessIterator, typename _Tp,
+	   typename _BinaryOperation>
+    _Tp
+    __accumulate_switch(_RandomAccessIterator __first,
+			_RandomAccessIterator __last, _Tp __init,
+			_BinaryOperation __binary_op,
+			std::random_access_iterator_tag)
+    {
+      const typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type __n = __last - __first;
+      unsigned int __chunks = _Thread_pool::_S_get()._M_get_num_threads();
+      if (!__is_parallel(__n, _Settings::get().accumulate_minimal_n)
+	  || size_t(__n) < __chunks)
+	return __accumulate_switch(__first, __last, __init, __binary_op,
+				   std::input_iterator_tag());
+
+      _Partial_results<_Tp> __partial(__chunks);
+      {
+	_Task_group __group;
+	for (unsigned int __i = 0; __i < __chunks; ++__i)
+	  __group.run(_Accumulate_job<_RandomAccessIterator, _Tp,
+		      _BinaryOperation>
+		      (__chunk_begin(__first, __n, __chunks, __i),
+		       __chunk_begin(__first, __n, __chunks, __i + 1),
+		       __i == 0 ? &__init : 0, __binary_op, &__partial, __i));
+	__group.wait();
+      }
+      _Tp __result(__partial[0]);
+      for (unsigned int __i = 1; __i < __chunks; ++__i)
+	__result = __binary_op(__result, __partial[__i]);
+      return __result;
+    }
+
+  /**
+   *  @brief  Accumulate values in a range with operation, in parallel.
+   *
+   *  As std::accumulate, but @a binary_op must be associative and
+   *  @a Tp constructible from the value type of the range.
+   *
+   *  @param  first  Start of range.
+   *  @param  last  End of range.
+   *  @param  init  Starting value to add other values to.
+   *  @param  binary_op  Function object to accumulate with.
+   *  @return  The final sum.
+   */
+  template<typename _InputIterator, typename _Tp, typename _BinaryOperation>
+    _Tp
+    accumulate(_InputIterator __first, _InputIterator __last, _Tp __init,
+	       _BinaryOperation __binary_op)
+    {
+      return __accumulate_switch(__first, __last, __init, __binary_op,
+				 std::__iterator_category(__first));
+    }
+
+  /**
+   *  @brief  Accumulate values in a range, in parallel.
+   *
+   *  @param  first  Start of range.
+   *  @param  last  End of range.
+   *  @param  init  Starting value to add other values to.
+   *  @return  The final sum.
+   */
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    accumulate(_InputIterator __first, _InputIterator __last, _Tp __init)
+    {
+      return __gnu_parallel::accumulate(__first, __last, __init,
+					_Plus<_Tp>());
+    }
+
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    __accumulate_switch(_InputIterator __first, _InputIterator __last,
+			_Tp __init, std::__true_type)
+    { return __gnu_parallel::accumulate(__first, __last, __init); }
+
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    __accumulate_switch(_InputIterator __first, _InputIterator __last,
+			_Tp __init, std::__false_type)
+    {
+      for (; __first != __last; ++__first)
+	__init = __init + *__first;
+      return __init;
+    }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _Tp, typename _BinaryOperation1,
+	   typename _BinaryOperation2>
+    struct _Inner_product_job
+    {
+      _RandomAccessIterator1	_M_first1;
+      _RandomAccessIterator1	_M_last1;
+      _RandomAccessIterator2	_M_first2;
+      const _Tp*		_M_init;
+      _BinaryOperation1		_M_op1;
+      _BinaryOperation2		_M_op2;
+      _Partial_results<_Tp>*	_M_results;
+      unsigned int		_M_index;
+
+      _Inner_product_job(_RandomAccessIterator1 __first1,
+			 _RandomAccessIterator1 __last1,
+			 _RandomAccessIterator2 __first2, const _Tp* __init,
+			 _BinaryOperation1 __op1, _BinaryOperation2 __op2,
+			 _Partial_results<_Tp>* __results,
+			 unsigned int __index)
+      : _M_first1(__first1), _M_last1(__last1), _M_first2(__first2),
+	_M_init(__init), _M_op1(__op1), _M_op2(__op2),
+	_M_results(__results), _M_index(__index) { }
+
+      void
+      operator()()
+      {
+	_Tp __acc(_M_init ? *_M_init
+		  : _Tp(_M_op2(*_M_first1++, *_M_first2++)));
+	for (; _M_first1 != _M_last1; ++_M_first1, ++_M_first2)
+	  __acc = _M_op1(__acc, _M_op2(*_M_first1, *_M_first2));
+	_M_results->_M_set(_M_index, __acc);
+      }
+    };
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp,
+	   typename _BinaryOperation1, typename _BinaryOperation2,
+	   typename _IteratorTag1, typename _IteratorTag2>
+    inline _Tp
+    __inner_product_switch(_InputIterator1 __first1,
+			   _InputIterator1 __last1,
+			   _InputIterator2 __first2, _Tp __init,
+			   _BinaryOperation1 __op1, _BinaryOperation2 __op2,
+			   _IteratorTag1, _IteratorTag2)
+    {
+      for (; __first1 != __last1; ++__first1, ++__first2)
+	__init = __op1(__init, __op2(*__first1, *__first2));
+      return __init;
+    }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _Tp, typename _BinaryOperation1,
+	   typename _BinaryOperation2>
+    _Tp
+    __inner_product_switch(_RandomAccessIterator1 __first1,
+			   _RandomAccessIterator1 __last1,
+			   _RandomAccessIterator2 __first2, _Tp __init,
+			   _BinaryOperation1 __op1, _BinaryOperation2 __op2,
+			   std::random_access_iterator_tag,
+			   std::random_access_iterator_tag)
+    {
+      const typename std::iterator_traits<_RandomAccessIterator1>::
+	difference_type __n = __last1 - __first1;
+      unsigned int __chunks = _Thread_pool::_S_get()._M_get_num_threads();
+      if (!__is_parallel(__n, _Settings::get().inner_product_minimal_n)
+	  || size_t(__n) < __chunks)
+	return __inner_product_switch(__first1, __last1, __first2, __init,
+				      __op1, __op2,
+				      std::input_iterator_tag(),
+				      std::input_iterator_tag());
+
+      _Partial_results<_Tp> __partial(__chunks);
+      {
+	_Task_group __group;
+	for (unsigned int __i = 0; __i < __chunks; ++__i)
+	  {
+	    const _RandomAccessIterator1 __b
+	      = __chunk_begin(__first1, __n, __chunks, __i);
+	    __group.run(_Inner_product_job<_RandomAccessIterator1,
+			_RandomAccessIterator2, _Tp, _BinaryOperation1,
+			_BinaryOperation2>
+			(__b, __chunk_begin(__first1, __n, __chunks, __i + 1),
+			 __first2 + (__b - __first1),
+			 __i == 0 ? &__init : 0, __op1, __op2, &__partial,
+			 __i));
+	  }
+	__group.wait();
+      }
+      _Tp __result(__partial[0]);
+      for (unsigned int __i = 1; __i < __chunks; ++__i)
+	__result = __op1(__result, __partial[__i]);
+      return __result;
+    }
+
+  /**
+   *  @brief  Compute inner product of two ranges with operations, in
+   *          parallel.
+   *
+   *  As std::inner_product, but @a binary_op1 must be associative.
+   *
+   *  @param  first1  Start of range 1.
+   *  @param  last1  End of range 1.
+   *  @param  first2  Start of range 2.
+   *  @param  init  Starting value to add other values to.
+   *  @param  binary_op1  Function object to accumulate with.
+   *  @param  binary_op2  Function object to apply to pairs of input values.
+   *  @return  The final inner product.
+   */
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp,
+	   typename _BinaryOperation1, typename _BinaryOperation2>
+    _Tp
+    inner_product(_InputIterator1 __first1, _InputIterator1 __last1,
+		  _InputIterator2 __first2, _Tp __init,
+		  _BinaryOperation1 __binary_op1,
+		  _BinaryOperation2 __binary_op2)
+    {
+      return __inner_product_switch(__first1, __last1, __first2, __init,
+				    __binary_op1, __binary_op2,
+				    std::__iterator_category(__first1),
+				    std::__iterator_category(__first2));
+    }
+
+  /**
+   *  @brief  Compute inner product of two ranges, in parallel.
+   *
+   *  @param  first1  Start of range 1.
+   *  @param  last1  End of range 1.
+   *  @param  first2  Start of range 2.
+   *  @param  init  Starting value to add other values to.
+   *  @return  The final inner product.
+   */
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    inner_product(_InputIterator1 __first1, _InputIterator1 __last1,
+		  _InputIterator2 __first2, _Tp __init)
+    {
+      return __gnu_parallel::inner_product(__first1, __last1, __first2,
+					   __init, _Plus<_Tp>(),
+					   _Multiplies<_Tp>());
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    __inner_product_switch(_InputIterator1 __first1, _InputIterator1 __last1,
+			   _InputIterator2 __first2, _Tp __init,
+			   std::__true_type)
+    {
+      return __gnu_parallel::inner_product(__first1, __last1, __first2,
+					   __init);
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    __inner_product_switch(_InputIterator1 __first1, _InputIterator1 __last1,
+			   _InputIterator2 __first2, _Tp __init,
+			   std::__false_type)
+    {
+      for (; __first1 != __last1; ++__first1, ++__first2)
+	__init = __init + (*__first1 * *__first2);
+      return __init;
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,106 @@
+// Parallel mode numeric declarations -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/numericfwd.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_NUMERICFWD_H
+#define _GLIBCXX_PARALLEL_NUMERICFWD_H 1
+
+#include <bits/c++config.h>
+#include <bits/cpp_type_traits.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  /// operator+ as a function object; the result has the type of the
+  /// left operand, as in std::accumulate.
+  template<typename _Tp>
+    struct _Plus
+    {
+      template<typename _Up>
+        _Tp
+        operator()(const _Tp& __x, const _Up& __y) const
+        { return __x + __y; }
+    };
+
+  /// operator* as a function object, for std::inner_product.
+  template<typename _Tp>
+    struct _Multiplies
+    {
+      _Tp
+      operator()(const _Tp& __x, const _Tp& __y) const
+      { return __x * __y; }
+    };
+
+  template<typename _InputIterator, typename _Tp, typename _BinaryOperation>
+    _Tp
+    accumulate(_InputIterator, _InputIterator, _Tp, _BinaryOperation);
+
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    accumulate(_InputIterator, _InputIterator, _Tp);
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp,
+	   typename _BinaryOperation1, typename _BinaryOperation2>
+    _Tp
+    inner_product(_InputIterator1, _InputIterator1, _InputIterator2, _Tp,
+		  _BinaryOperation1, _BinaryOperation2);
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    inner_product(_InputIterator1, _InputIterator1, _InputIterator2, _Tp);
+
+  // Used by std::accumulate and std::inner_product in parallel mode:
+  // only the operator+/operator* forms over one arithmetic type are
+  // redirected, the others keep their strict left-to-right order.
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    __accumulate_switch(_InputIterator, _InputIterator, _Tp,
+			std::__true_type);
+
+  template<typename _InputIterator, typename _Tp>
+    _Tp
+    __accumulate_switch(_InputIterator, _InputIterator, _Tp,
+			std::__false_type);
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    __inner_product_switch(_InputIterator1, _InputIterator1,
+			   _InputIterator2, _Tp, std::__true_type);
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    _Tp
+    __inner_product_switch(_InputIterator1, _InputIterator1,
+			   _InputIterator2, _Tp, std::__false_type);
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
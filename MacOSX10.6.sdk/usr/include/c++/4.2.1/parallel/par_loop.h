@@ -0,0 +1,242 @@
+// Parallel mode loops -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/par_loop.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  parallel_for and parallel_reduce: recursive binary splitting of an
+ *  index range into _Task_group tasks, so idle threads steal the large
+ *  halves and the caller keeps working on the small ones.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_PAR_LOOP_H
+#define _GLIBCXX_PARALLEL_PAR_LOOP_H 1
+
+#include <parallel/thread_pool.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  // Default grain size: about eight pieces per thread, so stealing can
+  // even out pieces of unequal cost.
+  inline size_t
+  __default_grain(size_t __n)
+  {
+    const size_t __pieces
+      = 8 * size_t(_Thread_pool::_S_get()._M_get_num_threads());
+    return __n > __pieces ? __n / __pieces : 1;
+  }
+
+  template<typename _Index, typename _Function>
+    void
+    __parallel_for(_Index __first, _Index __last, size_t __grain,
+		   _Function& __f);
+
+  template<typename _Index, typename _Function>
+    struct _For_job
+    {
+      _Index		_M_first;
+      _Index		_M_last;
+      size_t		_M_grain;
+      _Function*	_M_f;
+
+      _For_job(_Index __first, _Index __last, size_t __grain,
+	       _Function* __f)
+      : _M_first(__first), _M_last(__last), _M_grain(__grain), _M_f(__f) { }
+
+      void
+      operator()()
+      { __parallel_for(_M_first, _M_last, _M_grain, *_M_f); }
+    };
+
+  template<typename _Index, typename _Function>
+    void
+    __parallel_for(_Index __first, _Index __last, size_t __grain,
+		   _Function& __f)
+    {
+      if (size_t(__last - __first) <= __grain)
+	{
+	  for (; __first != __last; ++__first)
+	    __f(__first);
+	  return;
+	}
+      const _Index __middle = __first + (__last - __first) / 2;
+      _Task_group __group;
+      __group.run(_For_job<_Index, _Function>(__middle, __last,
+					      __grain, &__f));
+      __parallel_for(__first, __middle, __grain, __f);
+      __group.wait();
+    }
+
+  /**
+   *  @brief  Calls a function for every index of a range, in parallel.
+   *  @param  first  Start of range.
+   *  @param  last  End of range.
+   *  @param  grain  Largest number of indices one task handles.
+   *  @param  f  Function object called as @p f(i) for every @p i in
+   *             [first, last).
+   *
+   *  @a Index is an integral type or a random access iterator; in the
+   *  latter case @p f receives iterators.  The calls happen on several
+   *  threads at once and in no particular order, all on the same copy
+   *  of @p f.  If a call throws, the remaining tasks still run and
+   *  std::runtime_error is thrown once they have finished.
+   */
+  template<typename _Index, typename _Function>
+    void
+    parallel_for(_Index __first, _Index __last, size_t __grain, _Function __f)
+    {
+      if (__first == __last)
+	return;
+      if (_Thread_pool::_S_get()._M_get_num_threads() < 2)
+	__grain = size_t(__last - __first);
+      __parallel_for(__first, __last, __grain ? __grain : 1, __f);
+    }
+
+  /**
+   *  @brief  Calls a function for every index of a range, in parallel.
+   *
+   *  As above, with a grain size chosen from the number of threads.
+   */
+  template<typename _Index, typename _Function>
+    inline void
+    parallel_for(_Index __first, _Index __last, _Function __f)
+    {
+      if (__first != __last)
+	parallel_for(__first, __last,
+		     __default_grain(size_t(__last - __first)), __f);
+    }
+
+  template<typename _Index, typename _Tp, typename _RangeOperation,
+	   typename _Combine>
+    _Tp
+    __parallel_reduce(_Index __first, _Index __last, size_t __grain,
+		      const _Tp& __identity, _RangeOperation& __op,
+		      _Combine& __combine);
+
+  template<typename _Index, typename _Tp, typename _RangeOperation,
+	   typename _Combine>
+    struct _Reduce_job
+    {
+      _Index		_M_first;
+      _Index		_M_last;
+      size_t		_M_grain;
+      const _Tp*	_M_identity;
+      _RangeOperation*	_M_op;
+      _Combine*		_M_combine;
+      _Tp*		_M_result;
+
+      _Reduce_job(_Index __first, _Index __last, size_t __grain,
+		  const _Tp* __identity, _RangeOperation* __op,
+		  _Combine* __combine, _Tp* __result)
+      : _M_first(__first), _M_last(__last), _M_grain(__grain),
+	_M_identity(__identity), _M_op(__op), _M_combine(__combine),
+	_M_result(__result) { }
+
+      void
+      operator()()
+      {
+	*_M_result = __parallel_reduce(_M_first, _M_last, _M_grain,
+				       *_M_identity, *_M_op, *_M_combine);
+      }
+    };
+
+  template<typename _Index, typename _Tp, typename _RangeOperation,
+	   typename _Combine>
+    _Tp
+    __parallel_reduce(_Index __first, _Index __last, size_t __grain,
+		      const _Tp& __identity, _RangeOperation& __op,
+		      _Combine& __combine)
+    {
+      if (size_t(__last - __first) <= __grain)
+	return __op(__first, __last, __identity);
+      const _Index __middle = __first + (__last - __first) / 2;
+      _Tp __right(__identity);
+      _Task_group __group;
+      __group.run(_Reduce_job<_Index, _Tp, _RangeOperation, _Combine>
+		  (__middle, __last, __grain, &__identity, &__op,
+		   &__combine, &__right));
+      _Tp __left(__parallel_reduce(__first, __middle, __grain, __identity,
+				   __op, __combine));
+      __group.wait();
+      return __combine(__left, __right);
+    }
+
+  /**
+   *  @brief  Reduces a range in parallel.
+   *  @param  first  Start of range.
+   *  @param  last  End of range.
+   *  @param  grain  Largest number of indices one task handles.
+   *  @param  identity  Identity element of @p combine.
+   *  @param  op  Function object called as @p op(i, j, identity) to
+   *              reduce the subrange [i, j) sequentially.
+   *  @param  combine  Associative function object joining the results
+   *                   of two adjacent subranges, left one first.
+   *  @return  @p identity if the range is empty, else the combination
+   *           of the results for all subranges, in index order.
+   *
+   *  @a Index is an integral type or a random access iterator.
+   *  @p combine need not be commutative.  Exceptions are reported as
+   *  for parallel_for.
+   */
+  template<typename _Index, typename _Tp, typename _RangeOperation,
+	   typename _Combine>
+    _Tp
+    parallel_reduce(_Index __first, _Index __last, size_t __grain,
+		    const _Tp& __identity, _RangeOperation __op,
+		    _Combine __combine)
+    {
+      if (__first == __last)
+	return __identity;
+      if (_Thread_pool::_S_get()._M_get_num_threads() < 2)
+	__grain = size_t(__last - __first);
+      return __parallel_reduce(__first, __last, __grain ? __grain : 1,
+			       __identity, __op, __combine);
+    }
+
+  /**
+   *  @brief  Reduces a range in parallel.
+   *
+   *  As above, with a grain size chosen from the number of threads.
+   */
+  template<typename _Index, typename _Tp, typename _RangeOperation,
+	   typename _Combine>
+    inline _Tp
+    parallel_reduce(_Index __first, _Index __last, const _Tp& __identity,
+		    _RangeOperation __op, _Combine __combine)
+    {
+      if (__first == __last)
+	return __identity;
+      return parallel_reduce(__first, __last,
+			     __default_grain(size_t(__last - __first)),
+			     __identity, __op, __combine);
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,133 @@
+// Parallel mode settings -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/settings.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  Runtime tunables for the parallel algorithms: the number of threads
+ *  and, per algorithm, the sequential cutoff below which the ordinary
+ *  single-threaded implementation is used unchanged.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_SETTINGS_H
+#define _GLIBCXX_PARALLEL_SETTINGS_H 1
+
+#include <bits/c++config.h>
+#include <cstddef>
+#include <unistd.h>
+
+// Default sequential cutoff, in elements, for every parallel algorithm.
+#ifndef _GLIBCXX_PARALLEL_MINIMAL_N
+# define _GLIBCXX_PARALLEL_MINIMAL_N 1000
+#endif
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  using std::size_t;
+
+  /// Upper bound on the number of chunks a range is split into.
+  enum { _S_max_chunks = 64 };
+
+  enum _Algorithm_strategy
+    {
+      heuristic,	///< Parallel iff the range exceeds the cutoff.
+      force_sequential,	///< Never go parallel.
+      force_parallel	///< Parallel whenever more than one thread exists.
+    };
+
+  /**
+   *  @brief  Runtime settings for the parallel mode.
+   *
+   *  A single, process-wide instance is returned by get().  Changes made
+   *  through set() affect subsequent calls only; num_threads is read
+   *  once, when the thread pool is first used.
+   */
+  struct _Settings
+  {
+    _Algorithm_strategy algorithm_strategy;
+
+    /// Number of threads, including the caller.  Zero means one per
+    /// online processor.
+    unsigned int num_threads;
+
+    /// Minimal input sizes for the parallel versions.
+    size_t sort_minimal_n;
+    size_t stable_sort_minimal_n;
+    size_t nth_element_minimal_n;
+    size_t transform_minimal_n;
+    size_t accumulate_minimal_n;
+    size_t inner_product_minimal_n;
+
+    _Settings()
+    : algorithm_strategy(heuristic), num_threads(0),
+      sort_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N),
+      stable_sort_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N),
+      nth_element_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N),
+      transform_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N),
+      accumulate_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N),
+      inner_product_minimal_n(_GLIBCXX_PARALLEL_MINIMAL_N)
+    { }
+
+    static _Settings&
+    _S_instance()
+    {
+      static _Settings __settings;
+      return __settings;
+    }
+
+    static const _Settings&
+    get()
+    { return _S_instance(); }
+
+    static void
+    set(const _Settings& __s)
+    { _S_instance() = __s; }
+  };
+
+  /// Number of threads the parallel algorithms may use, the caller
+  /// included.
+  inline unsigned int
+  __get_max_threads()
+  {
+    unsigned int __n = _Settings::get().num_threads;
+#ifdef _SC_NPROCESSORS_ONLN
+    if (__n == 0)
+      {
+	const long __cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+	__n = __cpus > 0 ? static_cast<unsigned int>(__cpus) : 1;
+      }
+#endif
+    if (__n == 0)
+      __n = 1;
+    return __n < unsigned(_S_max_chunks) ? __n : unsigned(_S_max_chunks);
+  }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,492 @@
+// Parallel mode thread pool -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/thread_pool.h
+ *  This file is a GNU parallel extension to the Standard C++ Library.
+ *
+ *  A process-wide pool of worker threads built on the gthr layer, and
+ *  the fork/join task groups the parallel algorithms, futures and
+ *  loops of the parallel mode are written in.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_THREAD_POOL_H
+#define _GLIBCXX_PARALLEL_THREAD_POOL_H 1
+
+#include <bits/c++config.h>
+#include <bits/functexcept.h>
+#include <ext/concurrence.h>
+#include <ext/atomic>
+#include <parallel/settings.h>
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+# include <dispatch/dispatch.h>
+#endif
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_parallel)
+
+  class _Task_group;
+
+  // A queued unit of work.  Tasks are heap allocated by their creator
+  // and deleted by whichever thread executes them.  Tasks without a
+  // group report their own completion.
+  struct _Task_base
+  {
+    _Task_base*  _M_prev;
+    _Task_base*  _M_next;
+    _Task_group* _M_group;
+
+    _Task_base() : _M_prev(0), _M_next(0), _M_group(0) { }
+
+    virtual
+    ~_Task_base() { }
+
+    virtual void
+    _M_run() = 0;
+  };
+
+  template<typename _Function>
+    struct _Task : public _Task_base
+    {
+      _Function _M_fn;
+
+      explicit
+      _Task(const _Function& __fn) : _M_fn(__fn) { }
+
+      virtual void
+      _M_run()
+      { _M_fn(); }
+    };
+
+  // Double-ended task queue with its own lock.  The owning thread
+  // pushes and pops at the back, so it runs the task it forked last,
+  // whose data is still in its cache; other threads steal from the
+  // front, where the oldest and usually largest pieces of work are.
+  class _Task_deque
+  {
+    __gnu_cxx::__mutex		_M_mutex;
+    _Task_base*			_M_front;
+    _Task_base*			_M_back;
+    __gnu_cxx::atomic<size_t>	_M_size;
+
+    _Task_deque(const _Task_deque&);
+    _Task_deque& operator=(const _Task_deque&);
+
+  public:
+    _Task_deque()
+    : _M_front(0), _M_back(0), _M_size(0) { }
+
+    void
+    _M_push_back(_Task_base* __task)
+    {
+      __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+      __task->_M_prev = _M_back;
+      __task->_M_next = 0;
+      if (_M_back)
+	_M_back->_M_next = __task;
+      else
+	_M_front = __task;
+      _M_back = __task;
+      _M_size.fetch_add(1, __gnu_cxx::memory_order_relaxed);
+    }
+
+    _Task_base*
+    _M_pop_back()
+    {
+      // Unlocked peek: thieves probe every deque, and most are empty.
+      if (_M_size.load(__gnu_cxx::memory_order_relaxed) == 0)
+	return 0;
+      __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+      _Task_base* __task = _M_back;
+      if (__task)
+	{
+	  _M_back = __task->_M_prev;
+	  if (_M_back)
+	    _M_back->_M_next = 0;
+	  else
+	    _M_front = 0;
+	  _M_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+	}
+      return __task;
+    }
+
+    _Task_base*
+    _M_pop_front()
+    {
+      if (_M_size.load(__gnu_cxx::memory_order_relaxed) == 0)
+	return 0;
+      __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+      _Task_base* __task = _M_front;
+      if (__task)
+	{
+	  _M_front = __task->_M_next;
+	  if (_M_front)
+	    _M_front->_M_prev = 0;
+	  else
+	    _M_back = 0;
+	  _M_size.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+	}
+      return __task;
+    }
+  };
+
+  /**
+   *  @brief  Process-wide pool of worker threads.
+   *
+   *  The pool is created on first use with __get_max_threads() - 1
+   *  workers and lives until the process exits.  Every parallel
+   *  algorithm, future and loop of the parallel mode runs on this one
+   *  pool, so combining them never puts more runnable threads on the
+   *  machine than there are processors.
+   *
+   *  Each worker owns a _Task_deque; tasks forked by threads outside
+   *  the pool go to a shared deque.  An idle worker first drains its
+   *  own deque and then steals from the others.  Threads blocked in
+   *  _Task_group::wait, or on a future, run tasks in the same way, so
+   *  nested fork/join never starves the pool.
+   *
+   *  When _GLIBCXX_PARALLEL_DISPATCH is defined (which requires
+   *  -fblocks), the pool starts no threads of its own and hands every
+   *  task to the default-priority concurrent queue of libdispatch
+   *  instead, sharing the machine with the rest of the process through
+   *  the system's thread pool.
+   */
+  class _Thread_pool
+  {
+#ifdef __GTHREADS_CXX0X
+    __gnu_cxx::__mutex		_M_mutex;
+    __gnu_cxx::__cond		_M_cond;
+    __gthread_key_t		_M_key;
+#endif
+    // _M_deques[0] is shared by the threads outside the pool,
+    // _M_deques[__i] is owned by worker __i.
+    _Task_deque*		_M_deques;
+    size_t			_M_num_deques;
+    unsigned int		_M_workers;
+    __gnu_cxx::atomic<size_t>	_M_started;
+    // Tasks pushed but not yet popped, and threads sleeping on _M_cond.
+    // A thread increments one counter and then reads the other, so a
+    // pusher and a thread going to sleep cannot miss each other.
+    __gnu_cxx::atomic<size_t>	_M_queued;
+    __gnu_cxx::atomic<size_t>	_M_sleepers;
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+    dispatch_queue_t		_M_queue;
+#endif
+
+    friend class _Task_group;
+
+    _Thread_pool(const _Thread_pool&);
+    _Thread_pool& operator=(const _Thread_pool&);
+
+    explicit
+    _Thread_pool(unsigned int __workers)
+    : _M_deques(0), _M_num_deques(0), _M_workers(0), _M_started(0),
+      _M_queued(0), _M_sleepers(0)
+    {
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+      _M_queue = dispatch_get_concurrent_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT);
+#elif defined(__GTHREADS_CXX0X)
+      if (__gthread_active_p() && __workers != 0
+	  && __gthread_key_create(&_M_key, 0) == 0)
+	{
+	  _M_deques = new _Task_deque[__workers + 1];
+	  _M_num_deques = __workers + 1;
+	  for (; _M_workers < __workers; ++_M_workers)
+	    {
+	      __gthread_t __id;
+	      if (__gthread_create(&__id, &_S_worker, this) != 0)
+		break;
+	      __gthread_detach(__id);
+	    }
+	}
+#endif
+    }
+
+    // True if tasks are run asynchronously, false if _Task_group::run
+    // has to call them in place.
+    bool
+    _M_is_async() const
+    {
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+      return true;
+#else
+      return _M_workers != 0;
+#endif
+    }
+
+    // Index of the deque the calling thread pushes to.
+    size_t
+    _M_self() const
+    {
+#if defined(__GTHREADS_CXX0X) && !defined(_GLIBCXX_PARALLEL_DISPATCH)
+      if (_M_num_deques != 0)
+	return reinterpret_cast<size_t>(__gthread_getspecific(_M_key));
+#endif
+      return 0;
+    }
+
+    void
+    _M_submit(_Task_base* __task)
+    {
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+      dispatch_async_f(_M_queue, __task, &_S_dispatch);
+#else
+      _M_queued.fetch_add(1);
+      _M_deques[_M_self()]._M_push_back(__task);
+# ifdef __GTHREADS_CXX0X
+      if (_M_sleepers.load() != 0)
+	{
+	  __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+	  _M_cond.signal();
+	}
+# endif
+#endif
+    }
+
+    // Pops a task from the deque of __self, or steals one from another
+    // deque.  Returns 0 if no task could be found.
+    _Task_base*
+    _M_take(size_t __self)
+    {
+      if (_M_num_deques == 0)
+	return 0;
+      _Task_base* __task = _M_deques[__self]._M_pop_back();
+      for (size_t __i = 1; !__task && __i < _M_num_deques; ++__i)
+	__task = _M_deques[(__self + __i) % _M_num_deques]._M_pop_front();
+      if (__task)
+	_M_queued.fetch_sub(1, __gnu_cxx::memory_order_relaxed);
+      return __task;
+    }
+
+    // Runs __task and reports completion to its group.
+    inline void
+    _M_execute(_Task_base* __task);
+
+#ifdef __GTHREADS_CXX0X
+    struct _Never
+    {
+      bool
+      operator()() const
+      { return false; }
+    };
+
+    static void*
+    _S_worker(void* __arg)
+    {
+      _Thread_pool* __pool = static_cast<_Thread_pool*>(__arg);
+      size_t __self = __pool->_M_started.fetch_add(1) + 1;
+      __gthread_setspecific(__pool->_M_key,
+			    reinterpret_cast<void*>(__self));
+      __pool->_M_run_until(_Never(), __self);
+      return 0;
+    }
+#endif
+
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+    static void
+    _S_dispatch(void* __arg)
+    { _S_get()._M_execute(static_cast<_Task_base*>(__arg)); }
+#endif
+
+  public:
+    static _Thread_pool&
+    _S_get()
+    {
+      static _Thread_pool* __pool
+	= new _Thread_pool(__get_max_threads() - 1);
+      return *__pool;
+    }
+
+    /// Number of threads that can run tasks, the caller included.
+    unsigned int
+    _M_get_num_threads() const
+    {
+#ifdef _GLIBCXX_PARALLEL_DISPATCH
+      return __get_max_threads();
+#else
+      return _M_workers + 1;
+#endif
+    }
+
+    /**
+     *  Runs queued tasks until __done() returns true, sleeping while
+     *  there are none.  Whoever makes __done() true must call
+     *  _M_notify() afterwards.
+     */
+    template<typename _Predicate>
+      void
+      _M_run_until(const _Predicate& __done, size_t __self)
+      {
+	while (!__done())
+	  {
+	    if (_Task_base* __task = _M_take(__self))
+	      {
+		_M_execute(__task);
+		continue;
+	      }
+#ifdef __GTHREADS_CXX0X
+	    __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+	    _M_sleepers.fetch_add(1);
+	    while (_M_queued.load() == 0 && !__done())
+	      _M_cond.wait(&_M_mutex);
+	    _M_sleepers.fetch_sub(1);
+#endif
+	  }
+      }
+
+    template<typename _Predicate>
+      void
+      _M_run_until(const _Predicate& __done)
+      { _M_run_until(__done, _M_self()); }
+
+    /// Wakes the threads sleeping in _M_run_until after the condition
+    /// one of them waits for has been made true.
+    void
+    _M_notify()
+    {
+#ifdef __GTHREADS_CXX0X
+      if (_M_sleepers.load() != 0)
+	{
+	  __gnu_cxx::__scoped_lock __sentry(_M_mutex);
+	  _M_cond.broadcast();
+	}
+#endif
+    }
+
+    /// Queues __task, which must not belong to a group, or runs it in
+    /// place when the pool has no threads.  The task must not throw.
+    void
+    _M_spawn(_Task_base* __task)
+    {
+      if (_M_is_async())
+	_M_submit(__task);
+      else
+	_M_execute(__task);
+    }
+  };
+
+  /**
+   *  @brief  Fork/join scope.
+   *
+   *  run() hands a copy of a nullary function object to the pool;
+   *  wait() blocks until every task started through this group has
+   *  finished, executing queued tasks in the meantime.  If a task exits
+   *  with an exception, wait() throws std::runtime_error once all the
+   *  others have completed.  When the pool has no workers, run()
+   *  executes the function immediately.
+   */
+  class _Task_group
+  {
+    _Thread_pool&		_M_pool;
+    __gnu_cxx::atomic<size_t>	_M_pending;
+    __gnu_cxx::atomic<bool>	_M_failed;
+
+    friend class _Thread_pool;
+
+    _Task_group(const _Task_group&);
+    _Task_group& operator=(const _Task_group&);
+
+    struct _Done
+    {
+      const _Task_group* _M_group;
+
+      bool
+      operator()() const
+      { return _M_group->_M_pending.load() == 0; }
+    };
+
+    void
+    _M_join()
+    {
+      if (_M_pending.load() != 0)
+	{
+	  _Done __done = { this };
+	  _M_pool._M_run_until(__done);
+	}
+    }
+
+  public:
+    _Task_group()
+    : _M_pool(_Thread_pool::_S_get()), _M_pending(0), _M_failed(false) { }
+
+    ~_Task_group()
+    { _M_join(); }
+
+    template<typename _Function>
+      void
+      run(const _Function& __fn)
+      {
+	if (_M_pool._M_is_async())
+	  {
+	    _Task_base* __task = new _Task<_Function>(__fn);
+	    __task->_M_group = this;
+	    _M_pending.fetch_add(1, __gnu_cxx::memory_order_relaxed);
+	    _M_pool._M_submit(__task);
+	    return;
+	  }
+	_Function __tmp(__fn);
+	__tmp();
+      }
+
+    void
+    wait()
+    {
+      _M_join();
+      if (_M_failed.load(__gnu_cxx::memory_order_relaxed))
+	{
+	  _M_failed.store(false, __gnu_cxx::memory_order_relaxed);
+	  std::__throw_runtime_error(__N("__gnu_parallel::_Task_group::wait "
+					 "task exited with an exception"));
+	}
+    }
+  };
+
+  inline void
+  _Thread_pool::
+  _M_execute(_Task_base* __task)
+  {
+    _Task_group* __group = __task->_M_group;
+    bool __failed = false;
+    try
+      { __task->_M_run(); }
+    catch(...)
+      { __failed = true; }
+    delete __task;
+
+    if (__group)
+      {
+	if (__failed)
+	  __group->_M_failed.store(true, __gnu_cxx::memory_order_relaxed);
+	// The group may be destroyed as soon as _M_pending drops to zero.
+	if (__group->_M_pending.fetch_sub(1) == 1)
+	  _M_notify();
+      }
+  }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
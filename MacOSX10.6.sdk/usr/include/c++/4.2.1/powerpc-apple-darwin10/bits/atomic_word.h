@@ -39,4 +39,36 @@ typedef int _Atomic_word;
 #define _GLIBCXX_WRITE_MEM_BARRIER __asm __volatile ("lwsync":::"memory")
 #endif
 
+// Barriers for the explicit memory orders of <ext/atomic>.  Sequentially
+// consistent loads are preceded by a full sync, so that a store
+// followed by sync on one processor and a load on another agree.
+#ifdef __NO_LWSYNC__
+#define _GLIBCXX_ACQUIRE_BARRIER __asm __volatile ("sync":::"memory")
+#define _GLIBCXX_RELEASE_BARRIER __asm __volatile ("sync":::"memory")
+#else
+#define _GLIBCXX_ACQUIRE_BARRIER __asm __volatile ("lwsync":::"memory")
+#define _GLIBCXX_RELEASE_BARRIER __asm __volatile ("lwsync":::"memory")
+#endif
+#define _GLIBCXX_FULL_BARRIER __asm __volatile ("sync":::"memory")
+#define _GLIBCXX_SEQ_CST_LOAD_BARRIER __asm __volatile ("sync":::"memory")
+
+// Body of a spin-wait loop: drop the hardware thread priority while
+// spinning, then restore it.
+#define _GLIBCXX_CPU_RELAX __asm __volatile ("or 1,1,1\n\tor 2,2,2":::"memory")
+
+// Widest plain load and store that is single-copy atomic, and widest
+// lock-free read-modify-write.
+#ifdef __ppc64__
+# define _GLIBCXX_ATOMIC_ACCESS_MAX 8
+# define _GLIBCXX_ATOMIC_RMW_MAX 8
+#else
+# define _GLIBCXX_ATOMIC_ACCESS_MAX 4
+# define _GLIBCXX_ATOMIC_RMW_MAX 4
+#endif
+
+// The __sync builtins bracket every operation with sync and isync.
+// For the weaker orders the non-barrier OSAtomic functions plus an
+// lwsync where needed are considerably cheaper.
+#define _GLIBCXX_ATOMIC_USE_OSATOMIC 1
+
 #endif 
@@ -60,6 +60,11 @@
 # define _GLIBCXX_NAMESPACE_ASSOCIATION_DEBUG 1
 #endif
 
+// Selects the non-reference-counted, small-string std::basic_string.
+#ifdef _GLIBCXX_SSO_STRING
+# define _GLIBCXX_NAMESPACE_ASSOCIATION_SSO 1
+#endif
+
 # define _GLIBCXX_NAMESPACE_ASSOCIATION_VERSION 0 
 
 // Macros for namespace scope.
@@ -160,6 +165,18 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 #endif
 _GLIBCXX_END_NAMESPACE
 
+// Namespace association for the small-string mode.  std::basic_string
+// is declared in std::__sso, so that every symbol mentioning it is
+// mangled apart from the reference counted string of the library
+// binary.
+#if _GLIBCXX_NAMESPACE_ASSOCIATION_SSO
+namespace std
+{
+  namespace __sso { }
+  using namespace __sso __attribute__ ((strong));
+}
+#endif
+
 
 // Allow use of "export template." This is currently not a feature
 // that g++ supports.
@@ -171,6 +188,12 @@ _GLIBCXX_END_NAMESPACE
 // library to avoid multiple weak definitions for required types that
 // are already explicitly instantiated in the library binary. This
 // substantially reduces the binary size of resulting executables.
+// The library binary only instantiates the reference counted string,
+// so in the small-string mode everything is instantiated implicitly.
+#if _GLIBCXX_NAMESPACE_ASSOCIATION_SSO && !defined _GLIBCXX_EXTERN_TEMPLATE
+# define _GLIBCXX_EXTERN_TEMPLATE 0
+#endif
+
 #ifndef _GLIBCXX_EXTERN_TEMPLATE
 # define _GLIBCXX_EXTERN_TEMPLATE 1
 #endif
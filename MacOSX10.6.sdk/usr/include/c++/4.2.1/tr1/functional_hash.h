@@ -142,6 +142,13 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
       std::size_t
       operator()(const std::string& __s) const
       { return _Fnv_hash<>::hash(__s.data(), __s.length()); }
+
+      // Hashes a C string as the std::string holding it would be, for
+      // the heterogeneous lookups of the unordered containers without
+      // a temporary string.  Extension, not found in TR1.
+      std::size_t
+      operator()(const char* __s) const
+      { return _Fnv_hash<>::hash(__s, std::char_traits<char>::length(__s)); }
     };
 
 #ifdef _GLIBCXX_USE_WCHAR_T
@@ -343,8 +343,20 @@ namespace __detail
       ++_M_cur_bucket;
 
       // This loop requires the bucket array to have a non-null sentinel.
-      while (!*_M_cur_bucket)
-	++_M_cur_bucket;
+      // During an incremental rehash the sentinel of the old bucket
+      // array is instead the address of the new array with its low bit
+      // set, and iteration continues there.
+      for (;;)
+	{
+	  while (!*_M_cur_bucket)
+	    ++_M_cur_bucket;
+	  const std::size_t __link
+	    = reinterpret_cast<std::size_t>(*_M_cur_bucket);
+	  if (!(__link & 1))
+	    break;
+	  _M_cur_bucket
+	    = reinterpret_cast<_Hash_node<_Value, __cache>**>(__link - 1);
+	}
       _M_cur_node = *_M_cur_bucket;
     }
 
@@ -598,6 +610,30 @@ namespace __detail
       return std::make_pair(false, 0);
   }
 
+  // Rehash policy identical to _Prime_rehash_policy, which in addition
+  // asks _Hashtable to carve its nodes out of slabs (see _Node_pool
+  // below) instead of allocating each node separately.  Nodes freed by
+  // erase are recycled through a free list; the slabs themselves are
+  // only returned to the allocator when the table is destroyed.
+  struct _Pooled_prime_rehash_policy : public _Prime_rehash_policy
+  {
+    _Pooled_prime_rehash_policy(float __z = 1.0)
+    : _Prime_rehash_policy(__z) { }
+  };
+
+  // Rehash policy choosing the same bucket counts as _Prime_rehash_policy,
+  // but asking _Hashtable to grow incrementally: the new bucket array is
+  // allocated when the load factor is exceeded, and the nodes are then
+  // migrated a few buckets at a time by each subsequent insertion (see
+  // _Rehash_state below), bounding the work done by any single insert.
+  // Lookups consult whichever array currently holds the key's bucket.
+  // Explicit calls to rehash still rehash all at once.
+  struct _Incremental_prime_rehash_policy : public _Prime_rehash_policy
+  {
+    _Incremental_prime_rehash_policy(float __z = 1.0)
+    : _Prime_rehash_policy(__z) { }
+  };
+
   // Base classes for std::tr1::_Hashtable.  We define these base
   // classes because in some cases we want to do different things
   // depending on the value of a policy class.  In some cases the
@@ -639,14 +675,13 @@ namespace __detail
     {
       _Hashtable* __h = static_cast<_Hashtable*>(this);
       typename _Hashtable::_Hash_code_type __code = __h->_M_hash_code(__k);
-      std::size_t __n = __h->_M_bucket_index(__k, __code,
-					     __h->_M_bucket_count);
+      typename _Hashtable::_Node** __head = __h->_M_bucket_head(__k, __code);
 
       typename _Hashtable::_Node* __p =
-	__h->_M_find_node(__h->_M_buckets[__n], __k, __code);
+	__h->_M_find_node(*__head, __k, __code);
       if (!__p)
 	return __h->_M_insert_bucket(std::make_pair(__k, mapped_type()),
-				     __n, __code)->second;
+				     __head, __code)->second;
       return (__p->_M_v).second;
     }
 
@@ -673,6 +708,404 @@ namespace __detail
       }
     };
 
+  template<typename _Hashtable>
+    struct _Rehash_base<_Pooled_prime_rehash_policy, _Hashtable>
+    {
+      float
+      max_load_factor() const
+      {
+	const _Hashtable* __this = static_cast<const _Hashtable*>(this);
+	return __this->__rehash_policy().max_load_factor();
+      }
+
+      void
+      max_load_factor(float __z)
+      {
+	_Hashtable* __this = static_cast<_Hashtable*>(this);
+	__this->__rehash_policy(_Pooled_prime_rehash_policy(__z));
+      }
+    };
+
+  template<typename _Hashtable>
+    struct _Rehash_base<_Incremental_prime_rehash_policy, _Hashtable>
+    {
+      float
+      max_load_factor() const
+      {
+	const _Hashtable* __this = static_cast<const _Hashtable*>(this);
+	return __this->__rehash_policy().max_load_factor();
+      }
+
+      void
+      max_load_factor(float __z)
+      {
+	_Hashtable* __this = static_cast<_Hashtable*>(this);
+	__this->__rehash_policy(_Incremental_prime_rehash_policy(__z));
+      }
+    };
+
+  // class template _Rehash_state.  Holds the progress of an incremental
+  // rehash: the previous bucket array and the index of its first bucket
+  // not migrated yet.  The primary template never has a rehash in
+  // progress; all its members are constant, so that the corresponding
+  // code in _Hashtable folds away.
+  template<typename _RehashPolicy, typename _Node>
+    struct _Rehash_state
+    {
+      static bool
+      _S_incremental()
+      { return false; }
+
+      static std::size_t
+      _S_buckets_per_step()
+      { return 0; }
+
+      bool
+      _M_migrating() const
+      { return false; }
+
+      _Node**
+      _M_old_buckets() const
+      { return 0; }
+
+      std::size_t
+      _M_old_bucket_count() const
+      { return 0; }
+
+      std::size_t
+      _M_next_old() const
+      { return 0; }
+
+      void
+      _M_set_old(_Node**, std::size_t) { }
+
+      void
+      _M_set_next_old(std::size_t) { }
+
+      void
+      _M_swap_state(_Rehash_state&) { }
+    };
+
+  template<typename _Node>
+    struct _Rehash_state<_Incremental_prime_rehash_policy, _Node>
+    {
+      // Number of old buckets migrated by each insertion.  With the
+      // default growth factor this completes a migration long before
+      // the next one is due; if it does not, the next growth finishes
+      // it first.
+      static std::size_t
+      _S_buckets_per_step()
+      { return 8; }
+
+      _Rehash_state()
+      : _M_old(0), _M_old_count(0), _M_next(0) { }
+
+      // A copy is always built fully rehashed.
+      _Rehash_state(const _Rehash_state&)
+      : _M_old(0), _M_old_count(0), _M_next(0) { }
+
+      static bool
+      _S_incremental()
+      { return true; }
+
+      bool
+      _M_migrating() const
+      { return _M_old != 0; }
+
+      _Node**
+      _M_old_buckets() const
+      { return _M_old; }
+
+      std::size_t
+      _M_old_bucket_count() const
+      { return _M_old_count; }
+
+      std::size_t
+      _M_next_old() const
+      { return _M_next; }
+
+      void
+      _M_set_old(_Node** __b, std::size_t __n)
+      {
+	_M_old = __b;
+	_M_old_count = __n;
+	_M_next = 0;
+      }
+
+      void
+      _M_set_next_old(std::size_t __i)
+      { _M_next = __i; }
+
+      void
+      _M_swap_state(_Rehash_state& __x)
+      {
+	std::swap(_M_old, __x._M_old);
+	std::swap(_M_old_count, __x._M_old_count);
+	std::swap(_M_next, __x._M_next);
+      }
+
+    private:
+      _Rehash_state&
+      operator=(const _Rehash_state&);
+
+      _Node**      _M_old;
+      std::size_t  _M_old_count;
+      std::size_t  _M_next;
+    };
+
+  // Const local iterator of a table that may be in the middle of an
+  // incremental rehash.  Bucket n then holds the nodes of bucket n of
+  // the new array followed by those nodes of the unmigrated old buckets
+  // whose hash codes map to n, so the const bucket interface can visit
+  // them without migrating (which would write to a table that other
+  // threads may be reading).  Requires cached hash codes.  With prime
+  // bucket counts any old bucket may feed bucket n, so _M_settle
+  // filters all of the remaining ones: begin(n) and bucket_size(n) are
+  // linear in the old table while a migration is in progress.
+  template<typename _Value, bool __constant_iterators, bool __cache,
+	   typename _H2>
+    struct _Migrating_node_const_iterator
+    : public _Node_iterator_base<_Value, __cache>
+    {
+      typedef _Value                                   value_type;
+      typedef const _Value*                            pointer;
+      typedef const _Value&                            reference;
+      typedef std::ptrdiff_t                           difference_type;
+      typedef std::forward_iterator_tag                iterator_category;
+
+      _Migrating_node_const_iterator()
+      : _Node_iterator_base<_Value, __cache>(0), _M_old(0), _M_old_end(0),
+	_M_bucket(0), _M_bucket_count(0), _M_in_old(false) { }
+
+      explicit
+      _Migrating_node_const_iterator(_Hash_node<_Value, __cache>* __p)
+      : _Node_iterator_base<_Value, __cache>(__p), _M_old(0), _M_old_end(0),
+	_M_bucket(0), _M_bucket_count(0), _M_in_old(false) { }
+
+      _Migrating_node_const_iterator(_Hash_node<_Value, __cache>* __p,
+				     _Hash_node<_Value, __cache>** __old,
+				     _Hash_node<_Value, __cache>** __old_end,
+				     std::size_t __n, std::size_t __count)
+      : _Node_iterator_base<_Value, __cache>(__p), _M_old(__old),
+	_M_old_end(__old_end), _M_bucket(__n), _M_bucket_count(__count),
+	_M_in_old(false)
+      { _M_settle(); }
+
+      _Migrating_node_const_iterator(const _Node_iterator<_Value,
+				     __constant_iterators, __cache>& __x)
+      : _Node_iterator_base<_Value, __cache>(__x._M_cur), _M_old(0),
+	_M_old_end(0), _M_bucket(0), _M_bucket_count(0), _M_in_old(false) { }
+
+      reference
+      operator*() const
+      { return this->_M_cur->_M_v; }
+  
+      pointer
+      operator->() const
+      { return &this->_M_cur->_M_v; }
+
+      _Migrating_node_const_iterator&
+      operator++()
+      { 
+	this->_M_incr();
+	_M_settle();
+	return *this; 
+      }
+  
+      _Migrating_node_const_iterator
+      operator++(int)
+      { 
+	_Migrating_node_const_iterator __tmp(*this);
+	this->_M_incr();
+	_M_settle();
+	return __tmp;
+      }
+
+    private:
+      // Moves to the first node from the current one on, in the new
+      // chain or in the remaining old buckets, that belongs to the bucket.
+      void
+      _M_settle()
+      {
+	for (;;)
+	  {
+	    if (_M_in_old)
+	      while (this->_M_cur
+		     && _H2()(this->_M_cur->_M_hash_code, _M_bucket_count)
+		        != _M_bucket)
+		this->_M_cur = this->_M_cur->_M_next;
+	    if (this->_M_cur || _M_old == _M_old_end)
+	      return;
+	    this->_M_cur = *_M_old++;
+	    _M_in_old = true;
+	  }
+      }
+
+      _Hash_node<_Value, __cache>**  _M_old;
+      _Hash_node<_Value, __cache>**  _M_old_end;
+      std::size_t                    _M_bucket;
+      std::size_t                    _M_bucket_count;
+      bool                           _M_in_old;
+    };
+
+  // class template _Const_local_iterator_select.  Chooses the const
+  // local iterator type of _Hashtable and builds the iterator for the
+  // start of bucket n.  Only tables that rehash incrementally need to
+  // look at an old bucket array.
+  template<typename _RehashPolicy, typename _Value,
+	   bool __constant_iterators, bool __cache, typename _H2>
+    struct _Const_local_iterator_select
+    {
+      typedef _Node_const_iterator<_Value, __constant_iterators, __cache>
+                                                       _Type;
+
+      static _Type
+      _S_begin(_Hash_node<_Value, __cache>* __p,
+	       _Hash_node<_Value, __cache>**, _Hash_node<_Value, __cache>**,
+	       std::size_t, std::size_t)
+      { return _Type(__p); }
+    };
+
+  template<typename _Value, bool __constant_iterators, bool __cache,
+	   typename _H2>
+    struct _Const_local_iterator_select<_Incremental_prime_rehash_policy,
+					_Value, __constant_iterators,
+					__cache, _H2>
+    {
+      typedef _Migrating_node_const_iterator<_Value, __constant_iterators,
+					     __cache, _H2>
+                                                       _Type;
+
+      static _Type
+      _S_begin(_Hash_node<_Value, __cache>* __p,
+	       _Hash_node<_Value, __cache>** __old,
+	       _Hash_node<_Value, __cache>** __old_end,
+	       std::size_t __n, std::size_t __count)
+      { return _Type(__p, __old, __old_end, __n, __count); }
+    };
+
+  // class template _Node_pool.  Obtains and releases the storage for
+  // the nodes of a hashtable.  The primary template simply forwards
+  // to the node allocator, one node at a time.
+  template<typename _RehashPolicy, typename _Node, typename _NodeAlloc>
+    struct _Node_pool
+    {
+      _Node*
+      _M_get_node(_NodeAlloc& __a)
+      { return __a.allocate(1); }
+
+      void
+      _M_put_node(_NodeAlloc& __a, _Node* __p)
+      { __a.deallocate(__p, 1); }
+
+      void
+      _M_release_nodes(_NodeAlloc&) { }
+
+      void
+      _M_swap_nodes(_Node_pool&) { }
+    };
+
+  // Specialization for _Pooled_prime_rehash_policy: nodes are handed
+  // out from slabs of geometrically increasing size.  The first slot
+  // of each slab holds the slab header, threading all the slabs on a
+  // singly linked list.  Freed nodes go on a free list linked through
+  // their _M_next member.  A pool is never shared: copying a table
+  // gives the copy a fresh, empty pool.
+  template<typename _Node, typename _NodeAlloc>
+    struct _Node_pool<_Pooled_prime_rehash_policy, _Node, _NodeAlloc>
+    {
+      enum
+	{
+	  _S_min_slab = 16,
+	  _S_max_slab = 4096
+	};
+
+      struct _Slab
+      {
+	_Slab*       _M_next;
+	std::size_t  _M_size;
+      };
+
+      _Node_pool()
+      : _M_slabs(0), _M_free(0), _M_cur(0), _M_end(0),
+	_M_next_size(_S_min_slab) { }
+
+      _Node_pool(const _Node_pool&)
+      : _M_slabs(0), _M_free(0), _M_cur(0), _M_end(0),
+	_M_next_size(_S_min_slab) { }
+
+      _Node*
+      _M_get_node(_NodeAlloc& __a)
+      {
+	if (_M_free)
+	  {
+	    _Node* __p = _M_free;
+	    _M_free = __p->_M_next;
+	    return __p;
+	  }
+	if (_M_cur == _M_end)
+	  _M_new_slab(__a);
+	return _M_cur++;
+      }
+
+      void
+      _M_put_node(_NodeAlloc&, _Node* __p)
+      {
+	__p->_M_next = _M_free;
+	_M_free = __p;
+      }
+
+      void
+      _M_release_nodes(_NodeAlloc& __a)
+      {
+	while (_M_slabs)
+	  {
+	    _Slab* __s = _M_slabs;
+	    _M_slabs = __s->_M_next;
+	    __a.deallocate(reinterpret_cast<_Node*>(__s), __s->_M_size);
+	  }
+	_M_free = _M_cur = _M_end = 0;
+	_M_next_size = _S_min_slab;
+      }
+
+      void
+      _M_swap_nodes(_Node_pool& __x)
+      {
+	std::swap(_M_slabs, __x._M_slabs);
+	std::swap(_M_free, __x._M_free);
+	std::swap(_M_cur, __x._M_cur);
+	std::swap(_M_end, __x._M_end);
+	std::swap(_M_next_size, __x._M_next_size);
+      }
+
+    private:
+      _Node_pool&
+      operator=(const _Node_pool&);
+
+      void
+      _M_new_slab(_NodeAlloc& __a)
+      {
+	// A node always holds at least two pointer-sized words, so one
+	// slot is enough for the header.
+	const std::size_t __n = _M_next_size;
+	_Node* __p = __a.allocate(__n);
+	_Slab* __s = reinterpret_cast<_Slab*>(__p);
+	__s->_M_next = _M_slabs;
+	__s->_M_size = __n;
+	_M_slabs = __s;
+	_M_cur = __p + 1;
+	_M_end = __p + __n;
+	if (_M_next_size < std::size_t(_S_max_slab))
+	  _M_next_size *= 2;
+      }
+
+      _Slab*       _M_slabs;
+      _Node*       _M_free;
+      _Node*       _M_cur;
+      _Node*       _M_end;
+      std::size_t  _M_next_size;
+    };
+
   // Class template _Hash_code_base.  Encapsulates two policy issues that
   // aren't quite orthogonal.
   //   (1) the difference between using a ranged hash function and using
@@ -799,11 +1232,22 @@ namespace __detail
 		      std::size_t __n) const
       { return _M_h2(_M_h1(_M_extract(__p->_M_v)), __n); }
 
+      std::size_t
+      _M_code_bucket_index(_Hash_code_type __c, std::size_t __n) const
+      { return _M_h2(__c, __n); }
+
       bool
       _M_compare(const _Key& __k, _Hash_code_type,
 		 _Hash_node<_Value, false>* __n) const
       { return _M_eq(__k, _M_extract(__n->_M_v)); }
 
+      template<typename _Kt, typename _KtEqual>
+        bool
+        _M_compare_as(const _Kt& __k, _Hash_code_type,
+		      _Hash_node<_Value, false>* __n,
+		      const _KtEqual& __eq) const
+        { return __eq(__k, _M_extract(__n->_M_v)); }
+
       void
       _M_store_code(_Hash_node<_Value, false>*, _Hash_code_type) const
       { }
@@ -866,11 +1310,25 @@ namespace __detail
 		      std::size_t __n) const
       { return _M_h2(__p->_M_hash_code, __n); }
 
+      std::size_t
+      _M_code_bucket_index(_Hash_code_type __c, std::size_t __n) const
+      { return _M_h2(__c, __n); }
+
       bool
       _M_compare(const _Key& __k, _Hash_code_type __c,
 		 _Hash_node<_Value, true>* __n) const
       { return __c == __n->_M_hash_code && _M_eq(__k, _M_extract(__n->_M_v)); }
 
+      template<typename _Kt, typename _KtEqual>
+        bool
+        _M_compare_as(const _Kt& __k, _Hash_code_type __c,
+		      _Hash_node<_Value, true>* __n,
+		      const _KtEqual& __eq) const
+        {
+	  return (__c == __n->_M_hash_code
+		  && __eq(__k, _M_extract(__n->_M_v)));
+	}
+
       void
       _M_store_code(_Hash_node<_Value, true>* __n, _Hash_code_type __c) const
       { __n->_M_hash_code = __c; }
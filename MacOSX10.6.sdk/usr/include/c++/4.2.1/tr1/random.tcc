@@ -218,52 +218,55 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
   template<class _UIntType, int __w, int __n, int __m, int __r,
 	   _UIntType __a, int __u, int __s,
 	   _UIntType __b, int __t, _UIntType __c, int __l>
-    typename
-    mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
-		     __b, __t, __c, __l>::result_type
+    void
     mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
 		     __b, __t, __c, __l>::
-    operator()()
+    _M_gen_rand()
     {
-      // Reload the vector - cost is O(n) amortized over n calls.
-      if (_M_p >= state_size)
-	{
-	  const _UIntType __upper_mask = (~_UIntType()) << __r;
-	  const _UIntType __lower_mask = ~__upper_mask;
-
-	  for (int __k = 0; __k < (__n - __m); ++__k)
-	    {
-	      _UIntType __y = ((_M_x[__k] & __upper_mask)
-			       | (_M_x[__k + 1] & __lower_mask));
-	      _M_x[__k] = (_M_x[__k + __m] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	    }
+      const _UIntType __upper_mask = (~_UIntType()) << __r;
+      const _UIntType __lower_mask = ~__upper_mask;
 
-	  for (int __k = (__n - __m); __k < (__n - 1); ++__k)
-	    {
-	      _UIntType __y = ((_M_x[__k] & __upper_mask)
-			       | (_M_x[__k + 1] & __lower_mask));
-	      _M_x[__k] = (_M_x[__k + (__m - __n)] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	    }
-
-	  _UIntType __y = ((_M_x[__n - 1] & __upper_mask)
-			   | (_M_x[0] & __lower_mask));
-	  _M_x[__n - 1] = (_M_x[__m - 1] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	  _M_p = 0;
+      for (int __k = 0; __k < (__n - __m); ++__k)
+	{
+	  _UIntType __y = ((_M_x[__k] & __upper_mask)
+			   | (_M_x[__k + 1] & __lower_mask));
+	  _M_x[__k] = (_M_x[__k + __m] ^ (__y >> 1)
+		       ^ ((__y & 0x01) ? __a : 0));
 	}
 
-      // Calculate o(x(i)).
-      result_type __z = _M_x[_M_p++];
-      __z ^= (__z >> __u);
-      __z ^= (__z << __s) & __b;
-      __z ^= (__z << __t) & __c;
-      __z ^= (__z >> __l);
+      for (int __k = (__n - __m); __k < (__n - 1); ++__k)
+	{
+	  _UIntType __y = ((_M_x[__k] & __upper_mask)
+			   | (_M_x[__k + 1] & __lower_mask));
+	  _M_x[__k] = (_M_x[__k + (__m - __n)] ^ (__y >> 1)
+		       ^ ((__y & 0x01) ? __a : 0));
+	}
 
-      return __z;
+      _UIntType __y = ((_M_x[__n - 1] & __upper_mask)
+		       | (_M_x[0] & __lower_mask));
+      _M_x[__n - 1] = (_M_x[__m - 1] ^ (__y >> 1)
+		       ^ ((__y & 0x01) ? __a : 0));
+      _M_p = 0;
     }
 
+  template<class _UIntType, int __w, int __n, int __m, int __r,
+	   _UIntType __a, int __u, int __s,
+	   _UIntType __b, int __t, _UIntType __c, int __l>
+    template<typename _ForwardIterator>
+      void
+      mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
+		       __b, __t, __c, __l>::
+      __generate(_ForwardIterator __first, _ForwardIterator __last)
+      {
+	while (__first != __last)
+	  {
+	    if (_M_p >= state_size)
+	      _M_gen_rand();
+	    for (; _M_p < state_size && __first != __last; ++__first)
+	      *__first = _M_temper(_M_x[_M_p++]);
+	  }
+      }
+
   template<class _UIntType, int __w, int __n, int __m, int __r,
 	   _UIntType __a, int __u, int __s, _UIntType __b, int __t,
 	   _UIntType __c, int __l,
@@ -1387,6 +1390,44 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	return __ret;
       }
 
+  template<typename _RealType>
+    template<typename _ForwardIterator, class _UniformRandomNumberGenerator>
+      void
+      normal_distribution<_RealType>::
+      __generate(_ForwardIterator __first, _ForwardIterator __last,
+		 _UniformRandomNumberGenerator& __urng)
+      {
+	if (__first != __last && _M_saved_available)
+	  {
+	    _M_saved_available = false;
+	    *__first = _M_saved * _M_sigma + _M_mean;
+	    ++__first;
+	  }
+
+	while (__first != __last)
+	  {
+	    result_type __x, __y, __r2;
+	    do
+	      {
+		__x = result_type(2.0) * __urng() - 1.0;
+		__y = result_type(2.0) * __urng() - 1.0;
+		__r2 = __x * __x + __y * __y;
+	      }
+	    while (__r2 > 1.0 || __r2 == 0.0);
+
+	    const result_type __mult = std::sqrt(-2 * std::log(__r2) / __r2);
+	    *__first = __y * __mult * _M_sigma + _M_mean;
+	    if (++__first == __last)
+	      {
+		_M_saved = __x * __mult;
+		_M_saved_available = true;
+		break;
+	      }
+	    *__first = __x * __mult * _M_sigma + _M_mean;
+	    ++__first;
+	  }
+      }
+
   template<typename _RealType, typename _CharT, typename _Traits>
     std::basic_ostream<_CharT, _Traits>&
     operator<<(std::basic_ostream<_CharT, _Traits>& __os,
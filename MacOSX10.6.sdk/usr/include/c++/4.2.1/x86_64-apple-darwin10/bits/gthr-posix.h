@@ -35,6 +35,10 @@ Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
 
 #define __GTHREADS 1
 
+/* The C++ thread creation, join and condition variable wrappers below
+   are available.  */
+#define __GTHREADS_CXX0X 1
+
 /* Some implementations of <pthread.h> require this to be defined.  */
 #if !defined(_REENTRANT) && defined(__osf__)
 #define _REENTRANT 1
@@ -43,13 +47,16 @@ Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
 #include <pthread.h>
 #include <unistd.h>
 
+typedef pthread_t __gthread_t;
 typedef pthread_key_t __gthread_key_t;
 typedef pthread_once_t __gthread_once_t;
 typedef pthread_mutex_t __gthread_mutex_t;
 typedef pthread_mutex_t __gthread_recursive_mutex_t;
+typedef pthread_cond_t __gthread_cond_t;
 
 #define __GTHREAD_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
 #define __GTHREAD_ONCE_INIT PTHREAD_ONCE_INIT
+#define __GTHREAD_COND_INIT PTHREAD_COND_INITIALIZER
 #if defined(PTHREAD_RECURSIVE_MUTEX_INITIALIZER)
 #define __GTHREAD_RECURSIVE_MUTEX_INIT PTHREAD_RECURSIVE_MUTEX_INITIALIZER
 #elif defined(PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP)
@@ -105,6 +112,9 @@ __gthrw(pthread_key_delete)
 __gthrw(pthread_mutexattr_init)
 __gthrw(pthread_mutexattr_settype)
 __gthrw(pthread_mutexattr_destroy)
+__gthrw(pthread_join)
+__gthrw(pthread_detach)
+__gthrw(pthread_equal)
 
 
 #if defined(_LIBOBJC) || defined(_LIBOBJC_WEAK)
@@ -142,6 +152,14 @@ __gthrw(pthread_attr_setdetachstate)
 __gthrw(pthread_getschedparam)
 __gthrw(pthread_setschedparam)
 #endif /* _POSIX_THREAD_PRIORITY_SCHEDULING */
+#else
+/* C++.  */
+__gthrw(pthread_cond_broadcast)
+__gthrw(pthread_cond_signal)
+__gthrw(pthread_cond_wait)
+__gthrw(pthread_cond_destroy)
+__gthrw(pthread_self)
+__gthrw(sched_yield)
 #endif /* _LIBOBJC || _LIBOBJC_WEAK */
 
 #if __GXX_WEAK__ && _GLIBCXX_GTHREAD_USE_WEAK
@@ -568,6 +586,42 @@ __gthread_objc_condition_signal (objc_condition_t condition)
 
 #else /* _LIBOBJC */
 
+static inline int
+__gthread_create (__gthread_t *thread, void *(*func) (void*), void *args)
+{
+  return __gthrw_(pthread_create) (thread, NULL, func, args);
+}
+
+static inline int
+__gthread_join (__gthread_t thread, void **value_ptr)
+{
+  return __gthrw_(pthread_join) (thread, value_ptr);
+}
+
+static inline int
+__gthread_detach (__gthread_t thread)
+{
+  return __gthrw_(pthread_detach) (thread);
+}
+
+static inline int
+__gthread_equal (__gthread_t t1, __gthread_t t2)
+{
+  return __gthrw_(pthread_equal) (t1, t2);
+}
+
+static inline __gthread_t
+__gthread_self (void)
+{
+  return __gthrw_(pthread_self) ();
+}
+
+static inline int
+__gthread_yield (void)
+{
+  return __gthrw_(sched_yield) ();
+}
+
 static inline int
 __gthread_once (__gthread_once_t *once, void (*func) (void))
 {
@@ -668,6 +722,37 @@ __gthread_recursive_mutex_unlock (__gthread_recursive_mutex_t *mutex)
   return __gthread_mutex_unlock (mutex);
 }
 
+static inline int
+__gthread_cond_broadcast (__gthread_cond_t *cond)
+{
+  return __gthrw_(pthread_cond_broadcast) (cond);
+}
+
+static inline int
+__gthread_cond_signal (__gthread_cond_t *cond)
+{
+  return __gthrw_(pthread_cond_signal) (cond);
+}
+
+static inline int
+__gthread_cond_wait (__gthread_cond_t *cond, __gthread_mutex_t *mutex)
+{
+  return __gthrw_(pthread_cond_wait) (cond, mutex);
+}
+
+static inline int
+__gthread_cond_wait_recursive (__gthread_cond_t *cond,
+			       __gthread_recursive_mutex_t *mutex)
+{
+  return __gthread_cond_wait (cond, mutex);
+}
+
+static inline int
+__gthread_cond_destroy (__gthread_cond_t *cond)
+{
+  return __gthrw_(pthread_cond_destroy) (cond);
+}
+
 #endif /* _LIBOBJC */
 
 #endif /* ! _GLIBCXX_GCC_GTHR_POSIX_H */
@@ -84,6 +84,36 @@ Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
    All functions returning int should return zero on success or the error
    number.  If the operation is not supported, -1 is returned.
 
+   If the following are also defined, you should
+     #define __GTHREADS_CXX0X 1
+   to enable the thread creation and condition variable support used by
+   the C++ library (parallel mode, ext/concurrence.h):
+
+   Types:
+     __gthread_t
+     __gthread_cond_t
+
+   Macros:
+     __GTHREAD_COND_INIT
+		to initialize __gthread_cond_t statically.
+
+   Interface:
+     int __gthread_create (__gthread_t *thread, void *(*func) (void*),
+			   void *args);
+     int __gthread_join (__gthread_t thread, void **value_ptr);
+     int __gthread_detach (__gthread_t thread);
+     int __gthread_equal (__gthread_t t1, __gthread_t t2);
+     __gthread_t __gthread_self (void);
+     int __gthread_yield (void);
+
+     int __gthread_cond_broadcast (__gthread_cond_t *cond);
+     int __gthread_cond_signal (__gthread_cond_t *cond);
+     int __gthread_cond_wait (__gthread_cond_t *cond,
+			      __gthread_mutex_t *mutex);
+     int __gthread_cond_wait_recursive (__gthread_cond_t *cond,
+				       __gthread_recursive_mutex_t *mutex);
+     int __gthread_cond_destroy (__gthread_cond_t *cond);
+
    Currently supported threads packages are
      TPF threads with -D__tpf__
      POSIX/Unix98 threads with -D_PTHREADS
@@ -2312,6 +2312,230 @@ struct WXDLLIMPEXP_BASE wxEventTable
     const wxEventTableEntry *entries; // bottom of entry array
 };
 
+// ----------------------------------------------------------------------------
+// wxEventIndex: event table entries grouped by event type and sorted by id
+// ----------------------------------------------------------------------------
+
+// the index refers to wxEventTableEntryBase which only exists when the old
+// event type compatibility is off
+#if !WXWIN_COMPATIBILITY_EVENT_TYPES
+    #define wxHAS_EVENT_INDEX
+#endif
+
+#ifdef wxHAS_EVENT_INDEX
+
+WX_DEFINE_ARRAY_PTR(const wxEventTableEntryBase*, wxEventTableEntryBasePointerArray);
+
+// an entry of wxEventIndex: m_order is the position of the entry in the
+// search order of the table it was added from
+struct wxEventIndexItem
+{
+    int m_id;
+    long m_order;
+    const wxEventTableEntryBase *m_entry;
+};
+
+WX_DEFINE_ARRAY_PTR(wxEventIndexItem*, wxEventIndexItemArray);
+
+// all entries for one event type: those for a single id sorted by id and
+// then by order, all the others (ranges and wxID_ANY) sorted by order
+struct wxEventIndexTypeTable
+{
+    wxEventType m_eventType;
+    wxEventIndexItemArray m_single;
+    wxEventIndexItemArray m_other;
+};
+
+WX_DEFINE_ARRAY_PTR(wxEventIndexTypeTable*, wxEventIndexTypeTableArray);
+
+// wxEventIndex lets the linear scans of static event tables and of the list
+// of entries added with Connect() be replaced by binary searches: it finds
+// the table for the event type and then the entries for the event id in it.
+// wxEvtHandler and wxEventHashTable don't use it themselves, it is filled by
+// the code which owns it.
+// Entries for id ranges or wxID_ANY are usually few and are merged in so
+// that the candidates are still returned in their original search order.
+class wxEventIndex
+{
+public:
+    wxEventIndex() : m_firstOrder(0), m_lastOrder(0) { }
+    ~wxEventIndex() { Clear(); }
+
+    // add an entry to be searched after all the entries already added, as
+    // for static event tables
+    void Append(wxEventType eventType, const wxEventTableEntryBase *entry)
+        { DoAdd(eventType, entry, ++m_lastOrder); }
+
+    // add an entry to be searched before all the entries already added, as
+    // Connect() does
+    void Prepend(wxEventType eventType, const wxEventTableEntryBase *entry)
+        { DoAdd(eventType, entry, --m_firstOrder); }
+
+    // remove an entry, return false if it was not in the index
+    bool Remove(wxEventType eventType, const wxEventTableEntryBase *entry)
+    {
+        size_t n;
+        if ( !FindTypeTable(eventType, n) )
+            return false;
+
+        wxEventIndexTypeTable *table = m_tables[n];
+        wxEventIndexItemArray& items = IsSingle(*entry) ? table->m_single
+                                                         : table->m_other;
+        for ( size_t i = IsSingle(*entry) ? FindId(items, entry->m_id)
+                                          : 0;
+              i < items.GetCount(); i++ )
+        {
+            if ( items[i]->m_entry == entry )
+            {
+                delete items[i];
+                items.RemoveAt(i);
+                if ( table->m_single.IsEmpty() && table->m_other.IsEmpty() )
+                {
+                    delete table;
+                    m_tables.RemoveAt(n);
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Clear()
+    {
+        for ( size_t n = 0; n < m_tables.GetCount(); n++ )
+        {
+            wxEventIndexTypeTable *table = m_tables[n];
+            size_t i;
+            for ( i = 0; i < table->m_single.GetCount(); i++ )
+                delete table->m_single[i];
+            for ( i = 0; i < table->m_other.GetCount(); i++ )
+                delete table->m_other[i];
+            delete table;
+        }
+        m_tables.Clear();
+        m_firstOrder =
+        m_lastOrder = 0;
+    }
+
+    bool IsEmpty() const { return m_tables.IsEmpty(); }
+
+    // append the entries which may match an event of the given type and id
+    // to candidates, in the order in which they must be tried; callers
+    // still check each of them with wxEvtHandler::ProcessEventIfMatches()
+    void GetCandidates(wxEventType eventType, int id,
+                       wxEventTableEntryBasePointerArray& candidates) const
+    {
+        size_t n;
+        if ( !FindTypeTable(eventType, n) )
+            return;
+
+        const wxEventIndexItemArray& single = m_tables[n]->m_single;
+        const wxEventIndexItemArray& other = m_tables[n]->m_other;
+        size_t i = id == wxID_ANY ? single.GetCount()
+                                  : FindId(single, id),
+               j = 0;
+        for ( ;; )
+        {
+            const bool hasSingle = i < single.GetCount() &&
+                                    single[i]->m_id == id;
+            if ( !hasSingle && j == other.GetCount() )
+                break;
+
+            if ( hasSingle && (j == other.GetCount() ||
+                               single[i]->m_order < other[j]->m_order) )
+                candidates.Add(single[i++]->m_entry);
+            else
+                candidates.Add(other[j++]->m_entry);
+        }
+    }
+
+private:
+    static bool IsSingle(const wxEventTableEntryBase& entry)
+    {
+        return entry.m_id != wxID_ANY && entry.m_lastId == wxID_ANY;
+    }
+
+    // index of the first item with the given id, or of the first item
+    // after them if after is true
+    static size_t FindId(const wxEventIndexItemArray& items,
+                         int id, bool after = false)
+    {
+        size_t lo = 0,
+               hi = items.GetCount();
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if ( items[mid]->m_id < id || (after && items[mid]->m_id == id) )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // find the table for this event type or the index to insert it at
+    bool FindTypeTable(wxEventType eventType, size_t& n) const
+    {
+        size_t lo = 0,
+               hi = m_tables.GetCount();
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if ( m_tables[mid]->m_eventType < eventType )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        n = lo;
+        return n < m_tables.GetCount() && m_tables[n]->m_eventType == eventType;
+    }
+
+    void DoAdd(wxEventType eventType, const wxEventTableEntryBase *entry,
+               long order)
+    {
+        size_t n;
+        if ( !FindTypeTable(eventType, n) )
+        {
+            wxEventIndexTypeTable *table = new wxEventIndexTypeTable;
+            table->m_eventType = eventType;
+            m_tables.Insert(table, n);
+        }
+
+        wxEventIndexItem *item = new wxEventIndexItem;
+        item->m_id = entry->m_id;
+        item->m_order = order;
+        item->m_entry = entry;
+
+        if ( IsSingle(*entry) )
+        {
+            wxEventIndexItemArray& single = m_tables[n]->m_single;
+            // appended entries go after and prepended ones before all
+            // the entries already added for the same id
+            single.Insert(item, FindId(single, item->m_id, order > 0));
+        }
+        else
+        {
+            wxEventIndexItemArray& other = m_tables[n]->m_other;
+            if ( order < 0 )
+                other.Insert(item, 0);
+            else
+                other.Add(item);
+        }
+    }
+
+    // tables sorted by event type
+    wxEventIndexTypeTableArray m_tables;
+
+    // orders given to the last prepended and appended entries
+    long m_firstOrder,
+         m_lastOrder;
+
+    DECLARE_NO_COPY_CLASS(wxEventIndex)
+};
+
+#endif // wxHAS_EVENT_INDEX
+
 // ----------------------------------------------------------------------------
 // wxEventHashTable: a helper of wxEvtHandler to speed up wxEventTable lookups.
 // ----------------------------------------------------------------------------